@@ -1,5 +1,6 @@
 #include "ambres/GNSSambres.hpp"
 #include <math.h>
+#include <sstream>
 
 #define LOG_PI 1.14472988584940017
 #define SQRT2 1.41421356237309510
@@ -7,6 +8,10 @@
 
 bool   AR_VERBO      = false;
 double FIXED_AMB_VAR = 1e-8;
+
+/** Minimum correlation coefficient linking two ambiguities into the same partition */
+const double AR_PARTITION_MIN_CORR = 1e-6;
+
 /** Probability of error (assuming normal distribution) */
 double round_perr(
     double dx,  ///< Distance between value and mean
@@ -403,7 +408,48 @@ int lambda_search(
     GinAR_opt  opt     ///< Object containing processing options
 )
 {
-    int info = Ztrans_reduction(trace, mtrx);
+    int namb = mtrx.aflt.size();
+
+    vector<KFKey> keys;
+    keys.reserve(namb);
+    for (int i = 0; i < namb; i++)
+        keys.push_back(mtrx.ambmap[i]);
+
+    // start from the previous transformation if the set is unchanged, it is then close to reduced
+    MatrixXd Zprev;
+    if (opt.warmStart_ptr && opt.warmStart_ptr->keys == keys &&
+        opt.warmStart_ptr->Z.rows() == namb)
+    {
+        Zprev = opt.warmStart_ptr->Z;
+    }
+
+    int info;
+    if (Zprev.rows() > 0)
+    {
+        GinAR_mtx mtrx2;
+        mtrx2.aflt  = Zprev * mtrx.aflt;
+        mtrx2.Paflt = Zprev * mtrx.Paflt * Zprev.transpose();
+
+        info = Ztrans_reduction(trace, mtrx2);
+
+        mtrx.Ztrs = mtrx2.Ztrs * Zprev;
+        mtrx.zflt = mtrx2.zflt;
+        mtrx.Ltrs = mtrx2.Ltrs;
+        mtrx.Dtrs = mtrx2.Dtrs;
+    }
+    else
+    {
+        info = Ztrans_reduction(trace, mtrx);
+    }
+
+    if (opt.warmStart_ptr)
+    {
+        opt.warmStart_ptr->keys = keys;
+        opt.warmStart_ptr->Z    = mtrx.Ztrs;
+
+        if (info < 0)
+            opt.warmStart_ptr->Z.resize(0, 0);
+    }
 
     if (info < 0)
     {
@@ -455,6 +501,48 @@ int lambda_search(
     double maxdist = 1e99;
     int    ncand   = 0;
 
+    // seed the search radius with the distance of the previous fix, so branches that cannot beat it
+    // (allowing for the ratio test) are never explored.
+    // The BIE estimator weights all candidates, including those beyond the seed, so it is unseeded
+    double seedRadius = 0;
+    if (opt.warmStart_ptr && opt.warmStart_ptr->fixedAmbs.empty() == false &&
+        opt.mode != E_ARmode::LAMBDA_BIE)
+    {
+        auto& fixedAmbs = opt.warmStart_ptr->fixedAmbs;
+
+        VectorXd aseed(nmax);
+        for (int i = 0; i < nmax; i++)
+        {
+            auto it = fixedAmbs.find(keys[i]);
+            if (it == fixedAmbs.end())
+            {
+                aseed(i) = ROUND(mtrx.aflt(i));
+            }
+            else
+            {
+                auto& [key, fixedAmb] = *it;
+                aseed(i)              = fixedAmb;
+            }
+        }
+
+        VectorXd zseed = mtrx.Ztrs * aseed;
+        VectorXd zsdif = VectorXd::Zero(nmax);
+
+        double seedDist = 0;
+        for (int j = kmax; j >= kmin; j--)
+        {
+            double zsadj = zflt(j);
+            for (int i = j + 1; i < nmax; i++)
+                zsadj -= zsdif(i) * L(i, j);
+
+            zsdif(j) = zsadj - zseed(j);
+            seedDist += zsdif(j) * zsdif(j) / D(j);
+        }
+
+        seedRadius = seedDist * std::max(opt.ratthr, 1.0) * (1 + 1e-9) + 1e-9;
+        maxdist    = seedRadius;
+    }
+
     while (search)
     {
         double newdist = dist(k) + zdif(k) * zdif(k) / D(k);
@@ -533,7 +621,22 @@ int lambda_search(
     VectorXd zfix0   = zfixList.begin()->second;
     mtrx.zfix        = zfix0;
     MatrixXd Z       = mtrx.Ztrs.bottomRows(zsiz);
-    mtrx.Ztrs        = Z;
+
+    // keep the integer ambiguities of complete fixes to seed the next epoch's search
+    if (opt.warmStart_ptr)
+    {
+        auto& fixedAmbs = opt.warmStart_ptr->fixedAmbs;
+        fixedAmbs.clear();
+
+        if (zsiz == nmax)
+        {
+            VectorXd afix = mtrx.Ztrs.fullPivLu().solve(zfix0);
+            for (int i = 0; i < nmax; i++)
+                fixedAmbs[keys[i]] = ROUND(afix(i));
+        }
+    }
+
+    mtrx.Ztrs = Z;
 
     switch (opt.mode)
     {
@@ -554,6 +657,10 @@ int lambda_search(
                     break;
             }
 
+            // with a seeded radius, any second candidate lies outside it
+            if (second == 0)
+                second = seedRadius;
+
             if ((second / first) < opt.ratthr)
                 return 0;
             else
@@ -624,8 +731,8 @@ int lambda_search(
     return 0;
 }
 
-/** Ambiguity resolution function for Ginan */
-int GNSS_AR(
+/** Resolve a set of ambiguities with the configured method */
+int resolveAmbiguities(
     Trace&     trace,  ///< Debug trace
     GinAR_mtx& mtrx,   ///< Reference to structure containing float values and covariance
     GinAR_opt  opt     ///< Object containing processing options
@@ -654,3 +761,230 @@ int GNSS_AR(
 
     return 0;
 }
+
+/** Find the root of an ambiguity's group, flattening the path as it goes */
+int findGroup(
+    vector<int>& parent,  ///< Parent of each ambiguity in the group forest
+    int          i        ///< Ambiguity to find the group of
+)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i         = parent[i];
+    }
+
+    return i;
+}
+
+/** Split the ambiguities into groups (lists of indices into aflt) to be resolved separately.
+ * Receiver partitions neglect any correlation between receivers (eg through common satellite
+ * biases), correlation partitions are exact, but only split if the covariance is block diagonal.
+ */
+vector<vector<int>> partitionAmbiguities(
+    GinAR_mtx&    mtrx,      ///< Reference to structure containing float values and covariance
+    E_ARPartition partition  ///< Method of grouping the ambiguities
+)
+{
+    int namb = mtrx.aflt.size();
+
+    vector<int> parent(namb);
+    for (int i = 0; i < namb; i++)
+        parent[i] = i;
+
+    switch (partition)
+    {
+        case E_ARPartition::NONE:
+            for (int i = 0; i < namb; i++)
+                parent[i] = 0;
+            break;
+        case E_ARPartition::RECEIVER:
+        {
+            map<string, int> recGroupMap;
+            for (int i = 0; i < namb; i++)
+            {
+                auto [it, inserted] = recGroupMap.insert({mtrx.ambmap[i].str, i});
+                auto& [rec, group]  = *it;
+
+                parent[i] = group;
+            }
+            break;
+        }
+        case E_ARPartition::CORRELATION:
+            for (int j = 0; j < namb; j++)
+                for (int i = j + 1; i < namb; i++)
+                {
+                    double cov = mtrx.Paflt(i, j);
+                    if (cov * cov <= AR_PARTITION_MIN_CORR * AR_PARTITION_MIN_CORR *
+                                         mtrx.Paflt(i, i) * mtrx.Paflt(j, j))
+                    {
+                        continue;
+                    }
+
+                    int ri = findGroup(parent, i);
+                    int rj = findGroup(parent, j);
+                    if (ri != rj)
+                        parent[std::max(ri, rj)] = std::min(ri, rj);
+                }
+            break;
+    }
+
+    map<int, int>       groupIndexMap;
+    vector<vector<int>> groups;
+    for (int i = 0; i < namb; i++)
+    {
+        int root = findGroup(parent, i);
+
+        auto [it, inserted] = groupIndexMap.insert({root, groups.size()});
+        if (inserted)
+            groups.emplace_back();
+
+        auto& [dummy, groupIndex] = *it;
+        groups[groupIndex].push_back(i);
+    }
+
+    return groups;
+}
+
+/** Get the warm start for a set of ambiguities, identified by its first ambiguity.
+ * Not thread safe, call from serial code only.
+ */
+LambdaWarmStart* getWarmStart(
+    GinAR_opt&   opt,      ///< Object containing processing options
+    const KFKey& firstKey  ///< First ambiguity of the set
+)
+{
+    if (opt.warmStartMap_ptr == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto& warmStart = (*opt.warmStartMap_ptr)[firstKey];
+    warmStart.used  = true;
+
+    return &warmStart;
+}
+
+/** Resolve groups of ambiguities separately and in parallel, then merge the fixes.
+ * Success rate and ratio tests are applied per group, the merged Z transformation is block
+ * diagonal with respect to the groups.
+ */
+int partitionedAR(
+    Trace&     trace,  ///< Debug trace
+    GinAR_mtx& mtrx,   ///< Reference to structure containing float values and covariance
+    GinAR_opt  opt     ///< Object containing processing options
+)
+{
+    auto groups = partitionAmbiguities(mtrx, opt.partition);
+
+    int numGroups = groups.size();
+    int namb      = mtrx.aflt.size();
+
+    tracepdeex(4, trace, "\n#ARES_PRT Resolving %d ambiguities in %d groups", namb, numGroups);
+
+    vector<GinAR_mtx>          groupMtrxs(numGroups);
+    vector<int>                groupFixes(numGroups, 0);
+    vector<std::ostringstream> groupTraces(numGroups);
+
+    vector<GinAR_opt> groupOpts(numGroups, opt);
+    for (int g = 0; g < numGroups; g++)
+    {
+        groupOpts[g].warmStart_ptr = getWarmStart(opt, mtrx.ambmap[groups[g].front()]);
+    }
+
+#ifdef ENABLE_PARALLELISATION
+    Eigen::setNbThreads(1);
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int g = 0; g < numGroups; g++)
+    {
+        auto& group     = groups[g];
+        auto& groupMtrx = groupMtrxs[g];
+
+        for (int i = 0; i < group.size(); i++)
+            groupMtrx.ambmap[i] = mtrx.ambmap[group[i]];
+
+        groupMtrx.aflt  = mtrx.aflt(group);
+        groupMtrx.Paflt = mtrx.Paflt(group, group);
+
+        groupFixes[g] = resolveAmbiguities(groupTraces[g], groupMtrx, groupOpts[g]);
+    }
+    Eigen::setNbThreads(0);
+
+    int nfix = 0;
+    for (int g = 0; g < numGroups; g++)
+    {
+        trace << groupTraces[g].str();
+
+        nfix += groupFixes[g];
+    }
+
+    mtrx.Ztrs = MatrixXd::Zero(nfix, namb);
+    mtrx.zfix = VectorXd::Zero(nfix);
+
+    int row = 0;
+    for (int g = 0; g < numGroups; g++)
+    {
+        int groupFix = groupFixes[g];
+        if (groupFix <= 0)
+            continue;
+
+        auto& group     = groups[g];
+        auto& groupMtrx = groupMtrxs[g];
+
+        mtrx.zfix.segment(row, groupFix) = groupMtrx.zfix;
+
+        for (int i = 0; i < group.size(); i++)
+            mtrx.Ztrs.block(row, group[i], groupFix, 1) = groupMtrx.Ztrs.col(i);
+
+        row += groupFix;
+    }
+
+    return nfix;
+}
+
+/** Ambiguity resolution function for Ginan */
+int GNSS_AR(
+    Trace&     trace,  ///< Debug trace
+    GinAR_mtx& mtrx,   ///< Reference to structure containing float values and covariance
+    GinAR_opt  opt     ///< Object containing processing options
+)
+{
+    if (opt.mode == E_ARmode::OFF || mtrx.ambmap.empty())
+        return 0;
+
+    if (opt.warmStartMap_ptr)
+    {
+        for (auto& [key, warmStart] : *opt.warmStartMap_ptr)
+            warmStart.used = false;
+    }
+
+    int nfix;
+    if (opt.partition != E_ARPartition::NONE)
+    {
+        nfix = partitionedAR(trace, mtrx, opt);
+    }
+    else
+    {
+        opt.warmStart_ptr = getWarmStart(opt, mtrx.ambmap.begin()->second);
+
+        nfix = resolveAmbiguities(trace, mtrx, opt);
+    }
+
+    // forget sets that no longer exist
+    if (opt.warmStartMap_ptr)
+    {
+        auto& warmStartMap = *opt.warmStartMap_ptr;
+        for (auto it = warmStartMap.begin(); it != warmStartMap.end();)
+        {
+            auto& [key, warmStart] = *it;
+
+            if (warmStart.used == false)
+                it = warmStartMap.erase(it);
+            else
+                it++;
+        }
+    }
+
+    return nfix;
+}
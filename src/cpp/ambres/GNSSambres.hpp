@@ -29,13 +29,26 @@ struct GinAR_mtx
     MatrixXd Pafix;
 };
 
+/** Results of the previous epoch's LAMBDA search over one set of ambiguities, used to warm start
+ * the decorrelation and the integer search of the next epoch
+ */
+struct LambdaWarmStart
+{
+    vector<KFKey>      keys;       ///< Ambiguities in the set, in order
+    MatrixXd           Z;          ///< Full decorrelating transformation found for the set
+    map<KFKey, double> fixedAmbs;  ///< Integer ambiguities of the last complete fix
+
+    bool used = false;             ///< Set when used in the current epoch, for culling
+};
+
 struct GinAR_opt
 {
     string           recv;
     map<E_Sys, bool> sys_solve;
 
-    bool     endu = false;
-    E_ARmode mode = E_ARmode::OFF;  /* AR mode */
+    bool          endu      = false;
+    E_ARmode      mode      = E_ARmode::OFF;        /* AR mode */
+    E_ARPartition partition = E_ARPartition::NONE;  /* groups of ambiguities resolved separately */
 
     int nset = 0;                   /* candidate set size for lambda */
     int nitr = 3;                   /* number of iterations for iter_rnd */
@@ -50,6 +63,11 @@ struct GinAR_opt
     bool   clear_old_amb = false;
     int    Max_Hold_epc  = 0;   /* max hold (epoch) */
     double Max_Hold_tim  = 600; /* max hold (seconds) */
+
+    map<KFKey, LambdaWarmStart>* warmStartMap_ptr = nullptr;  /* warm starts, by first ambiguity */
+    LambdaWarmStart*             warmStart_ptr    = nullptr;  /* warm start for this set */
 };
 
+vector<vector<int>> partitionAmbiguities(GinAR_mtx& mtrx, E_ARPartition partition);
+
 int GNSS_AR(Trace& trace, GinAR_mtx& mtrx, GinAR_opt opt);
@@ -2331,6 +2331,7 @@ ReceiverOptions& ReceiverOptions::operator+=(const ReceiverOptions& rhs)
     initIfNeeded(*this, rhs, tideModels.atl);
     initIfNeeded(*this, rhs, tideModels.spole);
     initIfNeeded(*this, rhs, tideModels.opole);
+    initIfNeeded(*this, rhs, tideModels.interpolation_interval);
 
     initIfNeeded(*this, rhs, range);
     initIfNeeded(*this, rhs, relativity);
@@ -3683,6 +3684,22 @@ void getOptionsFromYaml(
             tryGetFromYaml(thing, modelsNode, {"@ tides", "@ opole"}, "Enable ocean pole tides")
         );
     }
+    {
+        auto& thing = recOpts.tideModels.interpolation_interval;
+        setInited(
+            recOpts,
+            thing,
+            tryGetFromYaml(
+                thing,
+                modelsNode,
+                {"@ tides", "@ interpolation_interval"},
+                "Spacing of epochs at which tidal displacements are fully evaluated, intermediate "
+                "epochs are interpolated. Nodes are evaluated up to a few intervals ahead of the "
+                "current epoch, including pole tides from future ERP values, so this is intended "
+                "for post-processing only. Set to 0 to evaluate every epoch (s)"
+            )
+        );
+    }
     {
         auto& thing = recOpts.range;
         setInited(
@@ -4927,6 +4944,13 @@ bool ACSConfig::parse(
                 {"0! outputs_root"},
                 "Directory that outputs will be placed in"
             );
+            tryGetFromYaml(
+                queue_product_outputs,
+                outputs,
+                {"1@ queue_product_outputs"},
+                "Format and write clock, sp3 and orbex products on background threads so that "
+                "processing is not limited by IO bandwidth"
+            );
 
             {
                 auto metadata = stringsToYamlObject(
@@ -6270,6 +6294,22 @@ bool ACSConfig::parse(
                 {"@ allow_missing_inputs"},
                 "Allow adding inpuut files which do not (yet) exist"
             );
+            tryGetFromYaml(
+                file_check_interval,
+                inputs,
+                {"@ file_check_interval"},
+                "Minimum time (wall clock) between checks of input files for modifications, "
+                "0 checks every epoch"
+            );
+            tryGetFromYaml(
+                product_window,
+                inputs,
+                {"@ product_window"},
+                "Only load sp3 and clk files with data within this time of the processing epoch, "
+                "and discard their data once it is older than this. Must exceed the span required "
+                "for interpolation. When enabled no sp3 or clk data is loaded at startup, only once "
+                "the first epoch is known. 0 loads all files at startup"
+            );
 
             auto getAppendFiles = [&](vector<string>& output,
                                       NodeStack&      nodeStack,
@@ -6287,6 +6327,20 @@ bool ACSConfig::parse(
 
             getAppendFiles(atx_files, inputs, {"4! atx_files"}, "List of atx files to use");
             getAppendFiles(snx_files, inputs, {"4@ snx_files"}, "List of snx files to use");
+            tryGetFromYaml(
+                snx_stations,
+                inputs,
+                {"4@ snx_stations"},
+                "Only load site and solution data for these station ids from snx files, all "
+                "stations are loaded if empty"
+            );
+            tryGetFromYaml(
+                snx_blocks,
+                inputs,
+                {"4@ snx_blocks"},
+                "Only load these blocks (eg SITE/ID, SOLUTION/ESTIMATE) from snx files, all blocks "
+                "are loaded if empty"
+            );
             getAppendFiles(erp_files, inputs, {"4! erp_files"}, "List of erp files to use");
             getAppendFiles(igrf_files, inputs, {"4@ igrf_files"}, "List of igrf files to use");
             getAppendFiles(egm_files, inputs, {"4@ egm_files"}, "List of egm files to use");
@@ -6426,6 +6480,28 @@ bool ACSConfig::parse(
                     "<GNSS_OBS_ROOT>",
                     "List of rinex      inputs to use"
                 );
+                tryGetFromYaml(
+                    rnx_preload_epochs,
+                    gnss_data,
+                    {"@ rnx_preload_epochs"},
+                    "Number of epochs to parse ahead of processing in rinex observation files, all "
+                    "files being parsed in parallel. 0 parses each epoch as it is required"
+                );
+                tryGetFromYaml(
+                    rnx_preload_memory_mb,
+                    gnss_data,
+                    {"@ rnx_preload_memory_mb"},
+                    "Approximate limit on the memory used by preloaded rinex observations (MB)"
+                );
+                tryGetFromYaml(
+                    rnx_obs_cache_directory,
+                    gnss_data,
+                    {"@ rnx_obs_cache_directory"},
+                    "Directory to keep binary caches of decoded rinex 3+ observations in. Caches are "
+                    "written the first time a file is parsed and used instead of the file in later "
+                    "runs. A cache is only kept if the whole file is parsed, runs that stop early "
+                    "(eg. due to end_epoch or max_epochs) do not produce one. Empty disables caching"
+                );
                 tryGetMappedList(
                     ubx_inputs,
                     commandOpts,
@@ -7617,7 +7693,9 @@ bool ACSConfig::parse(
                     {"@ lsq_inverter"},
                     "Inverter to be used within the least squares estimater, which may provide "
                     "different performance "
-                    "outcomes in terms of processing time and accuracy and stability."
+                    "outcomes in terms of processing time and accuracy and stability. With LLT or "
+                    "LDLT, sparse design matrices from large networks use sparse factorisations, "
+                    "which scale much better than the dense INV inverter."
                 );
 
                 auto outlier_screening = stringsToYamlObject(
@@ -8346,6 +8424,13 @@ bool ACSConfig::parse(
                 );
 
                 tryGetEnumOpt(ambrOpts.mode, ambiguity_resolution, {"@ mode"});
+                tryGetEnumOpt(
+                    ambrOpts.partition,
+                    ambiguity_resolution,
+                    {"@ partition"},
+                    "Split ambiguities into groups that are resolved (and validated) independently "
+                    "and in parallel"
+                );
                 tryGetFromYaml(
                     ambrOpts.succsThres,
                     ambiguity_resolution,
@@ -8372,6 +8457,13 @@ bool ACSConfig::parse(
                     {"@ fix_and_hold"},
                     "Perform ambiguity resolution and commit results to the main processing filter"
                 );
+                tryGetFromYaml(
+                    ambrOpts.warm_start,
+                    ambiguity_resolution,
+                    {"@ warm_start"},
+                    "Start lambda modes from the previous epoch's decorrelation, and bound the "
+                    "integer search using the previous epoch's fixed ambiguities"
+                );
             }
 
             // 			predictions
@@ -8822,6 +8914,7 @@ bool ACSConfig::parse(
         globber(pseudo_sp3_inputs);
         replaceTags(pseudo_snx_inputs);
         globber(pseudo_snx_inputs);
+        replaceTags(rnx_obs_cache_directory);
 
         replaceTags(sp3_directory);
         replaceTags(sp3_filename);
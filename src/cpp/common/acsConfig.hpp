@@ -76,7 +76,9 @@ struct InputOptions
 {
     string inputs_root = ".";
 
-    bool allow_missing_inputs = false;
+    bool   allow_missing_inputs = false;
+    double file_check_interval  = 0;  ///< Minimum wall time between checks for modified files (s)
+    double product_window       = 0;  ///< Time around epoch to load sp3/clk data for, 0 for all (s)
 
     string gnss_obs_root          = "<INPUTS_ROOT>";
     string pseudo_obs_root        = "<INPUTS_ROOT>";
@@ -87,6 +89,8 @@ struct InputOptions
 
     vector<string> atx_files;
     vector<string> snx_files;
+    vector<string> snx_stations;  ///< only load site data for these stations from sinex (all if empty)
+    vector<string> snx_blocks;    ///< only load these blocks from sinex files (all if empty)
     vector<string> nav_files;
     vector<string> ems_files;
     vector<string> sp3_files;
@@ -130,6 +134,10 @@ struct InputOptions
     map<string, vector<string>> pseudo_sp3_inputs;
     map<string, vector<string>> pseudo_snx_inputs;
 
+    int    rnx_preload_epochs    = 0;     ///< Epochs to parse ahead in rinex files, in parallel
+    double rnx_preload_memory_mb = 1024;  ///< Cap on memory used by preloaded rinex observations
+    string rnx_obs_cache_directory;       ///< Directory for binary caches of rinex observations
+
     vector<E_TidalComponent> atl_blq_row_order = {
         E_TidalComponent::UP,
         E_TidalComponent::EAST,
@@ -181,7 +189,8 @@ struct IonexOptions
  */
 struct OutputOptions
 {
-    string outputs_root = ".";
+    string outputs_root          = ".";
+    bool   queue_product_outputs = false;
 
     int    fatal_level   = 0;
     double rotate_period = 60 * 60 * 24;
@@ -810,9 +819,10 @@ struct SbasOptions
 
 struct AmbROptions
 {
-    E_ARmode mode       = E_ARmode::OFF;
-    int      lambda_set = 2;
-    int      AR_max_itr = 1;
+    E_ARmode      mode       = E_ARmode::OFF;
+    E_ARPartition partition  = E_ARPartition::NONE;  ///< Grouping of ambiguities resolved in parallel
+    int           lambda_set = 2;
+    int           AR_max_itr = 1;
 
     double elevation_mask_deg = 15;
 
@@ -825,6 +835,7 @@ struct AmbROptions
 
     bool once_per_epoch = true;
     bool fix_and_hold   = false;
+    bool warm_start     = false;  ///< Reuse the previous epoch's decorrelation and fix in lambda
 };
 
 /** Rinex 2 conversions for individual receivers
@@ -1264,6 +1275,8 @@ struct ReceiverOptions : ReceiverKalmans, CommonOptions
         bool atl    = true;
         bool spole  = true;
         bool opole  = true;
+
+        double interpolation_interval = 0;  ///< Spacing of fully evaluated epochs, 0 to evaluate each epoch (s)
     } tideModels;
 
     bool range                  = true;
@@ -117,8 +117,8 @@ void detslp_ll(
                 enum_to_string(ft)
             );
 
-            obs.satStat_ptr->sigStatMap[ft2string(ft)].slip.LLI      = true;
-            obs.satStat_ptr->sigStatMap[ft2string(ft)].savedSlip.LLI = true;
+            obs.satStat_ptr->sigStats[ft].slip.LLI      = true;
+            obs.satStat_ptr->sigStats[ft].savedSlip.LLI = true;
         }
 }
 
@@ -202,10 +202,10 @@ void detslp_gf(
                 gf1
             );
 
-            obs.satStat_ptr->sigStatMap[ft2string(frq1)].slip.GF      = true;
-            obs.satStat_ptr->sigStatMap[ft2string(frq2)].slip.GF      = true;
-            obs.satStat_ptr->sigStatMap[ft2string(frq1)].savedSlip.GF = true;
-            obs.satStat_ptr->sigStatMap[ft2string(frq2)].savedSlip.GF = true;
+            obs.satStat_ptr->sigStats[frq1].slip.GF      = true;
+            obs.satStat_ptr->sigStats[frq2].slip.GF      = true;
+            obs.satStat_ptr->sigStats[frq1].savedSlip.GF = true;
+            obs.satStat_ptr->sigStats[frq2].savedSlip.GF = true;
         }
     }
 }
@@ -290,14 +290,211 @@ void detslp_mw(
                 mw1
             );
 
-            obs.satStat_ptr->sigStatMap[ft2string(frq1)].slip.MW      = true;
-            obs.satStat_ptr->sigStatMap[ft2string(frq2)].slip.MW      = true;
-            obs.satStat_ptr->sigStatMap[ft2string(frq1)].savedSlip.MW = true;
-            obs.satStat_ptr->sigStatMap[ft2string(frq2)].savedSlip.MW = true;
+            obs.satStat_ptr->sigStats[frq1].slip.MW      = true;
+            obs.satStat_ptr->sigStats[frq2].slip.MW      = true;
+            obs.satStat_ptr->sigStats[frq1].savedSlip.MW = true;
+            obs.satStat_ptr->sigStats[frq2].savedSlip.MW = true;
         }
     }
 }
 
+/** Detect slips by geometry free phase and Melbourne-Wubbena jumps for all satellites at once.
+ * Equivalent to detslp_gf() followed by detslp_mw(), but the values are gathered into the dense
+ * arrays of the slip detector and tested in a single vectorised pass.
+ */
+void detslp_gf_mw(
+    Trace&        trace,        ///< Trace to output to
+    ObsList&      obsList,      ///< List of observations to detect slips within
+    SlipDetector& slipDetector  ///< Receiver slip detection stage
+)
+{
+    if (obsList.empty())
+    {
+        tracepdeex(3, trace, "\n%s: epoch=? n=%zu (empty obsList)", __FUNCTION__, obsList.size());
+        return;
+    }
+
+    // Find first non-null element for the timestamp
+    std::string epoch = "?";
+    for (const auto& sp : obsList)
+    {
+        if (sp)
+        {
+            epoch = sp->time.to_string(2);
+            break;
+        }
+    }
+
+    tracepdeex(3, trace, "\n%s: epoch=%s n=%zu", __FUNCTION__, epoch.c_str(), obsList.size());
+
+    auto& det = slipDetector;
+
+    det.obsPtrs.clear();
+    det.frq1.clear();
+    det.frq2.clear();
+    det.gf0.clear();
+    det.gf1.clear();
+    det.mw0.clear();
+    det.mw1.clear();
+
+    map<E_Sys, std::pair<bool, array<E_FType, 3>>> sysFreqs;
+
+    // gather, updating the persistent values in the same order as the individual detectors
+    for (auto& obs : only<GObs>(obsList))
+    {
+        if (obs.exclude)
+        {
+            continue;
+        }
+
+        auto it = sysFreqs.find(obs.Sat.sys);
+        if (it == sysFreqs.end())
+        {
+            array<E_FType, 3> freqs;
+            bool              pass = satFreqs(obs.Sat.sys, freqs[0], freqs[1], freqs[2]);
+
+            it = sysFreqs.emplace(obs.Sat.sys, std::make_pair(pass, freqs)).first;
+        }
+
+        auto& [sys, sysEntry] = *it;
+        auto& [pass, freqs]   = sysEntry;
+        if (pass == false)
+            continue;
+
+        SatStat& satStat = *obs.satStat_ptr;
+
+        S_LC& lc = getLC(satStat.lc_new, freqs[0], freqs[1]);
+
+        double gf0 = 0;
+        double gf1 = 0;
+        if (lc.valid && lc.GF_Phas_m != 0)
+        {
+            gf0        = satStat.gf;
+            gf1        = lc.GF_Phas_m;
+            satStat.gf = gf1;
+        }
+
+        double mw0 = 0;
+        double mw1 = 0;
+        if (lc.valid && lc.MW_c != 0)
+        {
+            mw0        = satStat.mw;
+            mw1        = lc.MW_c;
+            satStat.mw = mw1;
+        }
+
+        det.obsPtrs.push_back(&obs);
+        det.frq1.push_back(freqs[0]);
+        det.frq2.push_back(freqs[1]);
+        det.gf0.push_back(gf0);
+        det.gf1.push_back(gf1);
+        det.mw0.push_back(mw0);
+        det.mw1.push_back(mw1);
+    }
+
+    int n = det.obsPtrs.size();
+
+    det.gfSlip.resize(n);
+    det.mwSlip.resize(n);
+
+    double gfThreshold = acsConfig.preprocOpts.slip_threshold;
+
+    const double* gf0    = det.gf0.data();
+    const double* gf1    = det.gf1.data();
+    const double* mw0    = det.mw0.data();
+    const double* mw1    = det.mw1.data();
+    char*         gfSlip = det.gfSlip.data();
+    char*         mwSlip = det.mwSlip.data();
+
+#pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        gfSlip[i] = gf0[i] != 0 && fabs(gf1[i] - gf0[i]) > gfThreshold;
+        mwSlip[i] = mw0[i] != 0 && fabs(mw1[i] - mw0[i]) > THRES_MW_JUMP;
+    }
+
+    // scatter the results, and trace in the order of the individual detectors
+    for (int i = 0; i < n; i++)
+    {
+        GObs& obs = *det.obsPtrs[i];
+
+        if (gf0[i] == 0)
+            continue;
+
+        tracepdeex(
+            3,
+            trace,
+            "\n%s: epoch=%s sat=%s gf0=%f gf1=%f",
+            __FUNCTION__,
+            obs.time.to_string(2).c_str(),
+            obs.Sat.id().c_str(),
+            gf0[i],
+            gf1[i]
+        );
+
+        if (gfSlip[i] == false)
+            continue;
+
+        tracepdeex(
+            3,
+            trace,
+            "\n%s: slip detected: epoch=%s sat=%s gf0=%f gf1=%f",
+            __FUNCTION__,
+            obs.time.to_string(2).c_str(),
+            obs.Sat.id().c_str(),
+            gf0[i],
+            gf1[i]
+        );
+
+        auto& sigStat1 = obs.satStat_ptr->sigStats[det.frq1[i]];
+        auto& sigStat2 = obs.satStat_ptr->sigStats[det.frq2[i]];
+        sigStat1.slip.GF      = true;
+        sigStat2.slip.GF      = true;
+        sigStat1.savedSlip.GF = true;
+        sigStat2.savedSlip.GF = true;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        GObs& obs = *det.obsPtrs[i];
+
+        if (mw0[i] == 0)
+            continue;
+
+        tracepdeex(
+            3,
+            trace,
+            "\n%s: epoch=%s sat=%s mw0=%f mw1=%f",
+            __FUNCTION__,
+            obs.time.to_string(2).c_str(),
+            obs.Sat.id().c_str(),
+            mw0[i],
+            mw1[i]
+        );
+
+        if (mwSlip[i] == false)
+            continue;
+
+        tracepdeex(
+            3,
+            trace,
+            "\n%s: slip detected: epoch=%s sat=%s mw0=%f mw1=%f",
+            __FUNCTION__,
+            obs.time.to_string(2).c_str(),
+            obs.Sat.id().c_str(),
+            mw0[i],
+            mw1[i]
+        );
+
+        auto& sigStat1 = obs.satStat_ptr->sigStats[det.frq1[i]];
+        auto& sigStat2 = obs.satStat_ptr->sigStats[det.frq2[i]];
+        sigStat1.slip.MW      = true;
+        sigStat2.slip.MW      = true;
+        sigStat1.savedSlip.MW = true;
+        sigStat2.savedSlip.MW = true;
+    }
+}
+
 /** Melbourne-Wenbunna (MW) measurement noise (m)
  */
 double mwnoise(
@@ -407,14 +604,14 @@ void scdia(
         return;
     }
 
-    satStat.sigStatMap[ft2string(frq1)].slip.SCDIA = true;
-    satStat.sigStatMap[ft2string(frq2)].slip.SCDIA = true;
+    satStat.sigStats[frq1].slip.SCDIA = true;
+    satStat.sigStats[frq2].slip.SCDIA = true;
     if (nf == 3)
-        satStat.sigStatMap[ft2string(frq3)].slip.SCDIA = true;
-    satStat.sigStatMap[ft2string(frq1)].savedSlip.SCDIA = true;
-    satStat.sigStatMap[ft2string(frq2)].savedSlip.SCDIA = true;
+        satStat.sigStats[frq3].slip.SCDIA = true;
+    satStat.sigStats[frq1].savedSlip.SCDIA = true;
+    satStat.sigStats[frq2].savedSlip.SCDIA = true;
     if (nf == 3)
-        satStat.sigStatMap[ft2string(frq3)].savedSlip.SCDIA = true;
+        satStat.sigStats[frq3].savedSlip.SCDIA = true;
 
     VectorXd xp = VectorXd::Zero(n);
     MatrixXd Pp = MatrixXd::Zero(n, n);
@@ -508,7 +705,7 @@ void scdia(
             for (int i = 0; i < 3; i++)
                 satStat.amb[i] = ROUND(F.data()[i]);
 
-            for (auto& [key, sigStat] : satStat.sigStatMap)
+            for (auto& sigStat : satStat.sigStats)
             {
                 sigStat.slip.SCDIA = true;
             }
@@ -648,8 +845,8 @@ void cycleslip2(
     }
 
     /* update TD ionosphere residual */
-    if (satStat.sigStatMap[ft2string(frq1)].slip.any == 0 &&
-        satStat.sigStatMap[ft2string(frq2)].slip.any == 0)
+    if (satStat.sigStats[frq1].slip.any == 0 &&
+        satStat.sigStats[frq2].slip.any == 0)
     {
         satStat.dIono     = deltaGF / coef;
         satStat.sigmaIono = sigmaGF / coef;
@@ -794,9 +991,9 @@ void cycleslip3(
     }
 
     /* update TD ionosphere residual */
-    if (satStat.sigStatMap[ft2string(frq1)].slip.any == 0 &&
-        satStat.sigStatMap[ft2string(frq2)].slip.any == 0 &&
-        satStat.sigStatMap[ft2string(frq3)].slip.any == 0)
+    if (satStat.sigStats[frq1].slip.any == 0 &&
+        satStat.sigStats[frq2].slip.any == 0 &&
+        satStat.sigStats[frq3].slip.any == 0)
     {
         satStat.dIono     = deltaGF / coef;
         satStat.sigmaIono = sigmaGF / coef;
@@ -883,8 +1080,8 @@ void detectslip(
         cycleslip2(trace, satStat, lc_new, obs);
 
         /* update averaged MW noise when no cycle slip */
-        if (satStat.sigStatMap[ft2string(frq1)].slip.any == 0 &&
-            satStat.sigStatMap[ft2string(frq2)].slip.any == 0)
+        if (satStat.sigStats[frq1].slip.any == 0 &&
+            satStat.sigStats[frq2].slip.any == 0)
         {
             S_LC& lc12 = getLC(lc_new, frq1, frq2);
             lowPassFilter(satStat.mwSlip, lc12.MW_c, acsConfig.preprocOpts.mw_proc_noise);
@@ -900,13 +1097,13 @@ void detectslip(
              lc_old.L_m[frq3] == 0)  // was zero, now not.
     {
         /* set slip flag for L5 (introduce new ambiguity for L5) */
-        satStat.sigStatMap[ft2string(frq3)].slip.retrack      = true;
-        satStat.sigStatMap[ft2string(frq3)].savedSlip.retrack = true;
+        satStat.sigStats[frq3].slip.retrack      = true;
+        satStat.sigStats[frq3].savedSlip.retrack = true;
         cycleslip2(trace, satStat, lc_new, obs);
 
         /* update averaged MW noise when no cycle slip */
-        if (satStat.sigStatMap[ft2string(frq1)].slip.any == 0 &&
-            satStat.sigStatMap[ft2string(frq2)].slip.any == 0)
+        if (satStat.sigStats[frq1].slip.any == 0 &&
+            satStat.sigStats[frq2].slip.any == 0)
         {
             S_LC& lc12 = getLC(lc_new, frq1, frq2);
             lowPassFilter(satStat.mwSlip, lc12.MW_c, acsConfig.preprocOpts.mw_proc_noise);
@@ -924,19 +1121,19 @@ void detectslip(
 
         if (satStat.el * R2D > 30)
         {
-            if (satStat.sigStatMap[ft2string(frq1)].slip.any == 2  // todo aaron, check the 2
+            if (satStat.sigStats[frq1].slip.any == 2  // todo aaron, check the 2
                 && satStat.amb[0] == 0 && satStat.amb[1] == 0 && satStat.amb[2] == 0)
             {
-                satStat.sigStatMap[ft2string(frq1)].slip.any = 0;
-                satStat.sigStatMap[ft2string(frq2)].slip.any = 0;
-                satStat.sigStatMap[ft2string(frq3)].slip.any = 0;
+                satStat.sigStats[frq1].slip.any = 0;
+                satStat.sigStats[frq2].slip.any = 0;
+                satStat.sigStats[frq3].slip.any = 0;
             }
         }
 
         /*update averaged MW25 noise when no cycle slip */
-        if (satStat.sigStatMap[ft2string(frq1)].slip.any == 0 &&
-            satStat.sigStatMap[ft2string(frq2)].slip.any == 0 &&
-            satStat.sigStatMap[ft2string(frq3)].slip.any == 0)
+        if (satStat.sigStats[frq1].slip.any == 0 &&
+            satStat.sigStats[frq2].slip.any == 0 &&
+            satStat.sigStats[frq3].slip.any == 0)
         {
             S_LC& lc25 = getLC(lc_new, frq2, frq3);
             lowPassFilter(satStat.emwSlip, lc25.MW_c, acsConfig.preprocOpts.mw_proc_noise);
@@ -951,7 +1148,7 @@ void detectslip(
     {
         satStat.flt.slip = 0;
         satStat.flt.ne   = 0;
-        for (auto& [key, sigStat] : satStat.sigStatMap)
+        for (auto& sigStat : satStat.sigStats)
         {
             sigStat.slip.retrack      = true;
             sigStat.savedSlip.retrack = true;
@@ -970,7 +1167,7 @@ void detectslip(
     {
         satStat.flt.slip = 0;
         satStat.flt.ne   = 0;
-        for (auto& [key, sigStat] : satStat.sigStatMap)
+        for (auto& sigStat : satStat.sigStats)
         {
             sigStat.slip.singleFreq      = true;
             sigStat.savedSlip.singleFreq = true;
@@ -1004,7 +1201,7 @@ void clearSlips(ObsList& obsList)
             continue;
         }
 
-        for (auto& [sigKey, sigStat] : obs.satStat_ptr->sigStatMap)
+        for (auto& sigStat : obs.satStat_ptr->sigStats)
         {
             SatStat& satStat = *(obs.satStat_ptr);
 
@@ -1017,15 +1214,15 @@ void clearSlips(ObsList& obsList)
 /** Detect slips for multiple observations
  */
 void detectslips(
-    Trace&   trace,   ///< Trace to output to
-    ObsList& obsList  ///< List of observations to detect slips within
+    Trace&        trace,        ///< Trace to output to
+    ObsList&      obsList,      ///< List of observations to detect slips within
+    SlipDetector& slipDetector  ///< Receiver slip detection stage
 )
 {
     tracepdeex(2, trace, "\n   *-------- PDE cycle slip detection & repair --------*\n");
 
     detslp_ll(trace, obsList);
-    detslp_gf(trace, obsList);
-    detslp_mw(trace, obsList);
+    detslp_gf_mw(trace, obsList, slipDetector);
 
     tracepdeex(
         2,
@@ -1049,7 +1246,7 @@ void detectslips(
 
         for (auto& [ft, sig] : obs.sigs)
         {
-            auto& sigStat = obs.satStat_ptr->sigStatMap[ft2string(ft)];
+            auto& sigStat = obs.satStat_ptr->sigStats[ft];
 
             if (sigStat.slip.any)
             {
@@ -1,8 +1,29 @@
 #pragma once
 
+#include <vector>
+#include "common/enums.h"
 #include "common/trace.hpp"
 
 struct ObsList;
+struct GObs;
+
+/** Receiver level cycle slip detection stage.
+ * The geometry free and Melbourne-Wubbena values of all satellites of an epoch are gathered into
+ * dense arrays so that their jump tests run in one vectorised pass. The arrays are reused between
+ * epochs, the persistent values remain in the satellite status objects.
+ */
+struct SlipDetector
+{
+    std::vector<GObs*>   obsPtrs;  ///< Observations tested this epoch
+    std::vector<E_FType> frq1;     ///< First frequency of the combinations of each observation
+    std::vector<E_FType> frq2;     ///< Second frequency of the combinations of each observation
+    std::vector<double>  gf0;      ///< Previous geometry free phase combination (m), 0 if unusable
+    std::vector<double>  gf1;      ///< Current geometry free phase combination (m), 0 if unusable
+    std::vector<double>  mw0;      ///< Previous Melbourne-Wubbena combination (cycles), 0 if unusable
+    std::vector<double>  mw1;      ///< Current Melbourne-Wubbena combination (cycles), 0 if unusable
+    std::vector<char>    gfSlip;   ///< Geometry free jump detected
+    std::vector<char>    mwSlip;   ///< Melbourne-Wubbena jump detected
+};
 
 int lsqqc(
     Trace&        trace,
@@ -32,10 +53,12 @@ int chiqc(
 
 void clearSlips(ObsList& obsList);
 
-void detectslips(Trace& trace, ObsList& obsList);
+void detectslips(Trace& trace, ObsList& obsList, SlipDetector& slipDetector);
+
+void detslp_gf_mw(Trace& trace, ObsList& obsList, SlipDetector& slipDetector);
 
-void detslp_gf(ObsList& obsList);
+void detslp_gf(Trace& trace, ObsList& obsList);
 
-void detslp_mw(ObsList& obsList);
+void detslp_mw(Trace& trace, ObsList& obsList);
 
-void detslp_ll(ObsList& obsList);
+void detslp_ll(Trace& trace, ObsList& obsList);
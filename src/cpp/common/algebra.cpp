@@ -118,6 +118,258 @@ int KFMeas::getNoiseIndex(const KFKey& key)  ///< Key to search for in noise vec
     return index->second;
 }
 
+/** Get a block of the design matrix.
+ * Rows of the compressed matrix are contiguous, whole rows need no search for the block's columns
+ */
+DesignMatrix KFMeas::designBlock(
+    int begH,  ///< Index of first measurement of the block
+    int numH,  ///< Number of measurements in the block
+    int begX,  ///< Index of first state of the block
+    int numX   ///< Number of states in the block
+) const
+{
+    if (begX == 0 && numX == H.cols())
+    {
+        return H.middleRows(begH, numH);
+    }
+
+    return H.block(begH, begX, numH, numX);
+}
+
+/** Maximum number of design matrix buffers kept for reuse
+ */
+const int DESIGN_POOL_SIZE = 8;
+
+/** Design matrix buffers kept between epochs.
+ * Resizing a compressed matrix keeps its storage, so a pooled buffer only reallocates when it is
+ * refilled with more non-zero elements than it has held before
+ */
+struct DesignPool
+{
+    std::mutex           mutex;
+    vector<DesignMatrix> buffers;
+};
+
+DesignPool& designPool()
+{
+    // never destroyed, measurements may still be released during static destruction
+    static DesignPool* pool_ptr = new DesignPool;
+
+    return *pool_ptr;
+}
+
+void takeFromPool(
+    DesignMatrix& matrix  ///< Matrix to replace with a pooled buffer
+)
+{
+    auto& pool = designPool();
+
+    lock_guard<std::mutex> guard(pool.mutex);
+
+    if (pool.buffers.empty())
+    {
+        return;
+    }
+
+    matrix.swap(pool.buffers.back());
+    pool.buffers.pop_back();
+}
+
+void returnToPool(
+    DesignMatrix& matrix  ///< Matrix to give up the storage of
+)
+{
+    if (matrix.data().allocatedSize() == 0)
+    {
+        return;
+    }
+
+    auto& pool = designPool();
+
+    lock_guard<std::mutex> guard(pool.mutex);
+
+    if (pool.buffers.size() >= DESIGN_POOL_SIZE)
+    {
+        return;
+    }
+
+    pool.buffers.emplace_back();
+    pool.buffers.back().swap(matrix);
+}
+
+/** Set the noise matrix to zero variances and no covariances
+ */
+void NoiseMatrix::setZero(
+    int size  ///< Number of measurements
+)
+{
+    variances = VectorXd::Zero(size);
+    covariances.resize(size, size);
+}
+
+/** Set the noise matrix from a full dense one
+ */
+NoiseMatrix& NoiseMatrix::operator=(
+    const MatrixXd& noise  ///< Full noise matrix
+)
+{
+    variances   = noise.diagonal();
+    covariances = noise.sparseView();
+    covariances.prune([](const Eigen::Index& row, const Eigen::Index& col, const double&)
+                      { return row != col; });
+
+    return *this;
+}
+
+/** Set the noise matrix from a full compressed one
+ */
+NoiseMatrix& NoiseMatrix::operator=(
+    const SparseMatrix<double>& noise  ///< Full noise matrix
+)
+{
+    variances   = noise.diagonal();
+    covariances = noise;
+    covariances.prune([](const Eigen::Index& row, const Eigen::Index& col, const double& value)
+                      { return row != col && value != 0; });
+
+    return *this;
+}
+
+/** Get the full noise matrix in compressed form
+ */
+SparseMatrix<double> NoiseMatrix::sparse() const
+{
+    SparseMatrix<double> noise(rows(), rows());
+    noise = variances.asDiagonal();
+
+    if (covariances.nonZeros() > 0)
+    {
+        noise += covariances;
+    }
+
+    return noise;
+}
+
+/** Get a dense diagonal block of the noise matrix
+ */
+MatrixXd NoiseMatrix::block(
+    int beg,  ///< Index of first measurement of the block
+    int num   ///< Number of measurements in the block
+) const
+{
+    MatrixXd noise = MatrixXd::Zero(num, num);
+
+    if (covariances.nonZeros() > 0)
+    {
+        noise = covariances.block(beg, beg, num, num);
+    }
+
+    noise.diagonal() = variances.segment(beg, num);
+
+    return noise;
+}
+
+/** Scale the row and column of the noise matrix for a measurement, as when its sigma is scaled
+ */
+void NoiseMatrix::scale(
+    int    index,  ///< Index of measurement to scale
+    double factor  ///< Factor to scale the sigma of the measurement by
+)
+{
+    variances(index) *= SQR(factor);
+
+    for (int col = 0; col < covariances.outerSize(); col++)
+        for (SparseMatrix<double>::InnerIterator it(covariances, col); it; ++it)
+        {
+            if (it.row() == index || it.col() == index)
+            {
+                it.valueRef() *= factor;
+            }
+        }
+}
+
+/** Get the noise matrix of a subset of measurements, followed by zeros up to the requested size
+ */
+NoiseMatrix NoiseMatrix::subset(
+    const vector<int>& indices,  ///< Indices of measurements to take in order
+    int                size      ///< Size of the new noise matrix
+) const
+{
+    NoiseMatrix subset;
+    subset.setZero(size);
+
+    vector<int> newIndices(rows(), -1);
+    for (int i = 0; i < indices.size(); i++)
+    {
+        newIndices[indices[i]] = i;
+        subset.variances(i)    = variances(indices[i]);
+    }
+
+    if (covariances.nonZeros() == 0)
+    {
+        return subset;
+    }
+
+    vector<Triplet<double>> triplets;
+    for (int col = 0; col < covariances.outerSize(); col++)
+        for (SparseMatrix<double>::InnerIterator it(covariances, col); it; ++it)
+        {
+            int newRow = newIndices[it.row()];
+            int newCol = newIndices[it.col()];
+
+            if (newRow >= 0 && newCol >= 0)
+            {
+                triplets.push_back({newRow, newCol, it.value()});
+            }
+        }
+
+    subset.covariances.setFromTriplets(triplets.begin(), triplets.end());
+
+    return subset;
+}
+
+/** Copy back the noise of a subset of measurements taken with subset()
+ */
+void NoiseMatrix::setSubset(
+    const vector<int>& indices,  ///< Indices of measurements the subset was taken from
+    const NoiseMatrix& subset    ///< Noise matrix of the subset
+)
+{
+    vector<int> newIndices(rows(), -1);
+    for (int i = 0; i < indices.size(); i++)
+    {
+        newIndices[indices[i]] = i;
+        variances(indices[i])  = subset.variances(i);
+    }
+
+    if (covariances.nonZeros() == 0 && subset.covariances.nonZeros() == 0)
+    {
+        return;
+    }
+
+    // keep covariances outside the subset, and replace those within it
+    vector<Triplet<double>> triplets;
+    for (int col = 0; col < covariances.outerSize(); col++)
+        for (SparseMatrix<double>::InnerIterator it(covariances, col); it; ++it)
+        {
+            if (newIndices[it.row()] < 0 || newIndices[it.col()] < 0)
+            {
+                triplets.push_back({(int)it.row(), (int)it.col(), it.value()});
+            }
+        }
+
+    for (int col = 0; col < subset.covariances.outerSize(); col++)
+        for (SparseMatrix<double>::InnerIterator it(subset.covariances, col); it; ++it)
+        {
+            if (it.row() < indices.size() && it.col() < indices.size())
+            {
+                triplets.push_back({indices[it.row()], indices[it.col()], it.value()});
+            }
+        }
+
+    covariances.setFromTriplets(triplets.begin(), triplets.end());
+}
+
 /** Clears and initialises the state transition matrix to identity at the beginning of an epoch.
  * Also clears any noise that was being added for the initialisation of a new state.
  */
@@ -1075,6 +1327,34 @@ void KFState::leastSquareSigmaChecks(
     }
 }
 
+/** Maximum fraction of non-zero design matrix elements for which compressed products are used.
+ * Compressed products cost one operation per non-zero element and column, dense BLAS products cost
+ * one per element but run much faster per operation.
+ */
+const double SPARSE_DESIGN_DENSITY = 0.02;
+
+/** Get a compressed (CSR) block of the design matrix of a set of measurements, and whether it is
+ * sparse enough for compressed products to be worth using over dense ones
+ */
+bool sparseDesign(
+    const KFMeas& kfMeas,  ///< Measurements to get design matrix of
+    int           begH,    ///< Index of first measurement of the block
+    int           numH,    ///< Number of measurements in the block
+    int           begX,    ///< Index of first state of the block
+    int           numX,    ///< Number of states in the block
+    DesignMatrix& Hs       ///< Compressed block of the design matrix
+)
+{
+    Hs = kfMeas.designBlock(begH, numH, begX, numX);
+
+    if (numH == 0 || numX == 0)
+    {
+        return false;
+    }
+
+    return Hs.nonZeros() <= SPARSE_DESIGN_DENSITY * numH * numX;
+}
+
 /** Compare variances of measurements and pre-filtered states to detect unreasonable values
  * Ref: Wang et al. (1997) - On Quality Control in Hydrographic GPS Surveying
  * &  Wieser et al. (2004) - Failure Scenarios to be Considered with Kinematic High Precision
@@ -1094,25 +1374,36 @@ void KFState::preFitSigmaChecks(
     auto& kfMeas = callbackDetails.kfMeas;
 
     auto V = kfMeas.V.segment(begH, numH);
-    auto R = kfMeas.R.block(begH, begH, numH, numH);
-    auto H = kfMeas.H.block(begH, begX, numH, numX);
+    auto R = kfMeas.R.diagonal().segment(begH, numH);
     auto P = this->P.block(begX, begX, numX, numX);
 
     ArrayXd  measRatios  = ArrayXd::Zero(numH);
     ArrayXd  stateRatios = ArrayXd::Zero(numX);
-    MatrixXd HPH_        = H * P * H.transpose();
+    MatrixXd HPH_;
+
+    DesignMatrix H;
+    if (sparseDesign(kfMeas, begH, numH, begX, numX, H))
+    {
+        MatrixXd HP = H * P;
+        HPH_        = HP * H.transpose();
+    }
+    else
+    {
+        MatrixXd Hd = H;
+        HPH_        = Hd * P * Hd.transpose();
+    }
 
     if (prefitOpts.sigma_check)
     {
         // use 'array' for component-wise calculations
         auto measVariations = V.array();
-        auto measVariances  = (HPH_.diagonal() + R.diagonal()).array();
+        auto measVariances  = (HPH_.diagonal() + R).array();
 
         measRatios = measVariations / measVariances.sqrt();
     }
     else if (prefitOpts.omega_test)  // Eugene: will be gone
     {
-        MatrixXd Qinv   = (HPH_ + R).inverse();
+        MatrixXd Qinv   = (HPH_ + kfMeas.R.block(begH, numH)).inverse();
         MatrixXd H_Qinv = H.transpose() * Qinv;
 
         // use 'array' for component-wise calculations
@@ -1165,8 +1456,10 @@ void KFState::preFitSigmaChecks(
               << time << "\tLargest meas  error is : " << maxMeasRatio << "\tAT " << measChunkIndex
               << " :\t" << kfMeas.obsKeys[measChunkIndex] << "\n";
 
+        VectorXd stateColumn = H.col(stateIndex);
+
         measRatios =
-            (H.col(stateIndex).array() != 0)
+            (stateColumn.array() != 0)
                 .select(measRatios, 0);  // set measRatios of non-referencing measurements to 0
         maxMeasRatio   = measRatios.abs().maxCoeff(&measIndex);
         measChunkIndex = measIndex + begH;
@@ -1323,11 +1616,11 @@ void KFState::postFitSigmaChecks(
     auto& trace  = callbackDetails.trace;
     auto& kfMeas = callbackDetails.kfMeas;
 
-    auto V  = kfMeas.V.segment(begH, numH);
-    auto VV = kfMeas.VV.segment(begH, numH);
-    auto R  = kfMeas.R.block(begH, begH, numH, numH);
-    auto H  = kfMeas.H.block(begH, begX, numH, numX);
-    auto P  = this->P.block(begX, begX, numX, numX);
+    auto         V  = kfMeas.V.segment(begH, numH);
+    auto         VV = kfMeas.VV.segment(begH, numH);
+    auto         R  = kfMeas.R.diagonal().segment(begH, numH);
+    DesignMatrix H  = kfMeas.designBlock(begH, numH, begX, numX);
+    auto         P  = this->P.block(begX, begX, numX, numX);
 
     ArrayXd measRatios  = ArrayXd::Zero(numH);
     ArrayXd stateRatios = ArrayXd::Zero(numX);
@@ -1338,7 +1631,7 @@ void KFState::postFitSigmaChecks(
         auto measVariations  = VV.array();
         auto stateVariations = dx.segment(begX, numX).array();
 
-        auto measVariances  = R.diagonal().array();
+        auto measVariances  = R.array();
         auto stateVariances = P.diagonal().array();
 
         measRatios  = measVariations / measVariances.sqrt();
@@ -1396,8 +1689,10 @@ void KFState::postFitSigmaChecks(
               << time << "\tLargest meas  error is : " << maxMeasRatio << "\tAT " << measChunkIndex
               << " :\t" << kfMeas.obsKeys[measChunkIndex] << "\n";
 
+        VectorXd stateColumn = H.col(stateIndex);
+
         measRatios =
-            (H.col(stateIndex).array() != 0)
+            (stateColumn.array() != 0)
                 .select(measRatios, 0);  // Set measRatios of non-referencing measurements to 0
         maxMeasRatio   = measRatios.abs().maxCoeff(&measIndex);
         measChunkIndex = measIndex + begH;
@@ -1482,11 +1777,10 @@ double KFState::measChiSquare(
 )
 {
     auto w  = dx.segment(begX, numX);
-    auto H  = kfMeas.H.block(begH, begX, numH, numX);
     auto VV = kfMeas.VV.segment(begH, numH);
-    auto R  = kfMeas.R.block(begH, begH, numH, numH);
+    auto R  = kfMeas.R.diagonal().segment(begH, numH);
 
-    double chiSq = (VV.array().square() / R.diagonal().array()).sum();
+    double chiSq = (VV.array().square() / R.array()).sum();
 
     trace << "\n"
           << "DOING MEASUREMENT CHI-SQUARE TEST:";
@@ -1507,11 +1801,10 @@ double KFState::innovChiSquare(
     int     numH     ///< Number of measurements to process
 )
 {
-    auto     H = kfMeas.H.block(begH, begX, numH, numX);
-    auto     V = kfMeas.V.segment(begH, numH);
-    auto     R = kfMeas.R.block(begH, begH, numH, numH);
-    auto     P = this->P.block(begX, begX, numX, numX);
-    MatrixXd Q = R + H * P * H.transpose();
+    DesignMatrix H = kfMeas.designBlock(begH, numH, begX, numX);
+    auto         V = kfMeas.V.segment(begH, numH);
+    auto         P = this->P.block(begX, begX, numX, numX);
+    MatrixXd     Q = kfMeas.R.block(begH, numH) + H * P * H.transpose();
 
     double chiSq = V.transpose() * Q.inverse() * V;
 
@@ -1540,47 +1833,64 @@ bool KFState::kFilter(
     int       numH    ///< Number of measurements to process
 )
 {
-    auto& R      = kfMeas.R;
-    auto& V      = kfMeas.V;
-    auto& H      = kfMeas.H;
-    auto& H_star = kfMeas.H_star;
+    auto& V = kfMeas.V;
 
     auto noise = kfMeas.uncorrelatedNoise.asDiagonal();  // todo Eugene: check chunking indices
 
+    // the design matrix is kept compressed, only blocks too dense for compressed products are
+    // expanded for BLAS
+    DesignMatrix Hs;
+    MatrixXd     Hd;
+    bool         sparse = sparseDesign(kfMeas, begH, numH, begX, numX, Hs);
+    if (sparse == false)
+    {
+        Hd = Hs;
+    }
+
+    // the noise matrix is kept as variances and sparse covariances, expand this block of it
+    MatrixXd Rd = kfMeas.R.block(begH, numH);
+
     // Get pointers to block data (no copying!)
-    const double* H_ptr = H.data() + begH + begX * H.rows();  // H block starting point
+    const double* H_ptr = Hd.data();                          // H block starting point
     const double* P_ptr = P.data() + begX + begX * P.rows();  // P block starting point
-    const double* R_ptr = R.data() + begH + begH * R.rows();  // R block starting point
+    const double* R_ptr = Rd.data();                          // R block starting point
     const double* V_ptr = V.data() + begH;                    // V segment starting point
 
-    int ldH = H.rows();                                       // Leading dimension of full H matrix
+    int ldH = numH;                                           // Leading dimension of H block
     int ldP = P.rows();                                       // Leading dimension of full P matrix
-    int ldR = R.rows();                                       // Leading dimension of full R matrix
+    int ldR = numH;                                           // Leading dimension of R block
 
-    MatrixXd I         = MatrixXd::Identity(numH, numH);
-    auto     subH_star = H_star.middleRows(begH, numH);
-    MatrixXd HRH_star  = subH_star * noise * subH_star.transpose();
+    MatrixXd     I        = MatrixXd::Identity(numH, numH);
+    DesignMatrix Hs_star  = kfMeas.H_star.middleRows(begH, numH);
+    MatrixXd     HRH_star = SparseMatrix<double>(Hs_star * noise * Hs_star.transpose());
 
-    // Compute HP = H * P using BLAS directly on blocks (no copy!)
+    // Compute HP = H * P, using the compressed design matrix or BLAS directly on blocks (no copy!)
     MatrixXd HP(numH, numX);
-    LapackWrapper::dgemm(
-        LapackWrapper::CblasColMajor,
-        LapackWrapper::CblasNoTrans,
-        LapackWrapper::CblasNoTrans,
-        numH,
-        numX,
-        numX,
-        1.0,
-        H_ptr,
-        ldH,
-        P_ptr,
-        ldP,
-        0.0,
-        HP.data(),
-        numH
-    );
+    if (sparse)
+    {
+        HP.noalias() = Hs * P.block(begX, begX, numX, numX);
+    }
+    else
+    {
+        LapackWrapper::dgemm(
+            LapackWrapper::CblasColMajor,
+            LapackWrapper::CblasNoTrans,
+            LapackWrapper::CblasNoTrans,
+            numH,
+            numX,
+            numX,
+            1.0,
+            H_ptr,
+            ldH,
+            P_ptr,
+            ldP,
+            0.0,
+            HP.data(),
+            numH
+        );
+    }
 
-    // Compute Q = HP * H' + R using BLAS directly
+    // Compute Q = HP * H' + R
     MatrixXd Q(numH, numH);
     // First: Q = R (copy R block)
     for (int j = 0; j < numH; j++)
@@ -1588,22 +1898,29 @@ bool KFState::kFilter(
         LapackWrapper::dcopy(numH, R_ptr + j * ldR, 1, Q.data() + j * numH, 1);
     }
     // Then: Q = HP * H' + Q
-    LapackWrapper::dgemm(
-        LapackWrapper::CblasColMajor,
-        LapackWrapper::CblasNoTrans,
-        LapackWrapper::CblasTrans,
-        numH,
-        numH,
-        numX,
-        1.0,
-        HP.data(),
-        numH,
-        H_ptr,
-        ldH,
-        1.0,
-        Q.data(),
-        numH
-    );
+    if (sparse)
+    {
+        Q.noalias() += HP * Hs.transpose();
+    }
+    else
+    {
+        LapackWrapper::dgemm(
+            LapackWrapper::CblasColMajor,
+            LapackWrapper::CblasNoTrans,
+            LapackWrapper::CblasTrans,
+            numH,
+            numH,
+            numX,
+            1.0,
+            HP.data(),
+            numH,
+            H_ptr,
+            ldH,
+            1.0,
+            Q.data(),
+            numH
+        );
+    }
 
     MatrixXd K;
     MatrixXd HRHQ_star;
@@ -1905,22 +2222,29 @@ bool KFState::kFilter(
 
                 // Compute QinvH = Qinv * H
                 QinvH.resize(numH, numX);
-                LapackWrapper::dgemm(
-                    LapackWrapper::CblasColMajor,
-                    LapackWrapper::CblasNoTrans,
-                    LapackWrapper::CblasNoTrans,
-                    numH,
-                    numX,
-                    numH,
-                    1.0,
-                    Qinv.data(),
-                    numH,
-                    H_ptr,
-                    ldH,
-                    0.0,
-                    QinvH.data(),
-                    numH
-                );
+                if (sparse)
+                {
+                    QinvH.noalias() = Qinv * Hs;
+                }
+                else
+                {
+                    LapackWrapper::dgemm(
+                        LapackWrapper::CblasColMajor,
+                        LapackWrapper::CblasNoTrans,
+                        LapackWrapper::CblasNoTrans,
+                        numH,
+                        numX,
+                        numH,
+                        1.0,
+                        Qinv.data(),
+                        numH,
+                        H_ptr,
+                        ldH,
+                        0.0,
+                        QinvH.data(),
+                        numH
+                    );
+                }
             }
             else
             {
@@ -1976,22 +2300,29 @@ bool KFState::kFilter(
                 }
 
                 QinvH.resize(numH, numX);
-                LapackWrapper::dgemm(
-                    LapackWrapper::CblasColMajor,
-                    LapackWrapper::CblasNoTrans,
-                    LapackWrapper::CblasNoTrans,
-                    numH,
-                    numX,
-                    numH,
-                    1.0,
-                    Qinv.data(),
-                    numH,
-                    H_ptr,
-                    ldH,
-                    0.0,
-                    QinvH.data(),
-                    numH
-                );
+                if (sparse)
+                {
+                    QinvH.noalias() = Qinv * Hs;
+                }
+                else
+                {
+                    LapackWrapper::dgemm(
+                        LapackWrapper::CblasColMajor,
+                        LapackWrapper::CblasNoTrans,
+                        LapackWrapper::CblasNoTrans,
+                        numH,
+                        numX,
+                        numH,
+                        1.0,
+                        Qinv.data(),
+                        numH,
+                        H_ptr,
+                        ldH,
+                        0.0,
+                        QinvH.data(),
+                        numH
+                    );
+                }
             }
         }
         else
@@ -2042,22 +2373,29 @@ bool KFState::kFilter(
 
         // Step 1: IKH = I - K*H
         MatrixXd IKH = MatrixXd::Identity(numX, numX);
-        LapackWrapper::dgemm(
-            LapackWrapper::CblasColMajor,
-            LapackWrapper::CblasNoTrans,
-            LapackWrapper::CblasNoTrans,
-            numX,
-            numX,
-            numH,
-            -1.0,
-            K.data(),
-            numX,
-            H_ptr,
-            ldH,
-            1.0,
-            IKH.data(),
-            numX
-        );
+        if (sparse)
+        {
+            IKH.noalias() -= K * Hs;
+        }
+        else
+        {
+            LapackWrapper::dgemm(
+                LapackWrapper::CblasColMajor,
+                LapackWrapper::CblasNoTrans,
+                LapackWrapper::CblasNoTrans,
+                numX,
+                numX,
+                numH,
+                -1.0,
+                K.data(),
+                numX,
+                H_ptr,
+                ldH,
+                1.0,
+                IKH.data(),
+                numX
+            );
+        }
 
         // Step 2: temp = IKH * P
         MatrixXd temp(numX, numX);
@@ -2196,7 +2534,7 @@ bool KFState::kFilter(
                   << P.block(begX, begX, numX, numX);
         std::cout << "\n"
                   << "R block:" << "\n"
-                  << R.block(begH, begH, numH, numH);
+                  << Rd;
         std::cout << "\n"
                   << "K :" << "\n"
                   << K;
@@ -2213,13 +2551,130 @@ bool KFState::kFilter(
     return true;
 }
 
+/** Number of columns of the inverse of a normal matrix recovered per solve, when only its diagonal
+ * is required
+ */
+const int INVERSE_DIAGONAL_BLOCK = 64;
+
+/** Find the diagonal of the inverse of a factorised normal matrix, recovered a block of columns at
+ * a time so that the full inverse is never formed
+ */
+template <typename SOLVER>
+bool inverseDiagonal(
+    SOLVER&   solver,    ///< Factorisation of the normal matrix
+    int       numX,      ///< Number of parameters
+    VectorXd& variances  ///< Output diagonal of the inverse
+)
+{
+    variances = VectorXd::Zero(numX);
+
+    MatrixXd unit = MatrixXd::Zero(numX, INVERSE_DIAGONAL_BLOCK);
+    MatrixXd columns;
+    for (int start = 0; start < numX; start += INVERSE_DIAGONAL_BLOCK)
+    {
+        int numCols = std::min(INVERSE_DIAGONAL_BLOCK, numX - start);
+
+        for (int j = 0; j < numCols; j++)
+            unit(start + j, j) = 1;
+
+        columns = solver.solve(unit.leftCols(numCols));
+        if (solver.info() != Eigen::ComputationInfo::Success)
+        {
+            return false;
+        }
+
+        for (int j = 0; j < numCols; j++)
+        {
+            variances(start + j) = columns(start + j, j);
+            unit(start + j, j)   = 0;
+        }
+    }
+
+    return variances.allFinite();
+}
+
+/** Solve sparse normal equations, and find the variances of the parameters from the diagonal of the
+ * inverse of the normal matrix
+ */
+template <typename SOLVER>
+bool sparseNormalSolve(
+    SparseMatrix<double>& N,         ///< Normal matrix
+    VectorXd&             HWV,       ///< Right hand side of the normal equations
+    VectorXd&             xp,        ///< Post-fit parameter vector
+    VectorXd&             variances  ///< Post-fit variances of parameters
+)
+{
+    SOLVER solver;
+    solver.compute(N);
+    if (solver.info() != Eigen::ComputationInfo::Success)
+    {
+        return false;
+    }
+
+    xp = solver.solve(HWV);
+    if (solver.info() != Eigen::ComputationInfo::Success || xp.allFinite() == false)
+    {
+        return false;
+    }
+
+    return inverseDiagonal(solver, N.rows(), variances);
+}
+
+/** Use a dense factorisation of a normal matrix to find either its full inverse, or the solution
+ * of the normal equations and the diagonal of the inverse if the full inverse is not requested
+ */
+template <typename SOLVER>
+bool solverInverse(
+    SOLVER&   solver,     ///< Factorisation of the normal matrix
+    int       numX,       ///< Number of parameters
+    VectorXd& HWV,        ///< Right hand side of the normal equations
+    VectorXd& xp,         ///< Post-fit parameter vector, if the inverse is not formed
+    VectorXd& variances,  ///< Post-fit variances of parameters, if the inverse is not formed
+    MatrixXd* Pp_ptr,     ///< Requested full inverse, or nullptr for the diagonal only
+    MatrixXd& Pp,         ///< Output full inverse
+    bool&     inverted    ///< Output whether the full inverse was formed
+)
+{
+    if (solver.info() != Eigen::ComputationInfo::Success)
+    {
+        return false;
+    }
+
+    if (Pp_ptr)
+    {
+        Pp       = solver.solve(MatrixXd::Identity(numX, numX));
+        inverted = true;
+
+        return solver.info() == Eigen::ComputationInfo::Success;
+    }
+
+    xp = solver.solve(HWV);
+    if (solver.info() != Eigen::ComputationInfo::Success)
+    {
+        return false;
+    }
+
+    inverted = false;
+
+    return inverseDiagonal(solver, numX, variances);
+}
+
 /** Least squares estimator.
+ *
+ * The normal equations are accumulated from the rows of the design matrix scaled by the square
+ * roots of their weights, without forming a weight matrix. Sparse designs (large networks, where
+ * each measurement references only a few states) are accumulated and factorised as sparse
+ * matrices, using the solvers' default fill-reducing (AMD) ordering.
+ * If the full covariance is not requested and a factorisation (LLT or LDLT) inverter is
+ * configured, only the diagonal of the inverse is recovered and the explicit inverse is never
+ * formed.
  */
 bool KFState::leastSquare(
-    Trace&    trace,   ///< Trace to output to
-    KFMeas&   kfMeas,  ///< Measurements, noise, and design matrices
-    VectorXd& xp,      ///< Post-fit parameter vector
-    MatrixXd& Pp       ///< Post-fit covariance of parameters
+    Trace&    trace,      ///< Trace to output to
+    KFMeas&   kfMeas,     ///< Measurements, noise, and design matrices
+    VectorXd& xp,         ///< Post-fit parameter vector
+    VectorXd& variances,  ///< Post-fit variances of parameters
+    MatrixXd* Pp_ptr      ///< Optional output of the full post-fit covariance of parameters
 )
 {
     // invert measurement noise matrix to get a weight matrix
@@ -2248,11 +2703,65 @@ bool KFState::leastSquare(
         return false;
     }
 
-    // calculate least squares solution
-    MatrixXd I   = MatrixXd::Identity(numX, numX);
-    MatrixXd W   = kfMeas.W.asDiagonal();
-    MatrixXd H_W = H.transpose() * W;
-    MatrixXd N   = H_W * H;
+    // scale rows by root weights so that the normal matrix is a plain rank-k update, N = Hw' * Hw
+    VectorXd rootW = weights.sqrt().matrix();
+    VectorXd Vw    = rootW.cwiseProduct(V);
+    VectorXd HWV;
+    MatrixXd N;
+
+    if (H.nonZeros() <= SPARSE_DESIGN_DENSITY * numH * numX)
+    {
+        DesignMatrix         Hw = rootW.asDiagonal() * H;
+        SparseMatrix<double> Ns = Hw.transpose() * Hw;
+
+        HWV = Hw.transpose() * Vw;
+
+        // factorisation inverters have sparse equivalents, the explicit inverse is always dense
+        if (Pp_ptr == nullptr &&
+            (lsq_inverter == E_Inverter::LDLT || lsq_inverter == E_Inverter::LLT))
+        {
+            bool pass;
+            if (lsq_inverter == E_Inverter::LLT)
+                pass = sparseNormalSolve<SimplicialLLT<SparseMatrix<double>>>(
+                    Ns,
+                    HWV,
+                    xp,
+                    variances
+                );
+            else
+                pass = sparseNormalSolve<SimplicialLDLT<SparseMatrix<double>>>(
+                    Ns,
+                    HWV,
+                    xp,
+                    variances
+                );
+
+            if (pass)
+            {
+                return true;
+            }
+
+            trace << "\n"
+                  << "Sparse normal equation solution failed, reverting to dense";
+        }
+
+        N = Ns;
+    }
+    else
+    {
+        MatrixXd Hw = rootW.asDiagonal() * MatrixXd(H);
+
+        N = MatrixXd::Zero(numX, numX);
+        N.selfadjointView<Eigen::Lower>().rankUpdate(Hw.transpose());
+        N.triangularView<Eigen::StrictlyUpper>() = N.transpose();
+
+        HWV = Hw.transpose() * Vw;
+    }
+
+    // the full inverse is only formed if it is requested, or by the explicit inverter
+    MatrixXd  localPp;
+    MatrixXd& Pp       = Pp_ptr ? *Pp_ptr : localPp;
+    bool      inverted = true;
 
     bool repeat = true;
     while (repeat)
@@ -2271,8 +2780,10 @@ bool KFState::leastSquare(
             {
                 auto           NN = N.triangularView<Eigen::Upper>().transpose();
                 LDLT<MatrixXd> solver;
-                if ((solver.compute(NN), solver.info() != Eigen::ComputationInfo::Success) ||
-                    (Pp = solver.solve(I), solver.info() != Eigen::ComputationInfo::Success))
+                solver.compute(NN);
+
+                bool pass = solverInverse(solver, numX, HWV, xp, variances, Pp_ptr, Pp, inverted);
+                if (pass == false)
                 {
                     BOOST_LOG_TRIVIAL(error)
                         << "Failed to solve normal equation, see trace file for matrices";
@@ -2284,10 +2795,10 @@ bool KFState::leastSquare(
                           << N;
                     trace << "\n"
                           << "H: " << "\n"
-                          << H;
+                          << MatrixXd(H);
                     trace << "\n"
                           << "W: " << "\n"
-                          << W;
+                          << kfMeas.W;
 
                     return false;
                 }
@@ -2298,8 +2809,10 @@ bool KFState::leastSquare(
             {
                 auto          NN = N.triangularView<Eigen::Upper>().transpose();
                 LLT<MatrixXd> solver;
-                if ((solver.compute(NN), solver.info() != Eigen::ComputationInfo::Success) ||
-                    (Pp = solver.solve(I), solver.info() != Eigen::ComputationInfo::Success))
+                solver.compute(NN);
+
+                bool pass = solverInverse(solver, numX, HWV, xp, variances, Pp_ptr, Pp, inverted);
+                if (pass == false)
                 {
                     BOOST_LOG_TRIVIAL(warning) << "Normal matrix not invertible with LLT "
                                                   "inverter, trying LDLT inverter instead";
@@ -2330,7 +2843,11 @@ bool KFState::leastSquare(
         repeat = false;
     }
 
-    xp = Pp * H_W * V;
+    if (inverted)
+    {
+        xp        = Pp * HWV;
+        variances = Pp.diagonal();
+    }
 
     // 	std::cout << "N : " << "\n" << N;
     bool error = xp.array().isNaN().any();
@@ -2344,10 +2861,10 @@ bool KFState::leastSquare(
                   << P << "\n";
         std::cout << "\n"
                   << "W :" << "\n"
-                  << W << "\n";
+                  << kfMeas.W << "\n";
         std::cout << "\n"
                   << "H :" << "\n"
-                  << H << "\n";
+                  << MatrixXd(H) << "\n";
         std::cout << "\n";
         std::cout << "NAN found. Exiting....";
         std::cout << "\n";
@@ -2403,6 +2920,27 @@ void KFState::chiQC(
     return;
 }
 
+/** Sort the entries of a row of a compressed matrix by column, after it was filled in place.
+ * States are usually indexed in key order already, so this is rarely more than a check
+ */
+void sortCompressedRow(
+    DesignMatrix& matrix,  ///< Matrix to sort the row of
+    int           row      ///< Index of row to sort
+)
+{
+    int*    inner  = matrix.innerIndexPtr();
+    double* values = matrix.valuePtr();
+    int     rowBeg = matrix.outerIndexPtr()[row];
+    int     rowEnd = matrix.outerIndexPtr()[row + 1];
+
+    for (int i = rowBeg + 1; i < rowEnd; i++)
+        for (int j = i; j > rowBeg && inner[j - 1] > inner[j]; j--)
+        {
+            std::swap(inner[j - 1], inner[j]);
+            std::swap(values[j - 1], values[j]);
+        }
+}
+
 /** Combine a list of KFMeasEntrys into a single KFMeas object for used in the filter
  */
 KFMeas::KFMeas(
@@ -2447,9 +2985,44 @@ KFMeas::KFMeas(
         }
     }
 
-    R      = MatrixXd::Zero(numMeas, numMeas);
-    H      = MatrixXd::Zero(numMeas, kfState.x.rows());
-    H_star = MatrixXd::Zero(numMeas, uncorrelatedNoise.rows());
+    R.setZero(numMeas);
+
+    // the design matrices are filled in place as the measurements are gathered, into buffers kept
+    // from previous epochs. count the entries of each measurement to size them first
+    takeFromPool(H);
+    takeFromPool(H_star);
+
+    H.resize(numMeas, kfState.x.rows());
+    H_star.resize(numMeas, uncorrelatedNoise.rows());
+    {
+        auto outer     = H.outerIndexPtr();
+        auto outerStar = H_star.outerIndexPtr();
+
+        outer[0]     = 0;
+        outerStar[0] = 0;
+        for (int meas = 0; meas < numMeas; meas++)
+        {
+            int count     = 0;
+            int countStar = 0;
+            for (auto& [kfKey, coeff] : kfEntryList[meas].designEntryMap)
+                if (coeff != 0)
+                {
+                    count++;
+                }
+
+            for (auto& [kfKey, coeff] : kfEntryList[meas].noiseEntryMap)
+                if (coeff != 0)
+                {
+                    countStar++;
+                }
+
+            outer[meas + 1]     = outer[meas] + count;
+            outerStar[meas + 1] = outerStar[meas] + countStar;
+        }
+
+        H.resizeNonZeros(outer[numMeas]);
+        H_star.resizeNonZeros(outerStar[numMeas]);
+    }
 
     prefitRatios  = VectorXd::Zero(numMeas);
     postfitRatios = VectorXd::Zero(numMeas);
@@ -2470,7 +3043,7 @@ KFMeas::KFMeas(
 
         auto& entry = *it;
 
-        R(meas, meas) = entry.noise;
+        R.variances(meas) = entry.noise;
 
         auto& value = Y(meas);
         auto& innov = V(meas);
@@ -2478,6 +3051,8 @@ KFMeas::KFMeas(
         value = entry.value;
         innov = entry.innov;
 
+        int rowEnd = H.outerIndexPtr()[meas];
+
         for (auto& [kfKey, coeff] : entry.designEntryMap)
         {
             if (coeff == 0)
@@ -2494,7 +3069,10 @@ KFMeas::KFMeas(
                           << kfKey << "\n";
                 error = true;
             }
-            H(meas, index) = coeff;
+
+            H.innerIndexPtr()[rowEnd] = index;
+            H.valuePtr()[rowEnd]      = coeff;
+            rowEnd++;
 
             if (kfState.assume_linearity)
             {
@@ -2515,8 +3093,15 @@ KFMeas::KFMeas(
             }
         }
 
+        int rowEndStar = H_star.outerIndexPtr()[meas];
+
         for (auto& [kfKey, coeff] : entry.noiseEntryMap)
         {
+            if (coeff == 0)
+            {
+                continue;
+            }
+
             int index = getNoiseIndex(kfKey);
             if (index < 0)
             {
@@ -2524,9 +3109,15 @@ KFMeas::KFMeas(
                           << "\n";
                 error = true;
             }
-            H_star(meas, index) = coeff;
+
+            H_star.innerIndexPtr()[rowEndStar] = index;
+            H_star.valuePtr()[rowEndStar]      = coeff;
+            rowEndStar++;
         }
 
+        sortCompressedRow(H, meas);
+        sortCompressedRow(H_star, meas);
+
         obsKeys[meas]        = std::move(entry.obsKey);
         metaDataMaps[meas]   = std::move(entry.metaDataMap);
         componentsMaps[meas] = std::move(entry.componentsMap);
@@ -2535,6 +3126,8 @@ KFMeas::KFMeas(
 
     if (error)
     {
+        H.resize(0, 0);
+        H_star.resize(0, 0);
         return;
     }
 
@@ -2545,22 +3138,7 @@ KFMeas::KFMeas(
 
     if (uncorrelatedNoise.rows() != 0)
     {
-        SparseMatrix<double> R_A = SparseMatrix<double>(numMeas, uncorrelatedNoise.rows());
-
-        int meas = 0;
-        for (auto& entry : kfEntryList)
-        {
-            for (auto& [kfKey, value] : entry.noiseEntryMap)
-            {
-                int noiseIndex = noiseIndexMap[kfKey];
-
-                R_A.insert(meas, noiseIndex) = value;
-            }
-
-            meas++;
-        }
-
-        R = R_A * uncorrelatedNoise.asDiagonal() * R_A.transpose();
+        R = SparseMatrix<double>(H_star * uncorrelatedNoise.asDiagonal() * H_star.transpose());
     }
 }
 
@@ -2818,10 +3396,10 @@ void KFState::filterKalman(
 
             if (advanced_postfits == false)
             {
+                DesignMatrix Hs = kfMeas.designBlock(fc.begH, fc.numH, fc.begX, fc.numX);
+
                 kfMeas.VV.segment(fc.begH, fc.numH) =
-                    kfMeas.V.segment(fc.begH, fc.numH) -
-                    kfMeas.H.block(fc.begH, fc.begX, fc.numH, fc.numX) *
-                        dx.segment(fc.begX, fc.numX);
+                    kfMeas.V.segment(fc.begH, fc.numH) - Hs * dx.segment(fc.begX, fc.numX);
             }
 
             bool stopIterating = true;
@@ -3083,15 +3661,29 @@ bool KFState::leastSquareInitStates(
     }
 
     // find the subset of measurements that are required for the initialisation
-    auto usedMeasMask = kfMeas.H(all, newStateIndicies).rowwise().any();
+    vector<bool> newStateMask(kfMeas.H.cols(), false);
+    for (auto index : newStateIndicies)
+    {
+        newStateMask[index] = true;
+    }
 
     vector<int> leastSquareMeasIndicies;
     vector<int> pseudoMeasStateIndicies;
 
-    for (int measIndex = 0; measIndex < usedMeasMask.rows(); measIndex++)
+    for (int measIndex = 0; measIndex < kfMeas.H.rows(); measIndex++)
     {
+        bool used = false;
+        for (DesignMatrix::InnerIterator it(kfMeas.H, measIndex); it; ++it)
+        {
+            if (it.value() != 0 && newStateMask[it.col()])
+            {
+                used = true;
+                break;
+            }
+        }
+
         // if not used, dont worry about it
-        if (usedMeasMask(measIndex) == 0)
+        if (used == false)
         {
             continue;
         }
@@ -3101,9 +3693,11 @@ bool KFState::leastSquareInitStates(
         leastSquareMeasIndicies.push_back(measIndex);
 
         // remember make a pseudo measurement of anything it references that is already set
-        for (int stateIndex = 0; stateIndex < kfMeas.H.cols(); stateIndex++)
+        for (DesignMatrix::InnerIterator it(kfMeas.H, measIndex); it; ++it)
         {
-            if ((kfMeas.H(measIndex, stateIndex) != 0) && (P(stateIndex, stateIndex) >= 0))
+            int stateIndex = it.col();
+
+            if ((it.value() != 0) && (P(stateIndex, stateIndex) >= 0))
             {
                 pseudoMeasStateIndicies.push_back(stateIndex);
             }
@@ -3114,18 +3708,25 @@ bool KFState::leastSquareInitStates(
     int pseudoMeasCount = pseudoMeasStateIndicies.size();
     int totalMeasCount  = lsqMeasCount + pseudoMeasCount;
 
-    // Create new measurement objects with larger size, (using all states for now)
-    KFMeas leastSquareMeas;
-
-    leastSquareMeas.V = VectorXd::Zero(totalMeasCount);
-    leastSquareMeas.R = MatrixXd::Zero(totalMeasCount, totalMeasCount);
-    leastSquareMeas.H = MatrixXd::Zero(totalMeasCount, kfMeas.H.cols());
+    // Create a new measurement object with larger size, using only the required states
+    KFMeas leastSquareMeasSubs;
+    leastSquareMeasSubs.time = kfMeas.time;
 
     // copy in the required measurements from the old set
-    leastSquareMeas.V.head(lsqMeasCount) = kfMeas.V(leastSquareMeasIndicies);
-    leastSquareMeas.R.topLeftCorner(lsqMeasCount, lsqMeasCount) =
-        kfMeas.R(leastSquareMeasIndicies, leastSquareMeasIndicies);
-    leastSquareMeas.H.topRows(lsqMeasCount) = kfMeas.H(leastSquareMeasIndicies, all);
+    leastSquareMeasSubs.V = VectorXd::Zero(totalMeasCount);
+    leastSquareMeasSubs.R = kfMeas.R.subset(leastSquareMeasIndicies, totalMeasCount);
+
+    leastSquareMeasSubs.V.head(lsqMeasCount) = kfMeas.V(leastSquareMeasIndicies);
+
+    vector<Triplet<double>> triplets;
+    for (int i = 0; i < lsqMeasCount; i++)
+        for (DesignMatrix::InnerIterator it(kfMeas.H, leastSquareMeasIndicies[i]); it; ++it)
+        {
+            if (it.value() != 0)
+            {
+                triplets.push_back({i, (int)it.col(), it.value()});
+            }
+        }
 
     // append any new pseudo measurements to the end
     for (int i = 0; i < pseudoMeasCount; i++)
@@ -3135,35 +3736,42 @@ bool KFState::leastSquareInitStates(
 
         if (innovReady)
         {
-            leastSquareMeas.V(measIndex) = 0;  // take x as apriori state
+            leastSquareMeasSubs.V(measIndex) = 0;  // take x as apriori state
         }
         else
         {
-            leastSquareMeas.V(measIndex) = x(stateIndex);  // take 0 as apriori state
+            leastSquareMeasSubs.V(measIndex) = x(stateIndex);  // take 0 as apriori state
         }
-        leastSquareMeas.R(measIndex, measIndex) =
+        leastSquareMeasSubs.R.variances(measIndex) =
             P(stateIndex, stateIndex);  // todo Eugene: check equivalence w/ back-subsitution -
                                         // pseudo var should be 0 instead of P, or doesn't matter?
-        leastSquareMeas.H(measIndex, stateIndex) = 1;
+        triplets.push_back({measIndex, stateIndex, 1});
     }
 
     // find the subset of states required for these measurements
     vector<int> usedStateIndicies;
-    auto        usedStateMask = leastSquareMeas.H.colwise().any();
-    for (int i = 0; i < usedStateMask.cols(); i++)
+    vector<int> newStateIndex(kfMeas.H.cols(), -1);
+    for (auto& triplet : triplets)
     {
-        if (usedStateMask(i) != 0)
+        newStateIndex[triplet.col()] = 0;
+    }
+
+    for (int i = 0; i < newStateIndex.size(); i++)
+    {
+        if (newStateIndex[i] == 0)
         {
+            newStateIndex[i] = usedStateIndicies.size();
             usedStateIndicies.push_back(i);
         }
     }
 
-    // create a new meaurement object using only the required states.
-    KFMeas leastSquareMeasSubs;
-    leastSquareMeasSubs.time = kfMeas.time;
-    leastSquareMeasSubs.V    = leastSquareMeas.V;
-    leastSquareMeasSubs.R    = leastSquareMeas.R;
-    leastSquareMeasSubs.H    = leastSquareMeas.H(all, usedStateIndicies);
+    for (auto& triplet : triplets)
+    {
+        triplet = Triplet<double>(triplet.row(), newStateIndex[triplet.col()], triplet.value());
+    }
+
+    leastSquareMeasSubs.H.resize(totalMeasCount, usedStateIndicies.size());
+    leastSquareMeasSubs.H.setFromTriplets(triplets.begin(), triplets.end());
 
     for (int i = 0; i < lsqMeasCount; i++)
     {
@@ -3175,13 +3783,21 @@ bool KFState::leastSquareInitStates(
 
     int      usedStateCount = usedStateIndicies.size();
     VectorXd xp             = VectorXd::Zero(usedStateCount);
-    MatrixXd Pp             = MatrixXd::Identity(usedStateCount, usedStateCount);
+    VectorXd Pv             = VectorXd::Ones(usedStateCount);
+    MatrixXd Pp;
 
     TestStatistics testStatistics;
     KFStatistics   statistics;
+    // off-diagonal covariances are only needed to initialise them, or for the omega test
+    MatrixXd* Pp_ptr = nullptr;
+    if (initCovars || lsqOpts.omega_test)
+    {
+        Pp_ptr = &Pp;
+    }
+
     for (int i = 0; i < lsqOpts.max_iterations; i++)
     {
-        bool pass = leastSquare(trace, leastSquareMeasSubs, xp, Pp);
+        bool pass = leastSquare(trace, leastSquareMeasSubs, xp, Pv, Pp_ptr);
 
         if (pass == false)
         {
@@ -3280,7 +3896,7 @@ bool KFState::leastSquareInitStates(
         }
 
         double newStateVal = xp(i);
-        double newStateCov = Pp(i, i);
+        double newStateCov = Pv(i);
 
         dx(stateRowIndex) = newStateVal;
 
@@ -3310,8 +3926,7 @@ bool KFState::leastSquareInitStates(
     }
 
     kfMeas.VV = kfMeas.V - kfMeas.H * dx;
-    kfMeas.R(leastSquareMeasIndicies, leastSquareMeasIndicies) =
-        leastSquareMeasSubs.R.topLeftCorner(lsqMeasCount, lsqMeasCount);
+    kfMeas.R.setSubset(leastSquareMeasIndicies, leastSquareMeasSubs.R);
     if (leastSquareMeasSubs.postfitRatios.rows() >= lsqMeasCount)
     {
         kfMeas.postfitRatios(leastSquareMeasIndicies) =
@@ -3439,7 +4054,28 @@ KFState KFState::getSubState(vector<KF> types, KFMeas* meas_ptr) const
     {
         auto& meas = *meas_ptr;
 
-        meas.H = meas.H(all, indices);
+        // renumber the columns of the compressed design matrix rather than rebuild it
+        vector<int> newIndices(meas.H.cols(), -1);
+        for (int i = 0; i < indices.size(); i++)
+        {
+            newIndices[indices[i]] = i;
+        }
+
+        vector<Triplet<double>> triplets;
+        triplets.reserve(meas.H.nonZeros());
+
+        for (int row = 0; row < meas.H.outerSize(); row++)
+            for (DesignMatrix::InnerIterator it(meas.H, row); it; ++it)
+            {
+                int newIndex = newIndices[it.col()];
+                if (newIndex >= 0)
+                {
+                    triplets.push_back({row, newIndex, it.value()});
+                }
+            }
+
+        meas.H.resize(meas.H.rows(), indices.size());
+        meas.H.setFromTriplets(triplets.begin(), triplets.end());
     }
 
     return subState;
@@ -3720,7 +4356,7 @@ void KFState::outputMeasurements(Trace& trace, KFMeas& meas)
 
         for (int j = 1; j < meas.H.cols(); j++)
         {
-            double a = meas.H(i, j);
+            double a = meas.H.coeff(i, j);
 
             if (fabs(a) > 0.001)
                 tracepdeex(2, trace, "%6.2f ", a);
@@ -244,21 +244,83 @@ struct ComponentsDetails
     }
 };
 
+/** Design matrix compressed by rows (CSR), each measurement references only a few states
+ */
+typedef SparseMatrix<double, Eigen::RowMajor> DesignMatrix;
+
+/** Take a design matrix from the pool of buffers kept between epochs, its storage is reused as it
+ * is refilled
+ */
+void takeFromPool(
+    DesignMatrix& matrix  ///< Matrix to replace with a pooled buffer
+);
+
+/** Return the storage of a design matrix to the pool, for reuse by the next set of measurements
+ */
+void returnToPool(
+    DesignMatrix& matrix  ///< Matrix to give up the storage of
+);
+
+/** Noise matrix of a set of measurements.
+ * The variances are kept as a vector, and the covariances between measurements, which are usually
+ * few or none, as a compressed matrix of only the off-diagonal elements
+ */
+struct NoiseMatrix
+{
+    VectorXd             variances;    ///< Diagonal elements of the noise matrix
+    SparseMatrix<double> covariances;  ///< Off-diagonal elements of the noise matrix
+
+    int rows() const
+    {
+        return variances.rows();
+    }
+
+    const VectorXd& diagonal() const
+    {
+        return variances;
+    }
+
+    double operator()(int row, int col) const
+    {
+        if (row == col)
+        {
+            return variances(row);
+        }
+
+        return covariances.coeff(row, col);
+    }
+
+    void setZero(int size);
+
+    NoiseMatrix& operator=(const MatrixXd& noise);
+    NoiseMatrix& operator=(const SparseMatrix<double>& noise);
+
+    SparseMatrix<double> sparse() const;
+
+    MatrixXd block(int beg, int num) const;
+
+    void scale(int index, double factor);
+
+    NoiseMatrix subset(const vector<int>& indices, int size) const;
+
+    void setSubset(const vector<int>& indices, const NoiseMatrix& subset);
+};
+
 /** Object to hold measurements, design matrices, and residuals for multiple observations
  */
 struct KFMeas
 {
-    GTime    time = GTime::noTime();  ///< Epoch these measurements were recorded
-    VectorXd Y;                       ///< Value of the observations (for linear systems)
-    VectorXd V;                  ///< Prefit Residual of the observations (for non-linear systems)
-    VectorXd VV;                 ///< Postfit Residual of the observations (for non-linear systems)
-    VectorXd W;                  ///< Weight (inverse of noise) used in least squares
-    MatrixXd R;                  ///< Measurement noise for these observations
-    MatrixXd H;                  ///< Design matrix between measurements and state
-    MatrixXd H_star;             ///< Design matrix between measurements and noise states
-    VectorXd uncorrelatedNoise;  ///< Uncorellated noise for measurements
-    VectorXd prefitRatios;       ///< Prefit sigma check or omega test ratios of measurements
-    VectorXd postfitRatios;      ///< Postfit sigma check or omega test ratios of measurements
+    GTime        time = GTime::noTime();  ///< Epoch these measurements were recorded
+    VectorXd     Y;                       ///< Value of the observations (for linear systems)
+    VectorXd     V;       ///< Prefit Residual of the observations (for non-linear systems)
+    VectorXd     VV;      ///< Postfit Residual of the observations (for non-linear systems)
+    VectorXd     W;       ///< Weight (inverse of noise) used in least squares
+    NoiseMatrix  R;       ///< Measurement noise for these observations
+    DesignMatrix H;       ///< Design matrix between measurements and state
+    DesignMatrix H_star;  ///< Design matrix between measurements and noise states
+    VectorXd     uncorrelatedNoise;  ///< Uncorellated noise for measurements
+    VectorXd     prefitRatios;       ///< Prefit sigma check or omega test ratios of measurements
+    VectorXd     postfitRatios;      ///< Postfit sigma check or omega test ratios of measurements
 
     map<KFKey, int> noiseIndexMap;  ///< Map from key to indexes of parameters in the noise vector
     vector<KFKey>
@@ -270,6 +332,17 @@ struct KFMeas
 
     };
 
+    KFMeas(const KFMeas&)            = default;
+    KFMeas(KFMeas&&)                 = default;
+    KFMeas& operator=(const KFMeas&) = default;
+    KFMeas& operator=(KFMeas&&)      = default;
+
+    ~KFMeas()
+    {
+        returnToPool(H);
+        returnToPool(H_star);
+    }
+
     KFMeas(
         KFMeas&                      kfMeas,       ///< Measurement to form linear combination from
         vector<Triplet<double>>&&    triplets,     ///< Linear combination triplets
@@ -287,7 +360,8 @@ struct KFMeas
         V  = F * kfMeas.V;
         VV = V;
         //		W					= F *	kfMeas.W;
-        R                 = F * kfMeas.R * F.transpose();
+        R = SparseMatrix<double>(F * kfMeas.R.sparse() * F.transpose());
+
         H                 = F * kfMeas.H;
         H_star            = F * kfMeas.H_star;
         uncorrelatedNoise = kfMeas.uncorrelatedNoise;
@@ -315,6 +389,8 @@ struct KFMeas
 
     int getNoiseIndex(const KFKey& key) const;
 
+    DesignMatrix designBlock(int begH, int numH, int begX, int numX) const;
+
     template <class ARCHIVE>
     void serialize(ARCHIVE& ar, const unsigned int& version)
     {
@@ -333,12 +409,11 @@ struct KFMeas
             ar & VV;
 
             for (int i = 0; i < rows; i++)
-                for (int j = 0; j < cols; j++)
+                for (DesignMatrix::InnerIterator it(H, i); it; ++it)
                 {
-                    double value = H(i, j);
-                    if (value)
+                    if (it.value())
                     {
-                        H2[{i, j}] = value;
+                        H2[{i, (int)it.col()}] = it.value();
                     }
                 }
 
@@ -354,14 +429,18 @@ struct KFMeas
             ar & VV;
             ar & H2;
 
-            H = MatrixXd::Zero(rows, cols);
-            R = MatrixXd::Zero(rows, rows);
-            V = VectorXd::Zero(rows);
-
+            vector<Triplet<double>> triplets;
+            triplets.reserve(H2.size());
             for (auto& [index, value] : H2)
             {
-                H(index.first, index.second) = value;
+                triplets.push_back({index.first, index.second, value});
             }
+
+            H.resize(rows, cols);
+            H.setFromTriplets(triplets.begin(), triplets.end());
+
+            R.setZero(rows);
+            V = VectorXd::Zero(rows);
         }
     }
 };
@@ -694,7 +773,13 @@ struct KFState : KFState_
         int       numH = -1
     );
 
-    bool leastSquare(Trace& trace, KFMeas& kfMeas, VectorXd& xp, MatrixXd& Pp);
+    bool leastSquare(
+        Trace&    trace,
+        KFMeas&   kfMeas,
+        VectorXd& xp,
+        VectorXd& variances,
+        MatrixXd* Pp_ptr = nullptr
+    );
 
     void chiQC(Trace& trace, KFMeas& kfMeas);
 
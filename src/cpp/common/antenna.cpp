@@ -307,6 +307,100 @@ antPco(string id, E_Sys sys, E_FType ft, GTime time, double& var, E_Radio radio,
         return pco.recPco;
 }
 
+/** Copy the azimuth dependent pcv values into a contiguous grid for interpolation
+ */
+void PhaseCenterData::buildGrid()
+{
+    azElGrid.clear();
+
+    if (naz == 0 || (int)azElMap.size() != naz)
+    {
+        return;
+    }
+
+    azElGrid.reserve(naz * nz);
+
+    for (auto& [azIndex, zenValues] : azElMap)
+    {
+        if ((int)zenValues.size() != nz)
+        {
+            azElGrid.clear();
+            return;
+        }
+
+        azElGrid.insert(azElGrid.end(), zenValues.begin(), zenValues.end());
+    }
+}
+
+/** Interpolate the pcv at an azimuth and zenith angle in the antenna frame
+ */
+double PhaseCenterData::interpolate(
+    double az,  ///< Azimuth (degree)
+    double zen  ///< Zenith angle (degree)
+) const
+{
+    if (nz < 2 || (int)elMap.size() < nz)
+    {
+        return 0;
+    }
+
+    /* select zenith angle range */
+    int zen_n = fmin(fmax(ceil((zen - zenStart) / zenDelta), 1), nz - 1);
+
+    double xz1 = zenStart + zenDelta * (zen_n - 1);
+    double xz2 = zenStart + zenDelta * (zen_n);
+
+    if (naz == 0 || az == 0 || azElGrid.empty())
+    {
+        // linear interpolate receiver pcv - non azimuth-dependent
+
+        double yz1 = elMap[zen_n - 1];  // lower bound
+        double yz2 = elMap[zen_n];      // upper bound
+        return interp(xz1, xz2, yz1, yz2, zen);
+    }
+
+    // bilinear interpolate receiver pcv - azimuth-dependent
+
+    // select azimuth angle range */
+    int az_n = fmin(fmax(ceil(az / aziDelta), 1), naz - 1);
+
+    double xa1 = aziDelta * (az_n - 1);
+    double xa2 = aziDelta * (az_n);
+
+    const double* row1 = &azElGrid[(az_n - 1) * nz];
+    const double* row2 = &azElGrid[(az_n) * nz];
+
+    // linear interpolation along zenith angle
+    double ya1 = interp(xz1, xz2, row1[zen_n - 1], row1[zen_n], zen);
+    double ya2 = interp(xz1, xz2, row2[zen_n - 1], row2[zen_n], zen);
+
+    // linear interpolation along azimuth angle
+    return interp(xa1, xa2, ya1, ya2, az);
+}
+
+/** Get the azimuth and zenith angles of a look vector in the antenna frame
+ */
+void antLookAngles(
+    const AttStatus& attStatus,  ///< Orientation of antenna
+    VectorEcef       e,          ///< Line of sight vector
+    double&          az,         ///< Antenna frame azimuth in degrees
+    double&          zen         ///< Antenna frame zenith in degrees
+)
+{
+    // Rotate relative look vector into local frame, (the transpose of the antenna basis matrix)
+    Vector3d localLook;
+    localLook(0) = attStatus.eXAnt.dot(e);
+    localLook(1) = attStatus.eYAnt.dot(e);
+    localLook(2) = attStatus.eZAnt.dot(e);
+
+    az  = atan2(localLook(0), localLook(1));
+    zen = acos(localLook.z()) * R2D;
+
+    wrap2Pi(az);
+
+    az *= R2D;
+}
+
 /** find and interpolate antenna pcv
  */
 double antPcv(
@@ -325,17 +419,9 @@ double antPcv(
         return 0;
     }
 
-    // Rotate relative look vector into local frame
-    Matrix3d ant2Ecef = rotBasisMat(attStatus.eXAnt, attStatus.eYAnt, attStatus.eZAnt);
-
-    Vector3d localLook = ant2Ecef.transpose() * e;
-
-    double az  = atan2(localLook(0), localLook(1));
-    double zen = acos(localLook.z()) * R2D;
-
-    wrap2Pi(az);
-
-    az *= R2D;
+    double az;
+    double zen;
+    antLookAngles(attStatus, e, az, zen);
 
     if (az_ptr)
         *az_ptr = az;
@@ -386,73 +472,212 @@ double antPcv(
         return 0;
     }
 
-    auto& pcvMap1D = pcd.elMap;
-    auto& pcvMap2D = pcd.azElMap;
+    return pcd.interpolate(az, zen);
+}
 
-    int    nz   = pcd.nz;
-    int    naz  = pcd.naz;
-    double zen1 = pcd.zenStart;
-    double dzen = pcd.zenDelta;
-    double dazi = pcd.aziDelta;
+/** Check if the handle holds the models for an antenna and system at a time
+ */
+bool PcvHandle::isBound(const string& id, E_Sys sys, GTime time) const
+{
+    if (bound == false || id != this->id || sys != this->sys)
+    {
+        return false;
+    }
 
-    /* select zenith angle range */
-    int zen_n;
-    for (zen_n = 1; zen_n < nz - 1; zen_n++)
+    if (hasFrom && time < validFrom)
     {
-        if ((zen1 + dzen * zen_n) >= zen)
-        {
-            break;
-        }
+        return false;
     }
 
-    double xz1 = zen1 + dzen * (zen_n - 1);
-    double xz2 = zen1 + dzen * (zen_n);
+    if (hasUntil && time >= validUntil)
+    {
+        return false;
+    }
 
-    double pcv;
+    return true;
+}
 
-    if (naz == 0 || az == 0)
+/** Resolve the models of all frequencies of an antenna and system at a time, if not already bound
+ */
+void PcvHandle::bind(
+    const string& id,    ///< antenna id
+    E_Sys         sys,   ///< satellite system
+    GTime         time   ///< time
+)
+{
+    if (isBound(id, sys, time))
     {
-        // linear interpolate receiver pcv - non azimuth-dependent
+        return;
+    }
+
+    this->id  = id;
+    this->sys = sys;
+    bound     = true;
+    hasFrom   = false;
+    hasUntil  = false;
+    pcdArr.fill(nullptr);
+
+    auto limitFrom = [&](GTime from)
+    {
+        if (hasFrom == false || from > validFrom)
+            validFrom = from;
+        hasFrom = true;
+    };
 
-        double yz1 = pcvMap1D[zen_n - 1];  // lower bound
-        double yz2 = pcvMap1D[zen_n];      // upper bound
-        pcv        = interp(xz1, xz2, yz1, yz2, zen);
+    auto limitUntil = [&](GTime until)
+    {
+        if (hasUntil == false || until < validUntil)
+            validUntil = until;
+        hasUntil = true;
+    };
+
+    if (id.empty())
+    {
+        return;
     }
-    else
+
+    auto it0 = nav.pcvMap.find(id);
+    if (it0 == nav.pcvMap.end())
+    {
+        BOOST_LOG_TRIVIAL(warning) << "No PCV found for '" << id << "'";
+        return;
+    }
+
+    auto& [dummy0, pcvSysFreqMap] = *it0;
+
+    auto it1 = pcvSysFreqMap.find(sys);
+    if (it1 == pcvSysFreqMap.end())
     {
-        // bilinear interpolate receiver pcv - azimuth-dependent
+        BOOST_LOG_TRIVIAL(warning) << "No PCV found for " << id << " for " << sys;
+        return;
+    }
+
+    auto& [dummy1, pcvFreqMap] = *it1;
 
-        // select azimuth angle range */
-        int az_n;
-        for (az_n = 1; az_n < naz; az_n++)
+    for (auto& [ft, pcvTimeMap] : pcvFreqMap)
+    {
+        if (ft < 0 || ft >= NUM_FTYPES || pcvTimeMap.empty())
         {
-            if ((dazi * az_n) >= az)
-            {
-                break;
-            }
+            continue;
+        }
+
+        // time maps are sorted newest first
+        auto it3 = pcvTimeMap.lower_bound(time);
+        if (it3 == pcvTimeMap.end())
+        {
+            auto& [oldestTime, oldestPcd] = *pcvTimeMap.rbegin();
+
+            limitUntil(oldestTime);
+            continue;
+        }
+
+        auto& [pcdTime, pcd] = *it3;
+
+        limitFrom(pcdTime);
+
+        if (it3 != pcvTimeMap.begin())
+        {
+            auto& [nextTime, nextPcd] = *std::prev(it3);
+
+            limitUntil(nextTime);
         }
-        if (az_n == naz)
+
+        if (pcd.validUntil != GTime::noTime())
         {
-            az_n = 0;
+            if (time > pcd.validUntil)
+            {
+                continue;
+            }
+
+            limitUntil(pcd.validUntil);
         }
 
-        double xa1 = dazi * (az_n - 1);
-        double xa2 = dazi * (az_n);
+        pcdArr[ft] = &pcd;
+    }
+}
+
+/** Interpolate the pcv of a frequency from the bound models, at angles in the antenna frame
+ */
+double PcvHandle::interpolate(
+    E_FType ft,   ///< frequency
+    double  az,   ///< Antenna frame azimuth in degrees
+    double  zen   ///< Antenna frame zenith in degrees
+) const
+{
+    const PhaseCenterData* pcd_ptr = nullptr;
+    if (ft >= 0 && ft < NUM_FTYPES)
+    {
+        pcd_ptr = pcdArr[ft];
+    }
+
+    if (pcd_ptr == nullptr)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "No PCV found for " << id << " for " << sys << " L" << ft;
+        return 0;
+    }
+
+    return pcd_ptr->interpolate(az, zen);
+}
+
+/** Interpolate the pcv of a single frequency from the bound models
+ */
+double PcvHandle::evaluate(
+    const AttStatus& attStatus,  ///< Orientation of antenna
+    VectorEcef       e,          ///< Line of sight vector
+    E_FType          ft,         ///< frequency
+    double*          az_ptr,     ///< Optional pointer to output antenna frame azimuth in degrees
+    double*          zen_ptr     ///< Optional pointer to output antenna frame zenith in degrees
+) const
+{
+    if (id.empty())
+    {
+        return 0;
+    }
+
+    double az;
+    double zen;
+    antLookAngles(attStatus, e, az, zen);
 
-        double yz3 = pcvMap2D[az_n - 1][zen_n - 1];
-        double yz1 = pcvMap2D[az_n - 1][zen_n];
-        double yz4 = pcvMap2D[az_n][zen_n - 1];
-        double yz2 = pcvMap2D[az_n][zen_n];
+    if (az_ptr)
+        *az_ptr = az;
+    if (zen_ptr)
+        *zen_ptr = zen;
+
+    return interpolate(ft, az, zen);
+}
 
-        // linear interpolation along zenith angle
-        double ya1 = interp(xz1, xz2, yz3, yz1, zen);
-        double ya2 = interp(xz1, xz2, yz4, yz2, zen);
+/** Interpolate the pcvs of a set of frequencies from the bound models, using a single rotation of
+ * the look vector into the antenna frame for all of them
+ */
+void PcvHandle::evaluate(
+    const AttStatus&       attStatus,  ///< Orientation of antenna
+    VectorEcef             e,          ///< Line of sight vector
+    const vector<E_FType>& fts,        ///< Frequencies to evaluate
+    vector<double>&        pcvs,       ///< Output pcvs, parallel to fts, zero if unavailable
+    double*                az_ptr,     ///< Optional pointer to output antenna frame azimuth in degrees
+    double*                zen_ptr     ///< Optional pointer to output antenna frame zenith in degrees
+) const
+{
+    pcvs.assign(fts.size(), 0);
 
-        // linear interpolation along azimuth angle
-        pcv = interp(xa1, xa2, ya1, ya2, az);
+    if (id.empty())
+    {
+        return;
     }
 
-    return pcv;
+    double az;
+    double zen;
+    antLookAngles(attStatus, e, az, zen);
+
+    if (az_ptr)
+        *az_ptr = az;
+    if (zen_ptr)
+        *zen_ptr = zen;
+
+    for (int i = 0; i < fts.size(); i++)
+    {
+        pcvs[i] = interpolate(fts[i], az, zen);
+    }
 }
 
 /**Change the last four characters of antenna type to NONE
@@ -754,6 +979,8 @@ void readantexf(string filepath, Navigation& nav)
             pcv.validUntil = validUntil;
             pco.validUntil = validUntil;
 
+            pcv.buildGrid();
+
             if (id.size() <= 3)  // filters out non-PRNS e.g. "3S-02-TSADM     NONE"
             {
                 nav.svnMap[SatSys(id.c_str())][validFrom] = recPcv.svn;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <map>
 #include <string>
 #include <vector>
@@ -10,6 +11,7 @@
 #include "common/satStat.hpp"
 #include "common/trace.hpp"
 
+using std::array;
 using std::map;
 using std::string;
 using std::vector;
@@ -25,6 +27,12 @@ struct PhaseCenterData : AzElMapData<double>
 
     GTime validFrom;
     GTime validUntil;
+
+    vector<double> azElGrid;  ///< Contiguous copy of azElMap, as [azIndex * nz + zenIndex]
+
+    void buildGrid();
+
+    double interpolate(double az, double zen) const;
 };
 
 struct PhaseCenterOffset
@@ -41,6 +49,46 @@ struct SatSys;
 struct AttStatus;
 struct Navigation;
 
+/** Antenna pcv models of all frequencies for one antenna and system, resolved for a period of
+ * validity so that repeated evaluations skip the antenna, system, frequency and time lookups.
+ * Rebinding is only performed when the requested time leaves the period of validity.
+ */
+struct PcvHandle
+{
+    string id;                                 ///< Antenna id the models were bound for
+    E_Sys  sys        = E_Sys::NONE;           ///< System the models were bound for
+    bool   bound      = false;                 ///< Models have been bound
+    bool   hasFrom    = false;                 ///< Period of validity has a start
+    bool   hasUntil   = false;                 ///< Period of validity has an end
+    GTime  validFrom  = GTime::noTime();       ///< Start of the period of validity
+    GTime  validUntil = GTime::noTime();       ///< End of the period of validity (exclusive)
+
+    array<const PhaseCenterData*, NUM_FTYPES> pcdArr = {};  ///< Models by frequency, null if unavailable
+
+    bool isBound(const string& id, E_Sys sys, GTime time) const;
+
+    void bind(const string& id, E_Sys sys, GTime time);
+
+    double interpolate(E_FType ft, double az, double zen) const;
+
+    double evaluate(
+        const AttStatus& attStatus,
+        VectorEcef       e,
+        E_FType          ft,
+        double*          az_ptr  = nullptr,
+        double*          zen_ptr = nullptr
+    ) const;
+
+    void evaluate(
+        const AttStatus&       attStatus,
+        VectorEcef             e,
+        const vector<E_FType>& fts,
+        vector<double>&        pcvs,
+        double*                az_ptr  = nullptr,
+        double*                zen_ptr = nullptr
+    ) const;
+};
+
 VectorEcef
 satAntOff(Trace& trace, GTime time, AttStatus& attStatus, SatSys& Sat, map<int, double>& lamMap);
 
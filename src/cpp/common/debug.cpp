@@ -1,10 +1,12 @@
 #pragma GCC optimize("O0")
 
 #include "common/debug.hpp"
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <random>
 #include "3rdparty/iers2010/iers2010.hpp"
+#include "ambres/GNSSambres.hpp"
 #include "common/acsConfig.hpp"
 #include "common/algebra.hpp"
 #include "common/algebraTrace.hpp"
@@ -25,6 +27,7 @@
 #include "common/streamFile.hpp"
 #include "common/streamObs.hpp"
 #include "common/streamParser.hpp"
+#include "common/streamRinex.hpp"
 #include "common/streamRtcm.hpp"
 #include "common/streamSerial.hpp"
 #include "common/streamUbx.hpp"
@@ -36,6 +39,7 @@
 #include "orbprop/orbitProp.hpp"
 #include "orbprop/planets.hpp"
 #include "pea/minimumConstraints.hpp"
+#include "pea/ppp.hpp"
 
 using iers2010::hisp::ntin;
 
@@ -301,7 +305,7 @@ void outputMeas(
 	{
 		tracepdeex(2, trace, "*\t%19s\t%15.4f\t%15.9f", time.to_string(0).c_str(), meas.Y(i), meas.R(i, i));
 
-		for (int j = 0; j < meas.H.cols(); j++)		tracepdeex(2, trace, "\t%15.5f", meas.H(i, j));
+		for (int j = 0; j < meas.H.cols(); j++)		tracepdeex(2, trace, "\t%15.5f", meas.H.coeff(i, j));
 		tracepdeex(2, trace, "\n");
 	}
 	trace << "-MEAS" << "\n";
@@ -1317,6 +1321,470 @@ void debugAttitude()
     }
 }
 
+/** Compare the interpolated third body positions against direct evaluation of the JPL ephemeris
+ */
+void debugPlanetCache()
+{
+    std::cout << "\nDebugging third body interpolation:" << "\n";
+
+    GEpoch ep        = {2023, 1, 1, 0, 0, 0};
+    GTime  startTime = epoch2time(ep.data());
+
+    for (auto body : {E_ThirdBody::SUN, E_ThirdBody::MOON, E_ThirdBody::JUPITER})
+    {
+        double maxPosDiff     = 0;
+        double maxVelDiff     = 0;
+        double maxEcefPosDiff = 0;
+
+        for (double dt = 0; dt < 3 * 86400; dt += 317.3)
+        {
+            GTime time = startTime + dt;
+
+            VectorEci rDirect;
+            VectorEci vDirect;
+            bool      pass = jplEphPos(nav.jplEph_ptr, time, body, rDirect, &vDirect);
+            if (pass == false)
+            {
+                std::cout << "\tNo JPL ephemeris available" << "\n";
+                return;
+            }
+
+            VectorEci rCached;
+            VectorEci vCached;
+            planetPosEci(time, body, rCached, &vCached);
+
+            FrameSwapper frameSwapper(time, ERPValues{});
+
+            VectorEcef rEcefDirect = frameSwapper(rDirect);
+            VectorEcef rEcefCached;
+            planetPosEcef(time, body, rEcefCached);
+
+            maxPosDiff     = std::max(maxPosDiff, (rCached - rDirect).norm());
+            maxVelDiff     = std::max(maxVelDiff, (vCached - vDirect).norm());
+            maxEcefPosDiff = std::max(maxEcefPosDiff, (rEcefCached - rEcefDirect).norm());
+        }
+
+        std::cout << std::setprecision(6) << std::scientific << "\t" << body
+                  << "\tmax pos diff: " << maxPosDiff << "\tmax vel diff: " << maxVelDiff
+                  << "\tmax ecef pos diff: " << maxEcefPosDiff << "\n";
+    }
+}
+
+void debugFrameInterpolation()
+{
+    std::cout << "\nDebugging frame rotation interpolation:" << "\n";
+
+    GEpoch ep        = {2023, 1, 1, 0, 0, 0};
+    GTime  startTime = epoch2time(ep.data());
+
+    double maxAngleDiff = 0;
+    double maxRateDiff  = 0;
+
+    for (double dt = 0; dt < 3 * 86400; dt += 317.3)
+    {
+        GTime     time = startTime + dt;
+        ERPValues erpv = getErp(nav.erp, time);
+
+        Matrix3d U;
+        Matrix3d dU;
+        eci2ecef(time, erpv, U, &dU);
+
+        Matrix3d Ui;
+        Matrix3d dUi;
+        eci2ecefInterpolated(time, erpv, Ui, &dUi);
+
+        Eigen::AngleAxisd diff(Ui * U.transpose());
+
+        maxAngleDiff = std::max(maxAngleDiff, diff.angle());
+        maxRateDiff  = std::max(maxRateDiff, (dUi - dU).norm());
+    }
+
+    std::cout << std::setprecision(6) << std::scientific
+              << "\tmax angle diff (uas): " << maxAngleDiff / AS2R * 1e6
+              << "\tmax rate diff: " << maxRateDiff << "\n";
+}
+
+/** Check that the batched geometry free and Melbourne-Wubbena slip detection matches the
+ * individual detectors, using synthetic combinations with occasional jumps
+ */
+void debugSlipDetection()
+{
+    std::cout << "\nDebugging batched slip detection:" << "\n";
+
+    E_FType frq1;
+    E_FType frq2;
+    E_FType frq3;
+    bool    pass = satFreqs(E_Sys::GPS, frq1, frq2, frq3);
+    if (pass == false)
+    {
+        std::cout << "\tNo GPS code priorities configured" << "\n";
+        return;
+    }
+
+    const int numSats = 32;
+
+    map<SatSys, SatStat> refStatMap;
+    map<SatSys, SatStat> batchStatMap;
+    SlipDetector         slipDetector;
+
+    std::mt19937                     gen(1);
+    std::normal_distribution<double> noise(0, 0.01);
+    std::uniform_real_distribution<> uniform(0, 1);
+
+    int mismatches = 0;
+    int slips      = 0;
+
+    GTime time = epoch2time(GEpoch{2023, 1, 1, 0, 0, 0}.data());
+
+    for (int epoch = 0; epoch < 500; epoch++)
+    {
+        ObsList refList;
+        ObsList batchList;
+
+        for (int prn = 1; prn <= numSats; prn++)
+        {
+            SatSys Sat(E_Sys::GPS, prn);
+
+            // occasionally missing, invalid, or jumping
+            if (uniform(gen) < 0.05)
+                continue;
+
+            S_LC lc      = {};
+            lc.valid     = uniform(gen) > 0.02;
+            lc.GF_Phas_m = prn + noise(gen) + (uniform(gen) < 0.03 ? 1 : 0);
+            lc.MW_c      = prn + noise(gen) + (uniform(gen) < 0.03 ? 20 : 0);
+            if (uniform(gen) < 0.02)
+                lc.GF_Phas_m = 0;
+
+            for (auto [statMap_ptr, list_ptr] :
+                 {std::make_pair(&refStatMap, &refList), std::make_pair(&batchStatMap, &batchList)})
+            {
+                auto& satStat = (*statMap_ptr)[Sat];
+                satStat.lc_new.lcMap[{frq1, frq2}] = lc;
+
+                for (auto& sigStat : satStat.sigStats)
+                    sigStat.slip.any = 0;
+
+                auto obs_ptr         = std::make_shared<GObs>();
+                obs_ptr->Sat         = Sat;
+                obs_ptr->time        = time;
+                obs_ptr->satStat_ptr = &satStat;
+
+                list_ptr->push_back(obs_ptr);
+            }
+        }
+
+        detslp_gf(nullStream, refList);
+        detslp_mw(nullStream, refList);
+        detslp_gf_mw(nullStream, batchList, slipDetector);
+
+        for (auto& [Sat, refStat] : refStatMap)
+        {
+            auto& batchStat = batchStatMap[Sat];
+
+            if (refStat.gf != batchStat.gf || refStat.mw != batchStat.mw ||
+                refStat.sigStats.size() != batchStat.sigStats.size())
+            {
+                mismatches++;
+                continue;
+            }
+
+            for (int ft = 0; ft < NUM_FTYPES; ft++)
+            {
+                SigStat* refSig_ptr   = refStat.sigStats.find((E_FType)ft);
+                SigStat* batchSig_ptr = batchStat.sigStats.find((E_FType)ft);
+
+                if (refSig_ptr == nullptr && batchSig_ptr == nullptr)
+                    continue;
+
+                if (refSig_ptr == nullptr || batchSig_ptr == nullptr ||
+                    refSig_ptr->slip.any != batchSig_ptr->slip.any ||
+                    refSig_ptr->savedSlip.any != batchSig_ptr->savedSlip.any)
+                {
+                    mismatches++;
+                    continue;
+                }
+
+                if (refSig_ptr->slip.any)
+                    slips++;
+            }
+        }
+
+        time += 30;
+    }
+
+    std::cout << "\tslips: " << slips << "\tmismatches: " << mismatches << "\n";
+}
+
+/** Compare the time taken to resolve ambiguities as a single set and partitioned by receiver,
+ * for increasing numbers of ambiguities with per-receiver correlated synthetic covariances
+ */
+void debugAmbiguityPartition()
+{
+    std::cout << "\nDebugging partitioned ambiguity resolution:" << "\n";
+
+    const int ambsPerRec = 12;
+
+    std::mt19937                     gen(1);
+    std::normal_distribution<double> noise(0, 1);
+
+    for (int numRecs : {1, 4, 16, 64})
+    {
+        int namb = numRecs * ambsPerRec;
+
+        GinAR_mtx mtrx;
+        mtrx.aflt  = VectorXd::Zero(namb);
+        mtrx.Paflt = MatrixXd::Zero(namb, namb);
+
+        for (int r = 0; r < numRecs; r++)
+        {
+            MatrixXd A(ambsPerRec, ambsPerRec);
+            for (int i = 0; i < ambsPerRec; i++)
+                for (int j = 0; j < ambsPerRec; j++)
+                    A(i, j) = noise(gen);
+
+            int begin = r * ambsPerRec;
+
+            mtrx.Paflt.block(begin, begin, ambsPerRec, ambsPerRec) =
+                1e-4 * A * A.transpose() + 1e-4 * MatrixXd::Identity(ambsPerRec, ambsPerRec);
+
+            for (int i = 0; i < ambsPerRec; i++)
+            {
+                KFKey key;
+                key.type = KF::AMBIGUITY;
+                key.str  = "REC" + std::to_string(r);
+                key.num  = i;
+
+                mtrx.ambmap[begin + i] = key;
+                mtrx.aflt(begin + i)   = round(100 * noise(gen)) + 0.01 * noise(gen);
+            }
+        }
+
+        GinAR_opt opt;
+        opt.mode = E_ARmode::LAMBDA;
+
+        GinAR_mtx wholeMtrx = mtrx;
+        auto      start     = std::chrono::steady_clock::now();
+        int       wholeFix  = GNSS_AR(nullStream, wholeMtrx, opt);
+        auto      middle    = std::chrono::steady_clock::now();
+
+        GinAR_mtx partMtrx = mtrx;
+        opt.partition      = E_ARPartition::RECEIVER;
+        int partFix        = GNSS_AR(nullStream, partMtrx, opt);
+        auto stop          = std::chrono::steady_clock::now();
+
+        // compare the fixed ambiguities implied by each solution, where both fixed all of them
+        double maxDiff = 0;
+        if (wholeFix == namb && partFix == namb)
+        {
+            VectorXd wholeAmbs = wholeMtrx.Ztrs.fullPivLu().solve(wholeMtrx.zfix);
+            VectorXd partAmbs  = partMtrx.Ztrs.fullPivLu().solve(partMtrx.zfix);
+
+            maxDiff = (wholeAmbs - partAmbs).cwiseAbs().maxCoeff();
+        }
+
+        std::chrono::duration<double, std::milli> wholeTime = middle - start;
+        std::chrono::duration<double, std::milli> partTime  = stop - middle;
+
+        std::cout << std::setprecision(3) << std::fixed << "\tambiguities: " << namb
+                  << "\twhole: " << wholeFix << " fixed in " << wholeTime.count() << "ms"
+                  << "\tpartitioned: " << partFix << " fixed in " << partTime.count() << "ms"
+                  << "\tmax diff: " << maxDiff << "\n";
+    }
+}
+
+/** Compare the exclusions of raim() with those of raimExhaustive() for the current epoch of a
+ * receiver, accumulating the number of mismatching epochs
+ */
+void debugRaim(
+    Trace&    trace,       ///< Trace file to output to
+    Receiver& rec,         ///< Receiver whose observations have had satellite positions computed
+    KFState*  kfState_ptr  ///< Optional kfstate pointer to retrieve ppp values from
+)
+{
+    static int epochs     = 0;
+    static int mismatches = 0;
+
+    map<SatSys, SatStat> origSatStats;
+    for (auto& obs : only<GObs>(rec.obsList))
+        origSatStats[obs.Sat] = *obs.satStat_ptr;
+
+    auto runRaim = [&](bool exhaustive, Solution& sol, set<SatSys>& excluded)
+    {
+        ObsList obsList;
+        int     numMeas = 0;
+        for (auto& obs : only<GObs>(rec.obsList))
+        {
+            auto obs_ptr            = (shared_ptr<GObs>)obs;
+            obs_ptr->excludeOutlier = false;
+            obsList.push_back(obs_ptr);
+
+            if (obs.exclude == false)
+                numMeas++;
+        }
+
+        sol                     = rec.sol;
+        sol.status              = E_Solution::SINGLE_X;
+        sol.sppState.dof        = numMeas - (sol.sppState.x.rows() - 1);
+        sol.sppState.chi2PerDof = INFINITY;
+
+        bool pass;
+        if (exhaustive)
+            pass = raimExhaustive(trace, obsList, sol, rec.id, kfState_ptr);
+        else
+            pass = raim(trace, obsList, sol, rec.id, kfState_ptr, nullptr);
+
+        for (auto& obs : only<GObs>(obsList))
+        {
+            if (obs.excludeOutlier)
+                excluded.insert(obs.Sat);
+
+            *obs.satStat_ptr = origSatStats[obs.Sat];
+        }
+
+        return pass;
+    };
+
+    Solution    exhaustiveSol;
+    Solution    raimSol;
+    set<SatSys> exhaustiveExcluded;
+    set<SatSys> raimExcluded;
+
+    bool exhaustivePass = runRaim(true, exhaustiveSol, exhaustiveExcluded);
+    bool raimPass       = runRaim(false, raimSol, raimExcluded);
+
+    epochs++;
+
+    if (exhaustivePass != raimPass || exhaustiveSol.status != raimSol.status ||
+        exhaustiveExcluded != raimExcluded ||
+        (exhaustiveSol.sppPos - raimSol.sppPos).norm() > 1e-3)
+    {
+        mismatches++;
+
+        std::cout << "\t" << rec.id << " " << tsync << " RAIM mismatch, exhaustive excluded:";
+        for (auto& Sat : exhaustiveExcluded)
+            std::cout << " " << Sat.id();
+        std::cout << ", raim excluded:";
+        for (auto& Sat : raimExcluded)
+            std::cout << " " << Sat.id();
+        std::cout << "\n";
+    }
+
+    std::cout << "\tepochs: " << epochs << "\tmismatches: " << mismatches << "\n";
+}
+
+/** Parse a rinex observation file as text while writing its observation cache, then again from
+ * the cache, comparing the throughput of each and checking that the observations round-trip
+ */
+void debugObsCache(
+    string rinexFile  ///< Rinex observation file to parse
+)
+{
+    std::cout << "\nDebugging observation cache of " << rinexFile << ":" << "\n";
+
+    string cachePath = rinexFile + ".debugcache";
+    std::remove(cachePath.c_str());
+
+    vector<ObsList> obsLists[2];
+    double          seconds[2];
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::ifstream inputStream(rinexFile);
+        if (!inputStream)
+        {
+            std::cout << "\tCould not open " << rinexFile << "\n";
+            return;
+        }
+
+        RinexParser rinexParser;
+        rinexParser.sourcePath      = rinexFile;
+        rinexParser.cachePath       = cachePath;
+        rinexParser.lookaheadEpochs = std::numeric_limits<int>::max();
+
+        rinexParser.parse(inputStream);
+
+        if (rinexParser.version <= 2.99)
+        {
+            std::cout << "\tOnly rinex 3+ observation files are cached" << "\n";
+            return;
+        }
+
+        for (auto& obsList : rinexParser.obsListList)
+            obsLists[pass].push_back(std::move(obsList));
+
+        seconds[pass] = rinexParser.parseSeconds;
+
+        std::cout << "\t" << (pass ? "cache: " : "rinex: ") << obsLists[pass].size()
+                  << " epochs in " << seconds[pass] << "s ("
+                  << obsLists[pass].size() / std::max(seconds[pass], 1e-9) << " epochs/s)\n";
+    }
+
+    std::remove(cachePath.c_str());
+
+    auto& [textLists, cacheLists] = obsLists;
+
+    int mismatches = 0;
+
+    if (textLists.size() != cacheLists.size())
+    {
+        mismatches++;
+    }
+
+    for (int i = 0; i < std::min(textLists.size(), cacheLists.size()); i++)
+    {
+        vector<GObs*> textObs;
+        vector<GObs*> cacheObs;
+        for (auto& obs : only<GObs>(textLists[i]))
+            textObs.push_back(&obs);
+        for (auto& obs : only<GObs>(cacheLists[i]))
+            cacheObs.push_back(&obs);
+
+        if (textObs.size() != cacheObs.size())
+        {
+            mismatches++;
+            continue;
+        }
+
+        for (int j = 0; j < textObs.size(); j++)
+        {
+            GObs& a = *textObs[j];
+            GObs& b = *cacheObs[j];
+
+            if (a.Sat != b.Sat || a.time != b.time || a.sigsLists.size() != b.sigsLists.size())
+            {
+                mismatches++;
+                continue;
+            }
+
+            for (auto& [ft, sigList] : a.sigsLists)
+            {
+                auto it = b.sigsLists.find(ft);
+                if (it == b.sigsLists.end() || it->second.size() != sigList.size())
+                {
+                    mismatches++;
+                    continue;
+                }
+
+                auto sigB = it->second.begin();
+                for (auto& sigA : sigList)
+                {
+                    if (sigA.code != sigB->code || sigA.L != sigB->L || sigA.P != sigB->P ||
+                        sigA.D != sigB->D || sigA.LLI != sigB->LLI || sigA.snr != sigB->snr)
+                    {
+                        mismatches++;
+                    }
+
+                    sigB++;
+                }
+            }
+        }
+    }
+
+    std::cout << "\tspeedup: " << seconds[0] / std::max(seconds[1], 1e-9)
+              << "\tmismatches: " << mismatches << "\n";
+}
+
 struct Thing
 {
 };
@@ -695,6 +695,13 @@ enum class E_ARmode : short int
     LAMBDA_BIE
 };
 
+enum class E_ARPartition : short int
+{
+    NONE,        ///< Resolve all ambiguities together
+    RECEIVER,    ///< Resolve the ambiguities of each receiver independently
+    CORRELATION  ///< Resolve each group of mutually correlated ambiguities independently
+};
+
 enum class E_NavRecType : short int
 {
     NONE,  ///< NONE for unknown */
@@ -98,7 +98,8 @@ EPHTYPE* selSatEphFromMap(
     SatSys                                                                    Sat,
     E_NavMsgType                                                              type,
     int&                                                                      iode,
-    map<SatSys, map<E_NavMsgType, map<GTime, EPHTYPE, std::greater<GTime>>>>& ephMap
+    map<SatSys, map<E_NavMsgType, map<GTime, EPHTYPE, std::greater<GTime>>>>& ephMap,
+    const EphIndex<EPHTYPE>&                                                  ephIndex
 )
 {
     //	trace(4,__FUNCTION__ " : time=%s sat=%2d iode=%d\n",time.to_string(3).c_str(),Sat,iode);
@@ -144,17 +145,68 @@ EPHTYPE* selSatEphFromMap(
         return nullptr;
     }
 
-    auto& satEphMap = ephMap[Sat][type];
-
-    auto it = satEphMap.lower_bound(time + tmax);
+    GTime startTime = time + tmax;
     if (acsConfig.simulate_real_time  // Ephemeris should be no later than (time - tdelay) when
                                       // simulating real-time
         ||
         iode < 0)  // Start with the last available ephemeris when iode not provided (== ANY_IODE)
     {
-        it = satEphMap.lower_bound(time - tdelay);
+        startTime = time - tdelay;
     }
 
+    auto satIndex_ptr = ephIndex.find(Sat, type);
+    if (satIndex_ptr)
+    {
+        // same search as below, but walking the flat index (newest to oldest) rather than the map
+        auto& satIndex = *satIndex_ptr;
+
+        int start = satIndex.atOrBefore(startTime.bigTime);
+
+        for (int i = start; i >= satIndex.first; i--)
+        {
+            auto& eph = *satIndex.ephs[i];
+
+            if (fabs((eph.toe - time).to_double()) > tmax)
+            {
+                break;
+            }
+
+            if (iode >= 0 && iode != eph.iode)
+            {
+                continue;
+            }
+
+            iode = eph.iode;
+            return &eph;
+        }
+
+        if (start + 1 < satIndex.size() && acsConfig.simulate_real_time == false && iode < 0)
+        {
+            auto& eph = *satIndex.ephs[start + 1];
+
+            if (fabs((eph.toe - time).to_double()) <= tmax)
+            {
+                iode = eph.iode;
+                return &eph;
+            }
+        }
+
+        tracepdeex(
+            5,
+            trace,
+            "\nno broadcast ephemeris: %s sat=%s within MAXDTOE: %f ",
+            time.to_string().c_str(),
+            Sat.id().c_str(),
+            tmax
+        );
+
+        return nullptr;
+    }
+
+    auto& satEphMap = ephMap[Sat][type];
+
+    auto it = satEphMap.lower_bound(startTime);
+
     while (it != satEphMap.end())
     {
         auto& [ephTime, eph] = *it;
@@ -204,19 +256,19 @@ EPHTYPE* selSatEphFromMap(
 template <>
 Eph* seleph<Eph>(Trace& trace, GTime time, SatSys Sat, E_NavMsgType type, int iode, Navigation& nav)
 {
-    return selSatEphFromMap(trace, time, Sat, type, iode, nav.ephMap);
+    return selSatEphFromMap(trace, time, Sat, type, iode, nav.ephMap, nav.ephIndex);
 }
 template <>
 Geph* seleph<
     Geph>(Trace& trace, GTime time, SatSys Sat, E_NavMsgType type, int iode, Navigation& nav)
 {
-    return selSatEphFromMap(trace, time, Sat, type, iode, nav.gephMap);
+    return selSatEphFromMap(trace, time, Sat, type, iode, nav.gephMap, nav.gephIndex);
 }
 template <>
 Seph* seleph<
     Seph>(Trace& trace, GTime time, SatSys Sat, E_NavMsgType type, int iode, Navigation& nav)
 {
-    return selSatEphFromMap(trace, time, Sat, type, iode, nav.sephMap);
+    return selSatEphFromMap(trace, time, Sat, type, iode, nav.sephMap, nav.sephIndex);
 }
 template <>
 ION* seleph<ION>(Trace& trace, GTime time, E_Sys sys, E_NavMsgType type, Navigation& nav)
@@ -323,8 +375,9 @@ double eph2Clk(GTime time, Seph& seph, int recurse = 0)
 /** broadcast ephemeris to satellite position and clock bias
  * compute satellite position and clock bias with broadcast ephemeris (gps, galileo, qzss)
  * satellite clock includes relativity correction without code bias (tgd or bgd)
+ * returns false if the kepler iteration does not converge
  */
-void eph2Pos(
+bool eph2Pos(
     GTime     time,              ///< time (gpst)
     Eph&      eph,               ///< broadcast ephemeris
     Vector3d& rSat,              ///< satellite position (ecef) {x,y,z} (m)
@@ -338,7 +391,7 @@ void eph2Pos(
         if (var_ptr)
             *var_ptr = 0;
 
-        return;
+        return true;
     }
 
     double tk  = (time - eph.toe).to_double();
@@ -377,7 +430,7 @@ void eph2Pos(
     if (n >= MAX_ITER_KEPLER)
     {
         printf("kepler iteration overflow sat=%s\n", eph.Sat.id().c_str());
-        return;
+        return false;
     }
 
     double sinE = sin(E);
@@ -433,12 +486,233 @@ void eph2Pos(
     if (var_ptr)
         *var_ptr = SQR(eph.ura[0]);
     // *var_ptr = var_uraeph(eph.sva);
+
+    return true;
+}
+
+/** broadcast ephemerides to satellite positions for many satellites at once (gps, galileo, qzss,
+ * beidou). Parameters are gathered into structure-of-arrays form so that the per-satellite loops
+ * vectorise, results are identical to calling eph2Pos() for each entry individually
+ */
+void eph2PosBatch(
+    const vector<GTime>& times,    ///< times (gpst), one per ephemeris
+    const vector<Eph*>&  ephs,     ///< broadcast ephemerides
+    vector<Vector3d>&    rSats,    ///< satellite positions (ecef) (m), unchanged for failures
+    vector<bool>&        passList  ///< whether each position was computed, as eph2Pos() returns
+)
+{
+    int n = ephs.size();
+
+    rSats.resize(n);
+    passList.assign(n, true);
+
+    vector<double> tk(n);
+    vector<double> mu(n);
+    vector<double> omge(n);
+    vector<double> A(n);
+    vector<double> e(n);
+    vector<double> M(n);
+    vector<double> E(n);
+    vector<double> Ek(n);
+    vector<char>   geo(n);
+    vector<char>   valid(n);
+    vector<int>    iters(n, 0);
+
+    for (int j = 0; j < n; j++)
+    {
+        auto& eph = *ephs[j];
+
+        tk[j]    = (times[j] - eph.toe).to_double();
+        valid[j] = eph.A > 0;
+        A[j]     = valid[j] ? eph.A : 1;
+        e[j]     = eph.e;
+
+        int   prn = eph.Sat.prn;
+        E_Sys sys = eph.Sat.sys;
+
+        switch (sys)
+        {
+            case E_Sys::GAL:
+                mu[j]   = MU_GAL;
+                omge[j] = OMGE_GAL;
+                break;
+            case E_Sys::BDS:
+                mu[j]   = MU_CMP;
+                omge[j] = OMGE_CMP;
+                break;
+            default:
+                mu[j]   = MU_GPS;
+                omge[j] = OMGE;
+                break;
+        }
+
+        /* beidou geo satellite (ref [9]), prn range may change in the future */
+        geo[j] = (sys == E_Sys::BDS) && (prn <= 5 || prn >= 59);
+
+        M[j] = eph.M0 + (sqrt(mu[j] / (A[j] * A[j] * A[j])) + eph.deln) * tk[j];
+    }
+
+#pragma omp simd
+    for (int j = 0; j < n; j++)
+    {
+        E[j]  = M[j];
+        Ek[j] = 0;
+    }
+
+    // iterate all lanes together, freezing each one as it converges as the scalar loop would
+    for (int iter = 0; iter < MAX_ITER_KEPLER; iter++)
+    {
+        int numActive = 0;
+
+#pragma omp simd reduction(+ : numActive)
+        for (int j = 0; j < n; j++)
+        {
+            bool   active = fabs(E[j] - Ek[j]) > RTOL_KEPLER;
+            double Enext  = E[j] - (E[j] - e[j] * sin(E[j]) - M[j]) / (1 - e[j] * cos(E[j]));
+
+            Ek[j] = active ? E[j] : Ek[j];
+            E[j]  = active ? Enext : E[j];
+            iters[j] += active;
+            numActive += active;
+        }
+
+        if (numActive == 0)
+        {
+            break;
+        }
+    }
+
+    vector<double> x(n);
+    vector<double> y(n);
+    vector<double> z(n);
+    vector<double> i0(n);
+    vector<double> omg(n);
+    vector<double> cus(n);
+    vector<double> cuc(n);
+    vector<double> crs(n);
+    vector<double> crc(n);
+    vector<double> cis(n);
+    vector<double> cic(n);
+    vector<double> O(n);
+
+    for (int j = 0; j < n; j++)
+    {
+        auto& eph = *ephs[j];
+
+        i0[j]  = eph.i0 + eph.idot * tk[j];
+        omg[j] = eph.omg;
+        cus[j] = eph.cus;
+        cuc[j] = eph.cuc;
+        crs[j] = eph.crs;
+        crc[j] = eph.crc;
+        cis[j] = eph.cis;
+        cic[j] = eph.cic;
+
+        if (geo[j])
+            O[j] = eph.OMG0 + eph.OMGd * tk[j] - omge[j] * eph.toes;
+        else
+            O[j] = eph.OMG0 + (eph.OMGd - omge[j]) * tk[j] - omge[j] * eph.toes;
+    }
+
+#pragma omp simd
+    for (int j = 0; j < n; j++)
+    {
+        double sinE = sin(E[j]);
+        double cosE = cos(E[j]);
+
+        double u = atan2(sqrt(1 - e[j] * e[j]) * sinE, cosE - e[j]) + omg[j];
+        double r = A[j] * (1 - e[j] * cosE);
+        double i = i0[j];
+
+        double sin2u = sin(2 * u);
+        double cos2u = cos(2 * u);
+
+        u += cus[j] * sin2u + cuc[j] * cos2u;  // argument of latitude
+        r += crs[j] * sin2u + crc[j] * cos2u;  // radius
+        i += cis[j] * sin2u + cic[j] * cos2u;  // inclination
+
+        double xo   = r * cos(u);
+        double yo   = r * sin(u);
+        double cosi = cos(i);
+
+        double sinO = sin(O[j]);
+        double cosO = cos(O[j]);
+
+        double xg = xo * cosO - yo * cosi * sinO;
+        double yg = xo * sinO + yo * cosi * cosO;
+        double zg = yo * sin(i);
+
+        double sino = sin(omge[j] * tk[j]);
+        double coso = cos(omge[j] * tk[j]);
+
+        x[j] = geo[j] ? +xg * coso + yg * sino * COS_5 + zg * sino * SIN_5 : xg;
+        y[j] = geo[j] ? -xg * sino + yg * coso * COS_5 + zg * coso * SIN_5 : yg;
+        z[j] = geo[j] ? -yg * SIN_5 + zg * COS_5 : zg;
+    }
+
+    for (int j = 0; j < n; j++)
+    {
+        if (valid[j] == false)
+        {
+            rSats[j] = Vector3d::Zero();
+            continue;
+        }
+
+        if (iters[j] >= MAX_ITER_KEPLER)
+        {
+            printf("kepler iteration overflow sat=%s\n", ephs[j]->Sat.id().c_str());
+            passList[j] = false;
+            continue;
+        }
+
+        rSats[j] = Vector3d(x[j], y[j], z[j]);
+    }
+}
+
+/** precompute the glonass integration states at each whole step from the ephemeris epoch.
+ * eph2Pos() starts from the closest stored state, so repeated calls only integrate the remainder.
+ * Not thread safe, call from serial code before the ephemeris is used
+ */
+void gephCheckpoints(
+    Geph& geph  ///< glonass ephemeris
+)
+{
+    int numSteps = ceil(MAXDTOE_GLO / TSTEP) + 1;
+
+    for (int dir : {0, 1})
+    {
+        auto& checkpoints = geph.checkpoints[dir];
+
+        if (checkpoints.empty() == false)
+        {
+            continue;
+        }
+
+        double tt = dir == 0 ? +TSTEP : -TSTEP;
+
+        array<double, 6> x;
+        for (int i = 0; i < 3; i++)
+        {
+            x[i]     = geph.pos[i];
+            x[i + 3] = geph.vel[i];
+        }
+
+        checkpoints.reserve(numSteps + 1);
+        checkpoints.push_back(x);
+
+        for (int k = 0; k < numSteps; k++)
+        {
+            glorbit(tt, x.data(), geph.acc);
+
+            checkpoints.push_back(x);
+        }
+    }
 }
 
 /** glonass ephemeris to satellite position and clock bias.
  * compute satellite position and clock bias with glonass ephemeris
  */
-void eph2Pos(
+bool eph2Pos(
     GTime     time,          ///< time (gpst)
     Geph&     geph,          ///< glonass ephemeris
     Vector3d& rSat,          ///< satellite position {x,y,z} (ecef) (m)
@@ -447,6 +721,10 @@ void eph2Pos(
 {
     double t = (time - geph.toe).to_double();
 
+    double tt = t < 0 ? -TSTEP : TSTEP;
+
+    auto& checkpoints = geph.checkpoints[t < 0];
+
     double x[6];
     for (int i = 0; i < 3; i++)
     {
@@ -454,7 +732,21 @@ void eph2Pos(
         x[i + 3] = geph.vel[i];
     }
 
-    for (double tt = t < 0 ? -TSTEP : TSTEP; fabs(t) > 1E-9; t -= tt)
+    // skip the whole steps that have already been integrated, stepping t exactly as below
+    int k = 0;
+    while (k + 1 < checkpoints.size() && fabs(t) > 1E-9 && fabs(t) >= TSTEP)
+    {
+        t -= tt;
+        k++;
+    }
+
+    if (k > 0)
+    {
+        for (int i = 0; i < 6; i++)
+            x[i] = checkpoints[k][i];
+    }
+
+    for (; fabs(t) > 1E-9; t -= tt)
     {
         if (fabs(t) < TSTEP)
             tt = t;
@@ -467,12 +759,14 @@ void eph2Pos(
 
     if (var)
         *var = SQR(ERREPH_GLO);
+
+    return true;
 }
 
 /** sbas ephemeris to satellite position and clock bias
  * compute satellite position and clock bias with sbas ephemeris
  */
-void eph2Pos(
+bool eph2Pos(
     GTime     time,          ///< time (gpst)
     Seph&     seph,          ///< sbas ephemeris
     Vector3d& rSat,          ///< satellite position {x,y,z} (ecef) (m)
@@ -489,6 +783,8 @@ void eph2Pos(
     if (var)
         *var = SQR(seph.ura);
     // *var = var_uraeph(seph.sva);
+
+    return true;
 }
 
 /* satellite clock by broadcast ephemeris
@@ -600,8 +896,21 @@ bool satPosBroadcast(
 
     auto& eph = *eph_ptr;
 
-    eph2Pos(time - tt, eph, rSat1, &ephVar);
-    eph2Pos(time + tt, eph, rSat2);
+    bool pass = true;
+    pass &= eph2Pos(time - tt, eph, rSat1, &ephVar);
+    pass &= eph2Pos(time + tt, eph, rSat2);
+
+    if (pass == false)
+    {
+        tracepdeex(
+            2,
+            trace,
+            "\nBroadcast Ephemeris failed for sat: %s, %s",
+            Sat.id().c_str(),
+            teph.to_string().c_str()
+        );
+        return false;
+    }
 
     if (eph.svh == E_Svh::SVH_OK)
     {
@@ -617,6 +926,133 @@ bool satPosBroadcast(
     return true;
 }
 
+/** satellite positions by broadcast ephemeris for a set of satellites, each at its own time.
+ * Equivalent to calling satPosBroadcast() for each, but keplerian ephemerides are evaluated
+ * together through eph2PosBatch()
+ */
+void satPosBroadcast(
+    Trace&                 trace,       ///< Trace to output to
+    const vector<GTime>&   times,       ///< Times (gpst), one per satellite
+    const vector<GTime>&   tephs,       ///< Times to select ephemerides (gpst), one per satellite
+    const vector<SatPos*>& satPosList,  ///< Satellites to complete with positions
+    vector<bool>&          passList,    ///< Output whether each position was found
+    Navigation&            nav          ///< Navigation data
+)
+{
+    double tt = 10e-3;
+
+    passList.assign(satPosList.size(), false);
+
+    vector<int>   batchIndices;
+    vector<Eph*>  batchEphs;
+    vector<GTime> batchTimes;
+
+    for (int s = 0; s < satPosList.size(); s++)
+    {
+        auto& satPos = *satPosList[s];
+        auto& Sat    = satPos.Sat;
+        auto& time   = times[s];
+        auto& teph   = tephs[s];
+
+        satPos.iodePos     = ANY_IODE;
+        satPos.ephPosValid = false;
+
+        if (Sat.sys != E_Sys::GPS && Sat.sys != E_Sys::GAL && Sat.sys != E_Sys::QZS &&
+            Sat.sys != E_Sys::BDS)
+        {
+            passList[s] = satPosBroadcast(trace, time, teph, satPos, nav);
+            continue;
+        }
+
+        auto type = acsConfig.used_nav_types[Sat.sys];
+
+        auto eph_ptr = seleph<Eph>(trace, teph, Sat, type, satPos.iodePos, nav);
+        if (eph_ptr == nullptr)
+        {
+            tracepdeex(
+                2,
+                trace,
+                "\nCould not find Broadcast Ephemeris for sat: %s, %s",
+                Sat.id().c_str(),
+                teph.to_string().c_str()
+            );
+            continue;
+        }
+
+        batchIndices.push_back(s);
+
+        batchEphs.push_back(eph_ptr);
+        batchEphs.push_back(eph_ptr);
+
+        batchTimes.push_back(time - tt);
+        batchTimes.push_back(time + tt);
+    }
+
+    vector<Vector3d> rSats(batchEphs.size(), Vector3d::Zero());
+    vector<bool>     batchPasses;
+
+    eph2PosBatch(batchTimes, batchEphs, rSats, batchPasses);
+
+    for (int b = 0; b < batchIndices.size(); b++)
+    {
+        int   s      = batchIndices[b];
+        auto& satPos = *satPosList[s];
+        auto& eph    = *batchEphs[2 * b];
+
+        if (batchPasses[2 * b] == false || batchPasses[2 * b + 1] == false)
+        {
+            tracepdeex(
+                2,
+                trace,
+                "\nBroadcast Ephemeris failed for sat: %s, %s",
+                satPos.Sat.id().c_str(),
+                tephs[s].to_string().c_str()
+            );
+            continue;
+        }
+
+        Vector3d& rSat1 = rSats[2 * b];
+        Vector3d& rSat2 = rSats[2 * b + 1];
+
+        satPos.posVar = eph.A > 0 ? SQR(eph.ura[0]) : 0;
+
+        if (eph.svh == E_Svh::SVH_OK)
+        {
+            satPos.ephPosValid = true;
+        }
+
+        satPos.iodePos = eph.iode;
+
+        satPos.rSatApc = (rSat2 + rSat1) / 2;
+        satPos.satVel  = (rSat2 - rSat1) / (2 * tt);
+
+        passList[s] = true;
+    }
+}
+
+/** satellite positions by broadcast ephemeris for a set of satellites at a common time.
+ */
+void satPosBroadcast(
+    Trace&          trace,
+    GTime           time,
+    GTime           teph,
+    vector<SatPos>& satPosList,
+    vector<bool>&   passList,
+    Navigation&     nav
+)
+{
+    vector<SatPos*> satPosPtrs;
+    for (auto& satPos : satPosList)
+    {
+        satPosPtrs.push_back(&satPos);
+    }
+
+    vector<GTime> times(satPosList.size(), time);
+    vector<GTime> tephs(satPosList.size(), teph);
+
+    satPosBroadcast(trace, times, tephs, satPosPtrs, passList, nav);
+}
+
 /* satellite clock by broadcast ephemeris
  */
 bool satClkBroadcast(
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "common/enums.h"
+#include "common/gTime.hpp"
+#include "common/satSys.hpp"
+
+using std::map;
+using std::unordered_map;
+using std::vector;
+
+/** Flat, time-sorted view of one satellite's ephemerides of one navigation message type.
+ *
+ * The navigation maps remain the owners of the ephemerides, this only holds pointers into their
+ * (stable) nodes, sorted by ascending reference time, with a bucket table for O(1) epoch lookup.
+ * Entries before `first` have been culled from the source map and must not be dereferenced.
+ */
+template <typename EPHTYPE>
+struct SatEphIndex
+{
+    using SourceMap = map<GTime, EPHTYPE, std::greater<GTime>>;
+
+    const SourceMap* source_ptr = nullptr;  ///< Map this index was built from
+    size_t           sourceSize = 0;        ///< Expected size of the source map while in sync
+
+    vector<long double> times;              ///< Ascending reference times of the ephemerides
+    vector<EPHTYPE*>    ephs;               ///< Pointers to ephemerides, parallel to times
+    int                 first = 0;          ///< First entry not culled from the source map
+
+    long double bucketStart = 0;            ///< Time of the start of the first bucket
+    long double bucketWidth = 1;            ///< Width of each bucket (s)
+    vector<int> buckets;                    ///< First entry at or after the start of each bucket
+
+    /** Check that the source map has not been modified since this index was last synchronised
+     */
+    bool valid() const { return source_ptr && source_ptr->size() == sourceSize; }
+
+    int size() const { return times.size(); }
+
+    /** Rebuild the flat arrays and bucket table from the source map
+     */
+    void build(const SourceMap& source)
+    {
+        source_ptr = &source;
+        sourceSize = source.size();
+        first      = 0;
+
+        times.clear();
+        ephs.clear();
+        times.reserve(source.size());
+        ephs.reserve(source.size());
+
+        for (auto it = source.rbegin(); it != source.rend(); it++)
+        {
+            auto& [ephTime, eph] = *it;
+
+            times.push_back(ephTime.bigTime);
+            ephs.push_back(const_cast<EPHTYPE*>(&eph));
+        }
+
+        buckets.clear();
+
+        if (times.empty())
+        {
+            return;
+        }
+
+        int n       = times.size();
+        bucketStart = times.front();
+        bucketWidth = (times.back() - times.front()) / n;
+        if (bucketWidth <= 0)
+        {
+            bucketWidth = 1;
+        }
+
+        buckets.resize(n + 1);
+        int i = 0;
+        for (int b = 0; b <= n; b++)
+        {
+            long double start = bucketStart + b * bucketWidth;
+            while (i < n && times[i] < start)
+                i++;
+
+            buckets[b] = i;
+        }
+    }
+
+    /** Account for entries erased from the front (oldest end) of the source map by culling.
+     * Marks the index as stale if the source map had changed since the last synchronisation.
+     */
+    void trim(
+        size_t sizeBefore,  ///< Size of the source map before culling
+        size_t erased       ///< Number of entries erased by culling
+    )
+    {
+        if (sizeBefore != sourceSize || first + erased > times.size())
+        {
+            sourceSize = (size_t)-1;
+            return;
+        }
+
+        first += erased;
+        sourceSize -= erased;
+    }
+
+    /** Index of the latest entry with a reference time at or before the requested time.
+     * Returns first - 1 if there is no such entry.
+     */
+    int atOrBefore(long double time) const
+    {
+        int n = times.size();
+        if (first >= n || time < times[first])
+        {
+            return first - 1;
+        }
+
+        long double offset = (time - bucketStart) / bucketWidth;
+
+        int b = std::min((long double)buckets.size() - 1, std::floor(offset));
+
+        int i = std::max(first, buckets[b]);
+        while (i > first && times[i - 1] > time)
+            i--;
+        while (i < n && times[i] <= time)
+            i++;
+
+        return i - 1;
+    }
+};
+
+/** Per satellite and message type ephemeris indices for one of the broadcast navigation maps.
+ *
+ * Indices are (re)built by sync() at serial points in the processing loop, lookups from parallel
+ * sections only read, and fall back to the source maps if they have been modified in between.
+ */
+template <typename EPHTYPE>
+struct EphIndex
+{
+    using SourceMap = map<SatSys, map<E_NavMsgType, map<GTime, EPHTYPE, std::greater<GTime>>>>;
+
+    unordered_map<int, SatEphIndex<EPHTYPE>> satIndexMap;
+
+    EphIndex() {}
+
+    /** Indices point into a particular navigation object, copies start empty and must be resynced
+     */
+    EphIndex(const EphIndex&) {}
+
+    EphIndex& operator=(const EphIndex&)
+    {
+        satIndexMap.clear();
+        return *this;
+    }
+
+    static int key(SatSys Sat, E_NavMsgType type) { return (int)Sat + (int)type; }
+
+    /** Get the index for a satellite and message type, if it exists and is in sync with its map
+     */
+    const SatEphIndex<EPHTYPE>* find(SatSys Sat, E_NavMsgType type) const
+    {
+        auto it = satIndexMap.find(key(Sat, type));
+        if (it == satIndexMap.end())
+        {
+            return nullptr;
+        }
+
+        auto& [id, satIndex] = *it;
+
+        if (satIndex.valid() == false)
+        {
+            return nullptr;
+        }
+
+        return &satIndex;
+    }
+
+    /** Update the bookkeeping for entries culled from the oldest end of a satellite's map
+     */
+    void trim(SatSys Sat, E_NavMsgType type, size_t sizeBefore, size_t erased)
+    {
+        auto it = satIndexMap.find(key(Sat, type));
+        if (it == satIndexMap.end())
+        {
+            return;
+        }
+
+        auto& [id, satIndex] = *it;
+
+        satIndex.trim(sizeBefore, erased);
+    }
+
+    /** Rebuild any indices that are missing or out of date with respect to the source maps.
+     * Not thread safe, call from serial code only.
+     */
+    void sync(SourceMap& ephMap)
+    {
+        for (auto& [Sat, satEphMap] : ephMap)
+            for (auto& [type, navMap] : satEphMap)
+            {
+                auto& satIndex = satIndexMap[key(Sat, type)];
+
+                if (satIndex.source_ptr == &navMap && satIndex.valid())
+                {
+                    continue;
+                }
+
+                satIndex.build(navMap);
+            }
+    }
+};
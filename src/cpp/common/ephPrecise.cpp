@@ -7,6 +7,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include "common/acsConfig.hpp"
 #include "common/algebra.hpp"
 #include "common/biases.hpp"
 #include "common/common.hpp"
@@ -592,3 +593,26 @@ bool satClkPrecise(Trace& trace, GTime time, SatPos& satPos, Navigation& nav)
         nav
     );
 }
+
+/** Discard precise orbits and clocks that have fallen behind the product window.
+ * Files are only loaded while they overlap the window, so these will not be reloaded.
+ */
+void cullOldPrecise(GTime time)
+{
+    if (acsConfig.product_window <= 0)
+    {
+        return;
+    }
+
+    GTime cutoff = time - acsConfig.product_window;
+
+    for (auto& [id, pephMap] : nav.pephMap)
+    {
+        pephMap.erase(pephMap.begin(), pephMap.lower_bound(cutoff));
+    }
+
+    for (auto& [id, pclkMap] : nav.pclkMap)
+    {
+        pclkMap.erase(pclkMap.begin(), pclkMap.lower_bound(cutoff));
+    }
+}
@@ -18,6 +18,8 @@ int readdcb(string file);
 
 void readSp3ToNav(string& file, Navigation& nav, int opt);
 
+void cullOldPrecise(GTime time);
+
 bool readsp3(
     std::istream& fileStream,
     vector<Peph>& pephList,
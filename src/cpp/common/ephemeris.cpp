@@ -30,8 +30,15 @@ double relativity1(Vector3d& rSat, Vector3d& satVel)
     return 2 * rSat.dot(satVel) / CLIGHT / CLIGHT;
 }
 
-template <typename TYPE>
-void cullEphMap(GTime time, TYPE& map)
+/** Stand in for ephemeris maps that are never searched by time, and so have no time index
+ */
+struct NoEphIndex
+{
+    void trim(SatSys Sat, E_NavMsgType type, size_t sizeBefore, size_t erased) {}
+};
+
+template <typename TYPE, typename INDEX>
+void cullEphMap(GTime time, TYPE& map, INDEX& ephIndex)
 {
     for (auto& [satid, satEphMap] : map)
     {
@@ -62,31 +69,53 @@ void cullEphMap(GTime time, TYPE& map)
                 continue;
             }
 
-            for (auto it =
-                     std::next(navMap.begin());  // Always reserve the latest entry when culling
-                 it != navMap.end();)
+            // maps are sorted newest first, so everything old is a contiguous range at the end
+            auto it = navMap.upper_bound(time - tmax);
+            if (it == navMap.begin())
+            {
+                it++;  // Always reserve the latest entry when culling
+            }
+
+            size_t sizeBefore = navMap.size();
+            size_t erased     = std::distance(it, navMap.end());
+
+            if (erased == 0)
             {
-                auto& [ephtime, eph] = *it;
-
-                if (ephtime < time - tmax)
-                {
-                    it = navMap.erase(it);
-                }
-                else
-                {
-                    ++it;
-                }
+                continue;
             }
+
+            navMap.erase(it, navMap.end());
+
+            ephIndex.trim(Sat, navtyp, sizeBefore, erased);
         }
     }
 }
 
 void cullOldEphs(GTime time)
 {
-    cullEphMap(time, nav.ephMap);
-    cullEphMap(time, nav.gephMap);
-    cullEphMap(time, nav.sephMap);
-    cullEphMap(time, nav.cephMap);
+    cullEphMap(time, nav.ephMap, nav.ephIndex);
+    cullEphMap(time, nav.gephMap, nav.gephIndex);
+    cullEphMap(time, nav.sephMap, nav.sephIndex);
+    NoEphIndex noIndex;
+    cullEphMap(time, nav.cephMap, noIndex);
+
+    syncEphIndices(nav);
+}
+
+/** Bring the broadcast ephemeris time indices up to date with any newly received ephemerides
+ */
+void syncEphIndices(Navigation& nav)
+{
+    nav.ephIndex.sync(nav.ephMap);
+    nav.gephIndex.sync(nav.gephMap);
+    nav.sephIndex.sync(nav.sephMap);
+
+    for (auto& [Sat, satGephMap] : nav.gephMap)
+        for (auto& [type, gephMap] : satGephMap)
+            for (auto& [time, geph] : gephMap)
+            {
+                gephCheckpoints(geph);
+            }
 }
 
 bool satclk(
@@ -163,117 +192,76 @@ bool satclk(
     return returnValue;
 }
 
-/** compute satellite position and clock
- * satellite clock does not include code bias correction (tgd or bgd)
+/** Complete a satellite position once a source has provided it
  */
-bool satpos(
-    Trace&  trace,   ///< Trace to output to
-    GTime   time,    ///< time (gpst)
-    GTime   teph,    ///< time to select ephemeris (gpst)
-    SatPos& satPos,  ///< Data required for determining and storing satellite positions/clocks
-    vector<E_Source> ephTypes,     ///< Source of ephemeris
-    E_OffsetType     offsetType,   ///< Type of antenna offset to apply
-    Navigation&      nav,          ///< navigation data
-    const KFState*   kfState_ptr,  ///< Optional pointer to a kalman filter to take values from
-    const KFState*   remote_ptr    ///< Optional pointer to a kalman filter to take values from
+void satPosFound(
+    Trace&      trace,    ///< Trace to output to
+    GTime       time,     ///< time (gpst)
+    GTime       teph,     ///< time to select ephemeris (gpst)
+    SatPos&     satPos,   ///< Satellite position to complete
+    E_Source    ephType,  ///< Source that provided the position
+    Navigation& nav       ///< navigation data
 )
 {
-    double antennaScalar = 0;
-    bool   returnValue   = false;
-
-    for (auto& ephType : ephTypes)
+    switch (ephType)
     {
-        tracepdeex(
-            4,
-            trace,
-            "\n%-10s: time=%s sat=%s ephType=%s offsetType=%d",
-            __FUNCTION__,
-            time.to_string().c_str(),
-            satPos.Sat.id().c_str(),
-            enum_to_string(ephType),
-            offsetType
-        );
-
-        if (returnValue == false)
-            switch (ephType)
-            {
-                case E_Source::BROADCAST:
-                    returnValue = satPosBroadcast(trace, time, teph, satPos, nav);
-                    break;
-                case E_Source::SBAS:
-                    returnValue = satPosSBAS(trace, time, teph, satPos, nav);
-                    break;
-                case E_Source::SSR:
-                    returnValue = satPosSSR(trace, time, teph, satPos, nav);
-                    break;
-                case E_Source::PRECISE:
-                    returnValue = satPosPrecise(trace, time, satPos, nav);
-                    break;
-                case E_Source::KALMAN:
-                    returnValue = satPosKalman(trace, time, satPos, kfState_ptr);
-                    break;
-                case E_Source::REMOTE:
-                    returnValue = satPosKalman(trace, time, satPos, remote_ptr);
-                    break;
-                case E_Source::CONFIG:
-                    continue;
-                default:
-                    continue;
-            }
-
-        if (returnValue == false)
-        {
-            continue;
-        }
+        case E_Source::BROADCAST:
+            satPos.rSatCom = satPos.rSatApc;
+            break;
+        case E_Source::SBAS:
+            satPos.rSatCom = satPos.rSatApc;
+            break;
+        case E_Source::SSR:
+            satPos.rSatApc = satPos.rSatCom;
+            break;
+        case E_Source::PRECISE:
+            satPos.rSatApc = satPos.rSatCom;
+            break;
+        case E_Source::KALMAN:
+            satPos.rSatApc = satPos.rSatCom;
+            break;
+        case E_Source::REMOTE:
+            satPos.rSatApc = satPos.rSatCom;
+            break;
+    }
 
-        switch (ephType)
+    if (acsConfig.check_broadcast_differences && ephType != E_Source::BROADCAST)
+    {
+        SatPos copy  = satPos;
+        bool   pass  = satPosBroadcast(trace, time, teph, copy, nav);
+        double delta = (satPos.rSatApc - copy.rSatApc).norm();
+        if (pass && delta > 10)
         {
-            case E_Source::BROADCAST:
-                satPos.rSatCom = satPos.rSatApc;
-                break;
-            case E_Source::SBAS:
-                satPos.rSatCom = satPos.rSatApc;
-                break;
-            case E_Source::SSR:
-                satPos.rSatApc = satPos.rSatCom;
-                break;
-            case E_Source::PRECISE:
-                satPos.rSatApc = satPos.rSatCom;
-                break;
-            case E_Source::KALMAN:
-                satPos.rSatApc = satPos.rSatCom;
-                break;
-            case E_Source::REMOTE:
-                satPos.rSatApc = satPos.rSatCom;
-                break;
-        }
-
-        if (acsConfig.check_broadcast_differences && ephType != E_Source::BROADCAST)
-        {
-            SatPos copy  = satPos;
-            bool   pass  = satPosBroadcast(trace, time, teph, copy, nav);
-            double delta = (satPos.rSatApc - copy.rSatApc).norm();
-            if (pass && delta > 10)
-            {
-                BOOST_LOG_TRIVIAL(warning)
-                    << "Orbit for " << satPos.Sat.id() << " is " << delta << " from broadcast";
-            }
+            BOOST_LOG_TRIVIAL(warning)
+                << "Orbit for " << satPos.Sat.id() << " is " << delta << " from broadcast";
         }
+    }
 
-        tracepdeex(4, trace, " - FOUND");
+    tracepdeex(4, trace, " - FOUND");
 
-        satPos.posTime     = time;
-        satPos.posSource   = ephType;
-        satPos.ephPosValid = true;
+    satPos.posTime     = time;
+    satPos.posSource   = ephType;
+    satPos.ephPosValid = true;
 
-        if (ephType == E_Source::SSR)
-        {
-            satPos.clkSource   = ephType;
-            satPos.ephClkValid = true;
-        }
-
-        break;
+    if (ephType == E_Source::SSR)
+    {
+        satPos.clkSource   = ephType;
+        satPos.ephClkValid = true;
     }
+}
+
+/** Apply the satellite antenna offset required for the type of position requested
+ */
+bool satPosOffset(
+    Trace&       trace,       ///< Trace to output to
+    GTime        time,        ///< time (gpst)
+    SatPos&      satPos,      ///< Satellite position to adjust
+    E_OffsetType offsetType,  ///< Type of antenna offset to apply
+    Navigation&  nav,         ///< navigation data
+    bool         returnValue  ///< Whether the position was found
+)
+{
+    double antennaScalar = 0;
 
     if (satPos.posSource == E_Source::SSR &&
         acsConfig.ssr_input_antenna_offset == E_OffsetType::UNSPECIFIED)
@@ -352,6 +340,76 @@ bool satpos(
     return returnValue;
 }
 
+/** compute satellite position and clock
+ * satellite clock does not include code bias correction (tgd or bgd)
+ */
+bool satpos(
+    Trace&  trace,   ///< Trace to output to
+    GTime   time,    ///< time (gpst)
+    GTime   teph,    ///< time to select ephemeris (gpst)
+    SatPos& satPos,  ///< Data required for determining and storing satellite positions/clocks
+    vector<E_Source> ephTypes,     ///< Source of ephemeris
+    E_OffsetType     offsetType,   ///< Type of antenna offset to apply
+    Navigation&      nav,          ///< navigation data
+    const KFState*   kfState_ptr,  ///< Optional pointer to a kalman filter to take values from
+    const KFState*   remote_ptr    ///< Optional pointer to a kalman filter to take values from
+)
+{
+    bool returnValue = false;
+
+    for (auto& ephType : ephTypes)
+    {
+        tracepdeex(
+            4,
+            trace,
+            "\n%-10s: time=%s sat=%s ephType=%s offsetType=%d",
+            __FUNCTION__,
+            time.to_string().c_str(),
+            satPos.Sat.id().c_str(),
+            enum_to_string(ephType),
+            offsetType
+        );
+
+        if (returnValue == false)
+            switch (ephType)
+            {
+                case E_Source::BROADCAST:
+                    returnValue = satPosBroadcast(trace, time, teph, satPos, nav);
+                    break;
+                case E_Source::SBAS:
+                    returnValue = satPosSBAS(trace, time, teph, satPos, nav);
+                    break;
+                case E_Source::SSR:
+                    returnValue = satPosSSR(trace, time, teph, satPos, nav);
+                    break;
+                case E_Source::PRECISE:
+                    returnValue = satPosPrecise(trace, time, satPos, nav);
+                    break;
+                case E_Source::KALMAN:
+                    returnValue = satPosKalman(trace, time, satPos, kfState_ptr);
+                    break;
+                case E_Source::REMOTE:
+                    returnValue = satPosKalman(trace, time, satPos, remote_ptr);
+                    break;
+                case E_Source::CONFIG:
+                    continue;
+                default:
+                    continue;
+            }
+
+        if (returnValue == false)
+        {
+            continue;
+        }
+
+        satPosFound(trace, time, teph, satPos, ephType, nav);
+
+        break;
+    }
+
+    return satPosOffset(trace, time, satPos, offsetType, nav, returnValue);
+}
+
 void adjustRelativity(SatPos& satPos, E_Relativity applyRelativity)
 {
     E_Relativity clockHasRelativity;
@@ -376,33 +434,19 @@ void adjustRelativity(SatPos& satPos, E_Relativity applyRelativity)
     satPos.satClk -= scalar * relativity1(satPos.rSatCom, satPos.satVel);
 }
 
-/** satellite positions and clocks.
- * satellite position and clock are values at signal transmission time.
- * satellite clock does not include code bias correction (tgd or bgd).
- * any pseudorange and broadcast ephemeris are always needed to get signal transmission time.
+/** Find the transmission time of an observation from its pseudorange and satellite clock
  */
-bool satPosClk(
-    Trace&           trace,           ///< Trace to output to
-    GTime            teph,            ///< time to select ephemeris (gpst)
-    GObs&            obs,             ///< observations to complete with satellite positions
-    Navigation&      nav,             ///< Navigation data
-    vector<E_Source> posSources,      ///< Source of ephemeris data
-    vector<E_Source> clkSources,      ///< Source of ephemeris data
-    const KFState*   kfState_ptr,     ///< Optional pointer to a kalman filter to take values from
-    const KFState*   remote_ptr,      ///< Optional pointer to a kalman filter to take values from
-    E_OffsetType     offsetType,      ///< Point of satellite to output position of
-    E_Relativity     applyRelativity  ///< Option to apply relativistic correction to clock
+bool satClkTransmission(
+    Trace&                  trace,        ///< Trace to output to
+    GTime                   teph,         ///< time to select ephemeris (gpst)
+    GObs&                   obs,          ///< observations to complete with satellite clocks
+    Navigation&             nav,          ///< Navigation data
+    const vector<E_Source>& clkSources,   ///< Source of ephemeris data
+    const KFState*          kfState_ptr,  ///< Optional pointer to a filter to take values from
+    const KFState*          remote_ptr,   ///< Optional pointer to a filter to take values from
+    GTime&                  time          ///< Output transmission time
 )
 {
-    tracepdeex(
-        3,
-        trace,
-        "\n%-10s: teph=%s %s",
-        __FUNCTION__,
-        teph.to_string().c_str(),
-        obs.Sat.id()
-    );
-
     double pr = 0;
 
     for (auto& [a, sig] : obs.sigs)
@@ -432,7 +476,7 @@ bool satPosClk(
     obs.tof = pr / CLIGHT;
 
     // transmission time by satellite clock
-    GTime time = obs.time;
+    time = obs.time;
 
     time -= obs.tof;
 
@@ -465,9 +509,20 @@ bool satPosClk(
     );
 
     time -= obs.satClk;  // Eugene: what if using ssr?
-    // satellite position and clock at transmission time
-    pass = satpos(trace, time, teph, obs, posSources, offsetType, nav, kfState_ptr, remote_ptr);
 
+    return true;
+}
+
+/** Complete an observation once its satellite position at transmission time has been sought
+ */
+bool satPosTransmission(
+    Trace&       trace,           ///< Trace to output to
+    GTime        time,            ///< Transmission time
+    GObs&        obs,             ///< observations to complete with satellite positions
+    bool         pass,            ///< Whether the satellite position was found
+    E_Relativity applyRelativity  ///< Option to apply relativistic correction to clock
+)
+{
     if (pass == false)
     {
         obs.failureNoSatPos = true;
@@ -476,7 +531,7 @@ bool satPosClk(
             3,
             trace,
             "\n%s failed (no ephemeris?) %s sat=%s",
-            __FUNCTION__,
+            "satPosClk",
             time.to_string().c_str(),
             obs.Sat.id().c_str()
         );
@@ -508,3 +563,169 @@ bool satPosClk(
 
     return true;
 }
+
+/** satellite positions and clocks.
+ * satellite position and clock are values at signal transmission time.
+ * satellite clock does not include code bias correction (tgd or bgd).
+ * any pseudorange and broadcast ephemeris are always needed to get signal transmission time.
+ */
+bool satPosClk(
+    Trace&           trace,           ///< Trace to output to
+    GTime            teph,            ///< time to select ephemeris (gpst)
+    GObs&            obs,             ///< observations to complete with satellite positions
+    Navigation&      nav,             ///< Navigation data
+    vector<E_Source> posSources,      ///< Source of ephemeris data
+    vector<E_Source> clkSources,      ///< Source of ephemeris data
+    const KFState*   kfState_ptr,     ///< Optional pointer to a kalman filter to take values from
+    const KFState*   remote_ptr,      ///< Optional pointer to a kalman filter to take values from
+    E_OffsetType     offsetType,      ///< Point of satellite to output position of
+    E_Relativity     applyRelativity  ///< Option to apply relativistic correction to clock
+)
+{
+    tracepdeex(
+        3,
+        trace,
+        "\n%-10s: teph=%s %s",
+        __FUNCTION__,
+        teph.to_string().c_str(),
+        obs.Sat.id()
+    );
+
+    GTime time;
+    bool  pass =
+        satClkTransmission(trace, teph, obs, nav, clkSources, kfState_ptr, remote_ptr, time);
+
+    if (pass == false)
+    {
+        return false;
+    }
+
+    // satellite position and clock at transmission time
+    pass = satpos(trace, time, teph, obs, posSources, offsetType, nav, kfState_ptr, remote_ptr);
+
+    return satPosTransmission(trace, time, obs, pass, applyRelativity);
+}
+
+/** satellite positions and clocks for a set of observations, using the configured sources of each
+ * satellite. Equivalent to calling satPosClk() for each observation at its own time, but
+ * satellites that use broadcast orbits first have their keplerian positions evaluated together
+ */
+void satPosClks(
+    Trace&         trace,           ///< Trace to output to
+    vector<GObs*>& obsList,         ///< observations to complete with satellite positions
+    Navigation&    nav,             ///< Navigation data
+    const KFState* kfState_ptr,     ///< Optional pointer to a kalman filter to take values from
+    const KFState* remote_ptr,      ///< Optional pointer to a kalman filter to take values from
+    E_OffsetType   offsetType,      ///< Point of satellite to output position of
+    E_Relativity   applyRelativity  ///< Option to apply relativistic correction to clock
+)
+{
+    int numObs = obsList.size();
+
+    vector<GTime> times(numObs);
+    vector<char>  clkPasses(numObs);
+
+    vector<int>     batchIndices;
+    vector<SatPos*> batchSatPoss;
+    vector<GTime>   batchTimes;
+    vector<GTime>   batchTephs;
+
+    for (int i = 0; i < numObs; i++)
+    {
+        auto& obs     = *obsList[i];
+        auto& satOpts = acsConfig.getSatOpts(obs.Sat);
+
+        tracepdeex(
+            3,
+            trace,
+            "\n%-10s: teph=%s %s",
+            "satPosClk",
+            obs.time.to_string().c_str(),
+            obs.Sat.id()
+        );
+
+        clkPasses[i] = satClkTransmission(
+            trace,
+            obs.time,
+            obs,
+            nav,
+            satOpts.clockModel.sources,
+            kfState_ptr,
+            remote_ptr,
+            times[i]
+        );
+
+        auto& posSources = satOpts.posModel.sources;
+
+        if (clkPasses[i] && posSources.empty() == false &&
+            posSources.front() == E_Source::BROADCAST)
+        {
+            batchIndices.push_back(i);
+            batchSatPoss.push_back(&obs);
+            batchTimes.push_back(times[i]);
+            batchTephs.push_back(obs.time);
+        }
+    }
+
+    vector<bool> batchPasses;
+    satPosBroadcast(trace, batchTimes, batchTephs, batchSatPoss, batchPasses, nav);
+
+    vector<char> broadcastFound(numObs, false);
+    for (int b = 0; b < batchIndices.size(); b++)
+    {
+        broadcastFound[batchIndices[b]] = batchPasses[b];
+    }
+
+    for (int i = 0; i < numObs; i++)
+    {
+        if (clkPasses[i] == false)
+        {
+            continue;
+        }
+
+        auto& obs        = *obsList[i];
+        auto& time       = times[i];
+        auto  posSources = acsConfig.getSatOpts(obs.Sat).posModel.sources;
+
+        bool pass;
+        if (broadcastFound[i])
+        {
+            tracepdeex(
+                4,
+                trace,
+                "\n%-10s: time=%s sat=%s ephType=%s offsetType=%d",
+                "satpos",
+                time.to_string().c_str(),
+                obs.Sat.id().c_str(),
+                enum_to_string(E_Source::BROADCAST),
+                offsetType
+            );
+
+            satPosFound(trace, time, obs.time, obs, E_Source::BROADCAST, nav);
+
+            pass = satPosOffset(trace, time, obs, offsetType, nav, true);
+        }
+        else
+        {
+            if (posSources.empty() == false && posSources.front() == E_Source::BROADCAST)
+            {
+                // already attempted with the batch, fall through to the remaining sources
+                posSources.erase(posSources.begin());
+            }
+
+            pass = satpos(
+                trace,
+                time,
+                obs.time,
+                obs,
+                posSources,
+                offsetType,
+                nav,
+                kfState_ptr,
+                remote_ptr
+            );
+        }
+
+        satPosTransmission(trace, time, obs, pass, applyRelativity);
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <map>
 #include <string>
@@ -12,6 +13,7 @@
 #include "common/satSys.hpp"
 #include "common/trace.hpp"
 
+using std::array;
 using std::map;
 using std::string;
 using std::vector;
@@ -181,6 +183,8 @@ struct Geph : BrdcEph
     int    NT;        ///< calender number of day within 4-year interval
     bool   moreData;  ///< availability of additional data
     int    N4;        ///< 4-year interval number
+
+    vector<array<double, 6>> checkpoints[2];  ///< integrated states at whole steps after/before toe
 };
 
 /** precise clock
@@ -375,6 +379,8 @@ Matrix3d ecef2rac(Vector3d& rSat, Vector3d& satVel);
 
 void cullOldEphs(GTime time);
 
+void syncEphIndices(Navigation& nav);
+
 void cullOldSSRs(GTime time);
 
 struct KFState;
@@ -420,6 +426,16 @@ bool satPosClk(
     E_Relativity     applyRelativity = E_Relativity::ON
 );
 
+void satPosClks(
+    Trace&         trace,
+    vector<GObs*>& obsList,
+    Navigation&    nav,
+    const KFState* kfState_ptr     = nullptr,
+    const KFState* remote_ptr      = nullptr,
+    E_OffsetType   offsetType      = E_OffsetType::COM,
+    E_Relativity   applyRelativity = E_Relativity::ON
+);
+
 void readSp3ToNav(string& file, Navigation& nav, int opt);
 
 bool readsp3(
@@ -480,6 +496,33 @@ bool satPosBroadcast(
     int         iode = ANY_IODE
 );
 
+void satPosBroadcast(
+    Trace&          trace,
+    GTime           time,
+    GTime           teph,
+    vector<SatPos>& satPosList,
+    vector<bool>&   passList,
+    Navigation&     nav
+);
+
+void satPosBroadcast(
+    Trace&                 trace,
+    const vector<GTime>&   times,
+    const vector<GTime>&   tephs,
+    const vector<SatPos*>& satPosList,
+    vector<bool>&          passList,
+    Navigation&            nav
+);
+
+void eph2PosBatch(
+    const vector<GTime>& times,
+    const vector<Eph*>&  ephs,
+    vector<Vector3d>&    rSats,
+    vector<bool>&        passList
+);
+
+void gephCheckpoints(Geph& geph);
+
 bool satPosPrecise(Trace& trace, GTime time, SatPos& satPos, Navigation& nav);
 
 bool satClkPrecise(Trace& trace, GTime time, SatPos& satPos, Navigation& nav);
@@ -24,8 +24,6 @@ constexpr double VAR_NOTEC = 30.0 * 30.0;  // variance of no tec
 constexpr double MIN_EL    = 0.0;          // min elevation angle (rad)
 constexpr double MIN_HGT   = -1000.0;      // min user height (m)
 
-int dataindex(int i, int j, int k, const int* ndata);
-
 /* ionosphere model ------------------------------------------------------------
  * compute ionospheric delay by broadcast ionosphere model (klobuchar model)
  * args   : gtime_t t        I   time (gpst)
@@ -194,20 +192,36 @@ int interpTec(const TEC& tec, int k, const VectorPos& posp, double& value, doubl
     int j = (int)floor(b);
     b -= j;
 
-    /* get gridded tec data */
+    /* get gridded tec data, the corners are adjacent in latitude, then separated by a row in
+     * longitude, so only need bounds checking individually when near the edges of the grid */
     double d[4] = {};
     double r[4] = {};
-    for (int n = 0; n < 4; n++)
-    {
-        int index = dataindex(i + (n % 2), j + (n < 2 ? 0 : 1), k, tec.ndata);
-        if (index < 0)
-            continue;
 
-        auto& tecPoint = tec.tecPointVector[index];
+    int base = tec.gridIndex(i, j, k);
+    if (base >= 0 && i + 1 < tec.ndata[0] && j + 1 < tec.ndata[1])
+    {
+        int             nlat       = tec.ndata[0];
+        const TECPoint* point      = &tec.tecPointVector[base];
+        const TECPoint* corners[4] = {point, point + 1, point + nlat, point + nlat + 1};
 
-        d[n] = tecPoint.data;
-        r[n] = tecPoint.rms;
+        for (int n = 0; n < 4; n++)
+        {
+            d[n] = corners[n]->data;
+            r[n] = corners[n]->rms;
+        }
     }
+    else
+        for (int n = 0; n < 4; n++)
+        {
+            int index = tec.gridIndex(i + (n % 2), j + (n < 2 ? 0 : 1), k);
+            if (index < 0)
+                continue;
+
+            auto& tecPoint = tec.tecPointVector[index];
+
+            d[n] = tecPoint.data;
+            r[n] = tecPoint.rms;
+        }
 
     if (d[0] > 0 && d[1] > 0 && d[2] > 0 && d[3] > 0)
     {
@@ -291,6 +305,8 @@ bool ionDelay(
     delay = 0;
     var   = 0;
 
+    double fs = ionmapf(pos, azel, mapFn, layerHeight);
+
     for (int i = 0; i < tec.ndata[2]; i++)
     {
         double hion = tec.hgts[0] + tec.hgts[2] * i;
@@ -298,7 +314,6 @@ bool ionDelay(
         /* ionospheric pierce point position */
         VectorPos posp;
         ionppp(pos, azel, tec.rb, hion, posp);
-        double fs = ionmapf(pos, azel, mapFn, layerHeight);
 
         if (frame == E_IonoFrame::SUN_FIXED)
         {
@@ -11,6 +11,7 @@
 #include "common/attitude.hpp"
 #include "common/azElMapData.hpp"
 #include "common/enums.h"
+#include "common/ephIndex.hpp"
 #include "common/ephemeris.hpp"
 #include "common/erp.hpp"
 #include "common/gTime.hpp"
@@ -30,16 +31,30 @@ struct TECPoint
     double rms  = 0;  ///< RMS values (tecu)
 };
 
+/** TEC grid of one epoch.
+ * Points are stored contiguously, with latitude varying fastest, then longitude, then height.
+ */
 struct TEC
 {
-    /// TEC grid type
-    GTime            time;      ///< epoch time (GPST)
-    int              ndata[3];  ///< TEC grid data size {nlat,nlon,nhgt}
-    double           rb;        ///< earth radius (km)
-    double           lats[3];   ///< latitude start/interval (deg)
-    double           lons[3];   ///< longitude start/interval (deg)
-    double           hgts[3];   ///< heights start/interval (km)
-    vector<TECPoint> tecPointVector;
+    GTime            time;            ///< epoch time (GPST)
+    int              ndata[3] = {};   ///< TEC grid data size {nlat,nlon,nhgt}
+    double           rb       = 0;    ///< earth radius (km)
+    double           lats[3]  = {};   ///< latitude start/end/interval (deg)
+    double           lons[3]  = {};   ///< longitude start/end/interval (deg)
+    double           hgts[3]  = {};   ///< heights start/end/interval (km)
+    vector<TECPoint> tecPointVector;  ///< Grid points, indexed by gridIndex()
+
+    /** Index of a grid point in tecPointVector (i:lat, j:lon, k:hgt), or -1 if outside of the grid
+     */
+    int gridIndex(int i, int j, int k) const
+    {
+        if (i < 0 || ndata[0] <= i || j < 0 || ndata[1] <= j || k < 0 || ndata[2] <= k)
+        {
+            return -1;
+        }
+
+        return i + ndata[0] * (j + ndata[1] * k);
+    }
 };
 
 struct SatNav
@@ -90,6 +105,11 @@ struct Navigation
         sephMap;  ///< SBAS ephemeris
     map<SatSys, map<E_NavMsgType, map<GTime, Ceph, std::greater<GTime>>>>
         cephMap;  ///< GPS/QZS/BDS CNVX ephemeris
+
+    EphIndex<Eph>  ephIndex;   ///< time index over ephMap
+    EphIndex<Geph> gephIndex;  ///< time index over gephMap
+    EphIndex<Seph> sephIndex;  ///< time index over sephMap, cephMap is never searched by time
+
     map<E_Sys, map<E_NavMsgType, map<GTime, ION, std::greater<GTime>>>> ionMap;  ///< ION messages
     map<E_StoCode, map<E_NavMsgType, map<GTime, STO, std::greater<GTime>>>>
                                                                         stoMap;  ///< STO messages
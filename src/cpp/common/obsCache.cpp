@@ -0,0 +1,343 @@
+// #pragma GCC optimize ("O0")
+
+#include "common/obsCache.hpp"
+#include <boost/log/trivial.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include "common/common.hpp"
+#include "common/observations.hpp"
+
+/** Get the identity of a source file, so that caches of modified files are not used
+ */
+bool sourceIdentity(
+    const string& sourcePath,  ///< Path of the rinex file
+    int64_t&      size,        ///< Output size of the file
+    int64_t&      time         ///< Output modification time of the file
+)
+{
+    std::error_code ec;
+
+    auto fileSize = std::filesystem::file_size(sourcePath, ec);
+    if (ec)
+        return false;
+
+    auto modifyTime = std::filesystem::last_write_time(sourcePath, ec);
+    if (ec)
+        return false;
+
+    size = fileSize;
+    time = modifyTime.time_since_epoch().count();
+
+    return true;
+}
+
+/** Get the path of the cache for a rinex file.
+ * The name includes a hash of the absolute path of the file, so that files of the same name in
+ * different directories do not share a cache.
+ */
+string obsCachePath(
+    const string& directory,  ///< Directory to keep caches in
+    const string& sourcePath  ///< Path of the rinex file
+)
+{
+    std::error_code ec;
+
+    auto absolutePath = std::filesystem::absolute(sourcePath, ec).lexically_normal().string();
+    if (ec)
+    {
+        absolutePath = sourcePath;
+    }
+
+    // 64 bit FNV-1a, stable between builds and platforms unlike std::hash
+    uint64_t pathHash = 0xcbf29ce484222325;
+    for (unsigned char c : absolutePath)
+    {
+        pathHash ^= c;
+        pathHash *= 0x100000001b3;
+    }
+
+    char hashString[17];
+    snprintf(hashString, sizeof(hashString), "%016llx", (unsigned long long)pathHash);
+
+    auto filename = std::filesystem::path(sourcePath).filename().string();
+
+    filename += string(".") + hashString + ".obscache";
+
+    return (std::filesystem::path(directory) / filename).string();
+}
+
+/** Load a cache file, if it exists and was generated from the current version of the source file
+ */
+bool ObsCacheReader::open(
+    const string& cachePath,  ///< Path of the cache file
+    const string& sourcePath  ///< Path of the rinex file it caches
+)
+{
+    std::ifstream input(cachePath, std::ios::binary | std::ios::ate);
+    if (!input)
+    {
+        return false;
+    }
+
+    size_t fileSize = input.tellg();
+    if (fileSize < sizeof(ObsCacheHeader))
+    {
+        return false;
+    }
+
+    ObsCacheHeader expected;
+    ObsCacheHeader header;
+
+    input.seekg(0);
+    input.read((char*)&header, sizeof(header));
+
+    if (memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0 ||
+        header.version != OBS_CACHE_VERSION || header.headerSize != sizeof(ObsCacheHeader) ||
+        header.epochSize != sizeof(ObsCacheEpoch) || header.sigSize != sizeof(ObsCacheSig))
+    {
+        BOOST_LOG_TRIVIAL(info) << "Observation cache " << cachePath
+                                << " is from an incompatible version, regenerating";
+        return false;
+    }
+
+    int64_t sourceSize;
+    int64_t sourceTime;
+    if (sourceIdentity(sourcePath, sourceSize, sourceTime) == false ||
+        header.sourceSize != sourceSize || header.sourceTime != sourceTime)
+    {
+        BOOST_LOG_TRIVIAL(info) << "Observation cache " << cachePath
+                                << " is out of date, regenerating";
+        return false;
+    }
+
+    data.resize(fileSize);
+    input.seekg(0);
+    input.read(data.data(), fileSize);
+    if (!input)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Error reading observation cache " << cachePath;
+        data.clear();
+        return false;
+    }
+
+    offset = sizeof(ObsCacheHeader);
+
+    return true;
+}
+
+/** Read the next epoch of observations from the cache, returns false once there are none left
+ */
+bool ObsCacheReader::readEpoch(
+    ObsList& obsList  ///< List to append the observations of the epoch to
+)
+{
+    if (offset + sizeof(ObsCacheEpoch) > data.size())
+    {
+        return false;
+    }
+
+    ObsCacheEpoch epoch;
+    memcpy(&epoch, &data[offset], sizeof(epoch));
+    offset += sizeof(epoch);
+
+    if (offset + epoch.numSigs * sizeof(ObsCacheSig) > data.size())
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Truncated observation cache, ignoring remainder";
+        offset = data.size();
+        return false;
+    }
+
+    GTime time;
+    time.bigTime = epoch.seconds + (long double)epoch.fraction;
+
+    obsList.reserve(obsList.size() + epoch.numSats);
+
+    // signals are ordered by satellite, gather each run of them into an observation
+    int i = 0;
+    while (i < epoch.numSigs)
+    {
+        GObs rawObs = {};
+        rawObs.time = time;
+
+        for (; i < epoch.numSigs; i++)
+        {
+            ObsCacheSig record;
+            memcpy(&record, &data[offset], sizeof(record));
+
+            SatSys Sat((E_Sys)record.sys, record.prn);
+
+            if (rawObs.sigsLists.empty())
+            {
+                rawObs.Sat = Sat;
+            }
+            else if ((int)Sat != (int)rawObs.Sat)
+            {
+                break;
+            }
+
+            offset += sizeof(record);
+
+            Sig sig;
+            sig.code = (E_ObsCode)record.code;
+            sig.L    = record.L;
+            sig.P    = record.P;
+            sig.D    = record.D;
+            sig.LLI  = record.LLI;
+            sig.snr  = record.snr;
+
+            rawObs.sigsLists[(E_FType)record.ftype].push_back(sig);
+        }
+
+        obsList.push_back((shared_ptr<GObs>)rawObs);
+    }
+
+    return true;
+}
+
+/** Start writing a cache for a rinex file
+ */
+bool ObsCacheWriter::open(
+    const string& cachePath,  ///< Path of the cache file
+    const string& sourcePath  ///< Path of the rinex file it caches
+)
+{
+    this->cachePath = cachePath;
+    tempPath        = cachePath + ".tmp";
+
+    header            = {};
+    header.headerSize = sizeof(ObsCacheHeader);
+    header.epochSize  = sizeof(ObsCacheEpoch);
+    header.sigSize    = sizeof(ObsCacheSig);
+
+    if (sourceIdentity(sourcePath, header.sourceSize, header.sourceTime) == false)
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    auto            directory = std::filesystem::path(cachePath).parent_path();
+    if (directory.empty() == false)
+    {
+        std::filesystem::create_directories(directory, ec);
+    }
+
+    output.open(tempPath, std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Could not create observation cache at " << tempPath;
+        return false;
+    }
+
+    output.write((char*)&header, sizeof(header));
+
+    return true;
+}
+
+/** Append an epoch of observations to the cache
+ */
+void ObsCacheWriter::writeEpoch(
+    ObsList& obsList  ///< Observations of the epoch, as parsed
+)
+{
+    if (!output)
+    {
+        return;
+    }
+
+    vector<ObsCacheSig> records;
+    ObsCacheEpoch       epoch;
+
+    for (auto& obs : only<GObs>(obsList))
+    {
+        long double wholeSeconds = std::floor(obs.time.bigTime);
+
+        epoch.seconds  = (int64_t)wholeSeconds;
+        epoch.fraction = (double)(obs.time.bigTime - wholeSeconds);
+        epoch.numSats++;
+
+        for (auto& [ft, sigList] : obs.sigsLists)
+            for (auto& sig : sigList)
+            {
+                ObsCacheSig record;
+                record.sys   = (int16_t)obs.Sat.sys;
+                record.prn   = obs.Sat.prn;
+                record.ftype = ft;
+                record.LLI   = sig.LLI;
+                record.code  = (int32_t)sig.code;
+                record.L     = sig.L;
+                record.P     = sig.P;
+                record.D     = sig.D;
+                record.snr   = sig.snr;
+
+                records.push_back(record);
+            }
+    }
+
+    if (records.empty())
+    {
+        // empty epochs would read back as the end of the file
+        return;
+    }
+
+    epoch.numSigs = records.size();
+
+    output.write((char*)&epoch, sizeof(epoch));
+    output.write((char*)records.data(), records.size() * sizeof(ObsCacheSig));
+
+    header.numEpochs++;
+}
+
+/** Complete the cache once the whole rinex file has been written to it, and move it into place
+ */
+void ObsCacheWriter::finish()
+{
+    if (!output)
+    {
+        return;
+    }
+
+    output.seekp(0);
+    output.write((char*)&header, sizeof(header));
+    output.close();
+
+    if (!output)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Error writing observation cache at " << tempPath;
+
+        std::error_code ec;
+        std::filesystem::remove(tempPath, ec);
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Could not move observation cache to " << cachePath << " - "
+                                   << ec.message();
+        return;
+    }
+
+    BOOST_LOG_TRIVIAL(info) << "Wrote observation cache " << cachePath << " with "
+                            << header.numEpochs << " epochs";
+}
+
+/** Remove the temporary file of a cache that was never completed, eg. when processing stops before
+ * the end of the rinex file
+ */
+ObsCacheWriter::~ObsCacheWriter()
+{
+    if (output.is_open() == false)
+    {
+        return;
+    }
+
+    output.close();
+
+    std::error_code ec;
+    std::filesystem::remove(tempPath, ec);
+
+    BOOST_LOG_TRIVIAL(debug) << "Removed incomplete observation cache " << tempPath;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+struct ObsList;
+
+constexpr int OBS_CACHE_VERSION = 2;
+
+/** Header at the start of a binary observation cache file.
+ *
+ * The cache is a flat, native layout copy of the decoded observations of one rinex file, so that
+ * later runs may load it with a single read (or map it) rather than parsing the text again.
+ * Record sizes are stored so that caches written by incompatible builds are rejected.
+ */
+struct ObsCacheHeader
+{
+    char    magic[8]   = {'G', 'N', 'O', 'B', 'S', 'C', 'A', 'C'};
+    int32_t version    = OBS_CACHE_VERSION;
+    int32_t headerSize = 0;  ///< Size of this header, as written
+    int32_t epochSize  = 0;  ///< Size of each epoch record, as written
+    int32_t sigSize    = 0;  ///< Size of each signal record, as written
+    int64_t sourceSize = 0;  ///< Size of the rinex file the cache was generated from
+    int64_t sourceTime = 0;  ///< Modification time of the rinex file the cache was generated from
+    int64_t numEpochs  = 0;  ///< Number of epoch records in the file
+};
+
+/** Epoch record, followed by numSigs signal records ordered by satellite
+ */
+struct ObsCacheEpoch
+{
+    int64_t seconds  = 0;  ///< Whole seconds of the epoch time (GTime::bigTime)
+    double  fraction = 0;  ///< Fractional seconds of the epoch time
+    int32_t numSigs  = 0;  ///< Number of signal records in this epoch
+    int32_t numSats  = 0;  ///< Number of satellites in this epoch
+};
+
+/** Signal record, the fields of a RawSig and the satellite and frequency it belongs to
+ */
+struct ObsCacheSig
+{
+    int16_t sys   = 0;  ///< Satellite system
+    int16_t prn   = 0;  ///< Satellite prn
+    int16_t ftype = 0;  ///< Frequency the signal is listed under
+    int16_t LLI   = 0;  ///< Loss of lock indicator
+    int32_t code  = 0;  ///< Reported code type
+    int32_t spare = 0;
+    double  L     = 0;  ///< Carrier phase (cycles)
+    double  P     = 0;  ///< Pseudorange (meters)
+    double  D     = 0;  ///< Doppler
+    double  snr   = 0;  ///< Signal to Noise ratio (dB-Hz)
+};
+
+/** Reader for a complete binary observation cache, loaded into memory in one read
+ */
+struct ObsCacheReader
+{
+    vector<char> data;        ///< Contents of the cache file
+    size_t       offset = 0;  ///< Offset of the next epoch record
+
+    bool open(const string& cachePath, const string& sourcePath);
+
+    bool readEpoch(ObsList& obsList);
+};
+
+/** Writer for a binary observation cache, written to a temporary file that only replaces the cache
+ * once the whole rinex file has been parsed. Incomplete caches are removed when the writer is
+ * destroyed.
+ */
+struct ObsCacheWriter
+{
+    string         cachePath;
+    string         tempPath;
+    std::ofstream  output;
+    ObsCacheHeader header;
+
+    bool open(const string& cachePath, const string& sourcePath);
+
+    void writeEpoch(ObsList& obsList);
+
+    void finish();
+
+    ~ObsCacheWriter();
+};
+
+string obsCachePath(const string& directory, const string& sourcePath);
@@ -7,6 +7,7 @@
 #include "common/enums.h"
 #include "common/ephemeris.hpp"
 #include "common/navigation.hpp"
+#include "common/productWriter.hpp"
 #include "pea/ppp.hpp"
 
 constexpr double ORBEX_VER  = 0.09;
@@ -568,7 +569,12 @@ void writeSysSetOrbex(
         }
     }
 
-    updateOrbexBody(filename, entryList, time, outSys, outFileDat);
+    // the entries are a snapshot of this epoch, the file itself may be written later
+    queueProductOutput(
+        obxProductQueue,
+        [filename, entryList = std::move(entryList), time, outSys, &outFileDat]() mutable
+        { updateOrbexBody(filename, entryList, time, outSys, outFileDat); }
+    );
 }
 
 /** Output ORBEX files
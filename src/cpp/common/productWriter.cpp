@@ -0,0 +1,161 @@
+// #pragma GCC optimize ("O0")
+
+#include "common/productWriter.hpp"
+#include <boost/log/trivial.hpp>
+#include <charconv>
+#include <thread>
+#include "common/acsConfig.hpp"
+
+using std::lock_guard;
+using std::mutex;
+
+ProductQueue clkProductQueue("clock");
+ProductQueue sp3ProductQueue("sp3");
+ProductQueue obxProductQueue("orbex");
+
+void ProductQueue::run()
+{
+    BOOST_LOG_TRIVIAL(debug) << "Running " << name << " output queue thread";
+
+    while (1)
+    {
+        std::function<void()> job;
+
+        // use braces to limit guard scope, jobs are run unguarded so more may be queued meanwhile
+        {
+            lock_guard<mutex> guard(queueMutex);
+
+            if (jobs.empty())
+            {
+                // stop the thread so we dont burn cycles, it will be restarted by the next push
+                running = false;
+                idleCondition.notify_all();
+                return;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        try
+        {
+            job();
+        }
+        catch (std::exception& e)
+        {
+            BOOST_LOG_TRIVIAL(error) << "Error writing " << name << " output: " << e.what();
+        }
+    }
+}
+
+void ProductQueue::push(std::function<void()> job)
+{
+    lock_guard<mutex> guard(queueMutex);
+
+    jobs.push_back(std::move(job));
+
+    if (running == false)
+    {
+        running = true;
+
+        std::thread(&ProductQueue::run, this).detach();
+    }
+}
+
+/** Block until all queued jobs have been written
+ */
+void ProductQueue::wait()
+{
+    std::unique_lock<mutex> lock(queueMutex);
+
+    idleCondition.wait(lock, [this] { return running == false; });
+}
+
+/** Write a product using a worker thread if configured, or immediately otherwise
+ */
+void queueProductOutput(
+    ProductQueue&         queue,  ///< Queue for the type of product being written
+    std::function<void()> job     ///< Job writing a snapshot of the product to file
+)
+{
+    if (acsConfig.queue_product_outputs == false)
+    {
+        job();
+        return;
+    }
+
+    queue.push(std::move(job));
+}
+
+/** Wait for all product writers to finish, call before exiting or reading back output files
+ */
+void waitForProductQueues()
+{
+    clkProductQueue.wait();
+    sp3ProductQueue.wait();
+    obxProductQueue.wait();
+}
+
+/** Append a string to a line, padded to a width (as for %*s or %-*s)
+ */
+void appendString(string& line, const string& value, int width, bool leftAlign)
+{
+    int padding = width - (int)value.size();
+
+    if (leftAlign == false && padding > 0)
+        line.append(padding, ' ');
+
+    line += value;
+
+    if (leftAlign && padding > 0)
+        line.append(padding, ' ');
+}
+
+/** Append a right aligned number to a line using the text to append, padded to a width
+ */
+void appendChars(string& line, const char* begin, const char* end, int width)
+{
+    int padding = width - (int)(end - begin);
+
+    if (padding > 0)
+        line.append(padding, ' ');
+
+    line.append(begin, end);
+}
+
+/** Append an integer to a line (as for %*d)
+ */
+void appendInt(string& line, long value, int width)
+{
+    char buff[32];
+    auto [end, ec] = std::to_chars(buff, buff + sizeof(buff), value);
+
+    appendChars(line, buff, end, width);
+}
+
+/** Append a fixed point value to a line (as for %*.*f)
+ */
+void appendFixed(string& line, double value, int width, int precision)
+{
+    char buff[400];
+    auto [end, ec] =
+        std::to_chars(buff, buff + sizeof(buff), value, std::chars_format::fixed, precision);
+
+    appendChars(line, buff, end, width);
+}
+
+/** Append a value in scientific notation to a line (as for %*.*E)
+ */
+void appendScientific(string& line, double value, int width, int precision)
+{
+    char buff[64];
+    auto [end, ec] =
+        std::to_chars(buff, buff + sizeof(buff), value, std::chars_format::scientific, precision);
+
+    for (char* c = buff; c < end; c++)
+    {
+        *c = toupper(*c);
+    }
+
+    appendChars(line, buff, end, width);
+}
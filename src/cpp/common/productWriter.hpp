@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+
+using std::list;
+using std::string;
+
+/** Queue of jobs writing one type of output product, run in order on a worker thread.
+ *
+ * Jobs run after the main loop has moved on, so they must only use the snapshot of values they
+ * captured when queued, never the filter, navigation or receiver objects directly.
+ */
+struct ProductQueue
+{
+    string                      name;            ///< Name of the product, for logging
+    list<std::function<void()>> jobs;            ///< Jobs waiting to be run, in order
+    std::mutex                  queueMutex;      ///< Guard for the job list and running flag
+    std::condition_variable     idleCondition;   ///< Signalled when the worker runs out of jobs
+    bool                        running = false;
+
+    ProductQueue(string name)
+        : name{name}
+    {
+    }
+
+    void run();
+
+    void push(std::function<void()> job);
+
+    void wait();
+};
+
+extern ProductQueue clkProductQueue;
+extern ProductQueue sp3ProductQueue;
+extern ProductQueue obxProductQueue;
+
+void queueProductOutput(ProductQueue& queue, std::function<void()> job);
+
+void waitForProductQueues();
+
+void appendString(string& line, const string& value, int width, bool leftAlign = false);
+
+void appendInt(string& line, long value, int width);
+
+void appendFixed(string& line, double value, int width, int precision);
+
+void appendScientific(string& line, double value, int width, int precision);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/antenna.hpp"
 #include "common/attitude.hpp"
 #include "common/cache.hpp"
 #include "common/common.hpp"
@@ -7,6 +8,7 @@
 #include "common/gTime.hpp"
 #include "common/observations.hpp"
 #include "common/satStat.hpp"
+#include "common/tides.hpp"
 #include "pea/ppp.hpp"
 
 struct Parser;
@@ -62,9 +64,10 @@ struct Rtk
     string               antennaType;
     string               receiverType;
     string               antennaId;
-    map<SatSys, SatStat> satStatMap;
+    SatStatTable         satStats;
     VectorEnu            antDelta;  ///< antenna delta {rov_e,rov_n,rov_u}
     AttStatus            attStatus;
+    SlipDetector         slipDetector;
 };
 
 struct SinexSiteId;
@@ -145,6 +148,10 @@ struct Receiver : ReceiverLogs, Rtk
     };
     Cache<tuple<Vector3d, Vector3d, Vector3d, Vector3d, Vector3d>> pppTideCache;
     Cache<tuple<Vector3d>>                                         pppEopCache;
+    TideInterpolator                                               tideInterpolator;
+
+    map<E_Sys, PcvHandle>  recPcvHandles;  ///< Resolved pcv models of this receiver's antenna
+    map<SatSys, PcvHandle> satPcvHandles;  ///< Resolved pcv models of satellites seen by this receiver
 };
 
 struct ReceiverMap : map<string, Receiver>
@@ -1050,10 +1050,10 @@ int decodeObsDataRinex2(
             }
         }
 
-        E_FType ft = code2Freq[obs.Sat.sys][effectiveCode];
+        E_FType ft = codeFrequency(obs.Sat.sys, effectiveCode);
 
         // Parse observation values
-        ObservationValues obsValues = parseObservationValues(buff, j);
+        ObservationValues obsValues = parseObservationValues(line, j);
 
         // Stage the observation - use appropriate staging method
         if (isPhaseObservation)
@@ -1146,10 +1146,10 @@ int decodeObsDataRinex3(
 
     for (auto& [index, codeType] : codeTypes)
     {
-        E_FType ft = code2Freq[obs.Sat.sys][codeType.code];
+        E_FType ft = codeFrequency(obs.Sat.sys, codeType.code);
 
         // Parse observation values using SRP helper function
-        ObservationValues obsValues = parseObservationValues(buff, j);
+        ObservationValues obsValues = parseObservationValues(line, j);
 
         // Stage the observation instead of immediately committing
         stageObservation(staging, codeType.type, codeType.code, ft, obsValues.value, obsValues.lli);
@@ -2321,6 +2321,110 @@ int readRnx(
     return 0;
 }
 
+/** Parse a fixed width decimal field (as for Fw.d), without the copying and sscanf of str2num().
+ * The integer digits are accumulated exactly and scaled by an exact power of ten once, so the
+ * result is the correctly rounded value, as from str2num(). Blank fields are zero, and anything
+ * more unusual (exponents, excessive digits) is passed to str2num().
+ */
+double parseFixedWidth(
+    const string& line,      ///< Line containing the field
+    int           position,  ///< Start of the field
+    int           width      ///< Width of the field
+)
+{
+    static constexpr double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                       1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+    int end = std::min((int)line.size(), position + width);
+    int i   = position;
+
+    while (i < end && line[i] == ' ')
+        i++;
+
+    if (i >= end)
+    {
+        return 0;
+    }
+
+    bool negative = false;
+    if (line[i] == '-' || line[i] == '+')
+    {
+        negative = line[i] == '-';
+        i++;
+    }
+
+    long long mantissa = 0;
+    int       digits   = 0;
+    int       decimals = 0;
+    bool      point    = false;
+
+    for (; i < end; i++)
+    {
+        char c = line[i];
+
+        if (c >= '0' && c <= '9')
+        {
+            mantissa = mantissa * 10 + (c - '0');
+            digits++;
+
+            if (point)
+                decimals++;
+        }
+        else if (c == '.' && point == false)
+        {
+            point = true;
+        }
+        else if (c == ' ')
+        {
+            break;
+        }
+        else
+        {
+            return str2num(line.c_str(), position, width);
+        }
+    }
+
+    if (digits == 0 || digits > 15)
+    {
+        return str2num(line.c_str(), position, width);
+    }
+
+    double value = mantissa;
+    if (decimals > 0)
+    {
+        value /= pow10[decimals];
+    }
+
+    if (negative)
+    {
+        return -value;
+    }
+
+    return value;
+}
+
+/** Find the frequency of a code, without inserting missing codes into the shared map, since
+ * observation files may be parsed in parallel
+ */
+E_FType codeFrequency(E_Sys sys, E_ObsCode code)
+{
+    auto sysIt = code2Freq.find(sys);
+    if (sysIt == code2Freq.end())
+    {
+        return E_FType();
+    }
+
+    auto& [dummy, freqMap] = *sysIt;
+
+    auto it = freqMap.find(code);
+    if (it == freqMap.end())
+    {
+        return E_FType();
+    }
+
+    return it->second;
+}
+
 // Helper functions for common RINEX observation processing (SRP compliance)
 
 /**
@@ -2335,35 +2439,32 @@ int readRnx(
  * - 1 character: Loss of Lock Indicator (0-3)
  * - 1 character: Signal strength (optional, not currently processed)
  *
- * @param buff Character buffer containing RINEX observation line
+ * @param line RINEX observation line
  * @param position Starting position in buffer (0-based index)
  *
  * @return ObservationValues Structure containing parsed value and LLI
  *         Returns zeros if parsing fails or position is out of bounds
  *
- * @note Includes debug output for development/troubleshooting
+ * @note Values are parsed with parseFixedWidth()
  * @note LLI bits are masked to extract only relevant flags (bits 0-1)
  *
  * @warning Function assumes RINEX standard 16-character field width
  */
-ObservationValues parseObservationValues(char* buff, int position)
+ObservationValues parseObservationValues(const string& line, int position)
 {
     ObservationValues result;
 
-    // Add bounds checking to prevent buffer overflow
-    if (!buff)
+    result.value = parseFixedWidth(line, position, 14);
+    result.lli   = 0;
+
+    if (position + 14 < line.size())
     {
-        BOOST_LOG_TRIVIAL(error) << "parseObservationValues: null buffer pointer";
-        result.value = 0.0;
-        result.lli   = 0.0;
-        return result;
+        char lli = line[position + 14];
+        if (lli >= '0' && lli <= '9')
+            result.lli = lli - '0';
     }
 
-    // Basic bounds check - RINEX observation fields are 14 chars + 1 char LLI
-    size_t bufferLength = strlen(buff);
-    result.value        = str2num(buff, position, 14);
-    result.lli          = str2num(buff, position + 14, 1);
-    result.lli          = (unsigned char)result.lli & 0x03;  // Extract LLI bits
+    result.lli = (unsigned char)result.lli & 0x03;  // Extract LLI bits
     return result;
 }
 
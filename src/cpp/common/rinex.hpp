@@ -632,7 +632,7 @@ RawSig* findOrCreateSignal(SigList& sigList, E_ObsCode obsCode)
  * Extracts numerical observation value and Loss of Lock Indicator from
  * RINEX formatted line at specified position with comprehensive bounds checking.
  *
- * @param buff Character buffer containing RINEX observation line
+ * @param line RINEX observation line
  * @param position Starting position in buffer (0-based index)
  *
  * @return ObservationValues Structure containing parsed value and LLI
@@ -640,7 +640,11 @@ RawSig* findOrCreateSignal(SigList& sigList, E_ObsCode obsCode)
  * @note RINEX format: 14 chars value + 1 char LLI + 1 char signal strength
  * @note Returns zeros if parsing fails or position is out of bounds
  */
-ObservationValues parseObservationValues(char* buff, int position);
+ObservationValues parseObservationValues(const string& line, int position);
+
+double parseFixedWidth(const string& line, int position, int width);
+
+E_FType codeFrequency(E_Sys sys, E_ObsCode code);
 
 /**
  * @brief Assign parsed observation value to appropriate signal field
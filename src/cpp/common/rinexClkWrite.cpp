@@ -12,6 +12,7 @@
 #include "common/ephPrecise.hpp"
 #include "common/ephemeris.hpp"
 #include "common/navigation.hpp"
+#include "common/productWriter.hpp"
 #include "common/receiver.hpp"
 #include "common/rinex.hpp"
 #include "common/rinexNavWrite.hpp"
@@ -56,32 +57,40 @@ void outputRinexClocksBody(
 
     GEpoch ep = time;
 
+    // the epoch and data count are common to all lines, format them once
+    int numData = 2;  // Number of data values is 2, clock and sigma.
+
+    string epochStr;
+    appendInt(epochStr, (int)ep[0], 4);
+    appendInt(epochStr, (int)ep[1], 3);
+    appendInt(epochStr, (int)ep[2], 3);
+    appendInt(epochStr, (int)ep[3], 3);
+    appendInt(epochStr, (int)ep[4], 3);
+    appendFixed(epochStr, ep[5], 10, 6);
+    appendInt(epochStr, numData, 3);
+    epochStr += "   ";
+
+    string lines;
+    lines.reserve(clkEntryList.size() * 81);
+
     for (auto& clkEntry : clkEntryList)
     {
-        string dataType;
         if (clkEntry.isRec)
-            dataType = "AR";  // Result for receiver clock.
+            lines += "AR";  // Result for receiver clock.
         else
-            dataType = "AS";  // Result for satellite clock.
-
-        int numData = 2;      // Number of data values is 2, clock and sigma.
-        tracepdeex(
-            0,
-            clockFile,
-            "%2s %-4s %4d%3d%3d%3d%3d%10.6f%3d   %19.12E %19.12E\n",
-            dataType.c_str(),
-            clkEntry.id.c_str(),
-            (int)ep[0],
-            (int)ep[1],
-            (int)ep[2],
-            (int)ep[3],
-            (int)ep[4],
-            ep[5],
-            numData,
-            clkEntry.clock,
-            clkEntry.sigma
-        );
+            lines += "AS";  // Result for satellite clock.
+
+        lines += ' ';
+        appendString(lines, clkEntry.id, 4, true);
+        lines += ' ';
+        lines += epochStr;
+        appendScientific(lines, clkEntry.clock, 19, 12);
+        lines += ' ';
+        appendScientific(lines, clkEntry.sigma, 19, 12);
+        lines += '\n';
     }
+
+    clockFile << lines;
 }
 
 void getKalmanSatClks(ClockList& clkEntryList, map<E_Sys, bool>& outSys, KFState& kfState)
@@ -502,8 +511,15 @@ void outputClocksSet(
             return;
     }
 
-    outputRinexClocksHeader(filename, clkEntryList, referenceRec, outSys, time);
-    outputRinexClocksBody(filename, clkEntryList, time);
+    // the entries are a snapshot of this epoch, the file itself may be written later
+    queueProductOutput(
+        clkProductQueue,
+        [filename, clkEntryList = std::move(clkEntryList), referenceRec, outSys, time]() mutable
+        {
+            outputRinexClocksHeader(filename, clkEntryList, referenceRec, outSys, time);
+            outputRinexClocksBody(filename, clkEntryList, time);
+        }
+    );
 }
 
 map<string, map<E_Sys, bool>>
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <array>
 #include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 #include "common/acsQC.hpp"
 #include "common/common.hpp"
 #include "common/eigenIncluder.hpp"
 #include "common/enums.h"
 #include "common/linearCombo.hpp"
 
+using std::array;
 using std::map;
+using std::unique_ptr;
+using std::vector;
 
 /** Object containing persistent status parameters of individual signals
  */
@@ -33,6 +40,66 @@ struct SigStat
     unsigned int phaseRejectCount = 0;
 };
 
+/** Dense table of the signal status objects of a satellite.
+ *
+ * Preprocessor status is indexed by frequency, and the status of individual signals by observation
+ * code. Entries are created on first access as map entries would be, references to them remain
+ * valid for the life of the table, and iteration visits the created entries in creation order.
+ */
+struct SigStatTable
+{
+    static constexpr int NUM_CODES = 100;  ///< Observation codes are numbered below this
+
+    SigStat& operator[](E_FType ft) { return entry(ft); }
+
+    SigStat& operator[](E_ObsCode code) { return entry(NUM_FTYPES + (int)code); }
+
+    /** Get an entry without creating it, nullptr if it has not been created
+     */
+    SigStat* find(E_FType ft) { return created[ft] ? &sigStats[ft] : nullptr; }
+
+    SigStat* find(E_ObsCode code)
+    {
+        int index = NUM_FTYPES + (int)code;
+        return created[index] ? &sigStats[index] : nullptr;
+    }
+
+    size_t size() const { return order.size(); }
+
+    struct iterator
+    {
+        SigStat*                      base;
+        vector<short>::const_iterator it;
+
+        SigStat&  operator*() const { return base[*it]; }
+        iterator& operator++()
+        {
+            ++it;
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+    };
+
+    iterator begin() { return {sigStats.data(), order.cbegin()}; }
+    iterator end() { return {sigStats.data(), order.cend()}; }
+
+   private:
+    SigStat& entry(int index)
+    {
+        if (created[index] == false)
+        {
+            created[index] = true;
+            order.push_back(index);
+        }
+
+        return sigStats[index];
+    }
+
+    array<SigStat, NUM_FTYPES + NUM_CODES> sigStats = {};
+    array<bool, NUM_FTYPES + NUM_CODES>    created  = {};
+    vector<short>                          order;  ///< Indices of created entries
+};
+
 struct IonoStat
 {
     double ambvar      = 0;
@@ -90,7 +157,90 @@ struct SatStat : IonoStat, QC, AzEl
     double nadir = 0;
     bool   slip  = false;
 
-    map<string, SigStat> sigStatMap;  ///< Map for individual signal status for this SatStat object
+    SigStatTable sigStats;  ///< Table of individual signal status for this SatStat object
+};
+
+/** Dense table of the satellite status objects of a receiver, indexed by a compact satellite slot.
+ *
+ * The table of slots is sized up front, objects are allocated on first access and never moved, so
+ * references to them remain valid. Iteration visits the allocated objects in allocation order.
+ */
+struct SatStatTable
+{
+    static constexpr int MAX_PRN = 256;                   ///< Prns are numbered below this
+    static constexpr int NUM_SYS = (int)E_Sys::COMB + 1;  ///< Systems are numbered below this
+
+    SatStatTable() : slots(NUM_SYS * MAX_PRN) {}
+
+    SatStatTable(const SatStatTable& other) : slots(NUM_SYS * MAX_PRN) { *this = other; }
+
+    SatStatTable& operator=(const SatStatTable& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        for (auto& satStat_ptr : slots)
+            satStat_ptr.reset();
+
+        sats = other.sats;
+        for (auto& Sat : sats)
+        {
+            slots[slot(Sat)] = std::make_unique<SatStat>(*other.slots[slot(Sat)]);
+        }
+
+        return *this;
+    }
+
+    static int slot(SatSys Sat)
+    {
+        if (Sat.prn < 0 || Sat.prn >= MAX_PRN || (int)Sat.sys < 0 || (int)Sat.sys >= NUM_SYS)
+        {
+            throw std::out_of_range("Satellite " + Sat.id() + " outside of status table");
+        }
+
+        return (int)Sat.sys * MAX_PRN + Sat.prn;
+    }
+
+    SatStat& operator[](SatSys Sat)
+    {
+        auto& satStat_ptr = slots[slot(Sat)];
+        if (satStat_ptr == nullptr)
+        {
+            satStat_ptr = std::make_unique<SatStat>();
+            sats.push_back(Sat);
+        }
+
+        return *satStat_ptr;
+    }
+
+    /** Get a satellite's status object without creating it, nullptr if it has not been created
+     */
+    SatStat* find(SatSys Sat) { return slots[slot(Sat)].get(); }
+
+    size_t size() const { return sats.size(); }
+
+    struct iterator
+    {
+        const SatStatTable*            table;
+        vector<SatSys>::const_iterator it;
+
+        SatStat&  operator*() const { return *table->slots[slot(*it)]; }
+        iterator& operator++()
+        {
+            ++it;
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+    };
+
+    iterator begin() const { return {this, sats.cbegin()}; }
+    iterator end() const { return {this, sats.cend()}; }
+
+   private:
+    vector<unique_ptr<SatStat>> slots;  ///< Status objects by satellite slot
+    vector<SatSys>              sats;   ///< Satellites with status objects, in allocation order
 };
 
 string ft2string(E_FType ft);
@@ -1,16 +1,21 @@
 // #pragma GCC optimize ("O0")
 
 #include "common/sinex.hpp"
+#include <boost/algorithm/string.hpp>
 #include <boost/log/trivial.hpp>
+#include <charconv>
 #include <cstring>
 #include <ctype.h>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <stdlib.h>
 #include <string.h>
 #ifndef _WIN32
 #include <sys/utsname.h>
 #endif
 #include "architectureDocs.hpp"
+#include "common/acsConfig.hpp"
 #include "common/algebra.hpp"
 #include "common/eigenIncluder.hpp"
 #include "common/gTime.hpp"
@@ -21,6 +26,8 @@
 using std::getline;
 using std::ifstream;
 using std::ofstream;
+using std::set;
+using std::unordered_map;
 
 /**
  */
@@ -66,6 +73,55 @@ void trimCut(string& line)  ///< string to trim
         line.pop_back();
 }
 
+/** Parses a fixed width numeric field of a line without scanf.
+ * Returns false if the field is missing, blank, or not entirely a number.
+ */
+template <typename TYPE>
+bool parseField(
+    const string& line,   ///< Line to parse from
+    size_t        start,  ///< Column of the start of the field
+    size_t        width,  ///< Width of the field
+    TYPE&         value   ///< Output value
+)
+{
+    if (start >= line.size())
+    {
+        return false;
+    }
+
+    const char* begin = line.data() + start;
+    const char* end   = line.data() + std::min(line.size(), start + width);
+
+    while (begin < end && isspace(*begin))
+        begin++;
+    while (end > begin && isspace(end[-1]))
+        end--;
+
+    if (begin < end && *begin == '+')
+        begin++;
+
+    if (begin == end)
+    {
+        return false;
+    }
+
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+
+    return ec == std::errc() && ptr == end;
+}
+
+/** Parses a fixed column YY:DOY:SOD epoch
+ */
+bool parseYdsField(
+    const string& line,   ///< Line to parse from
+    size_t        start,  ///< Column of the start of the epoch
+    UYds&         yds     ///< Output epoch
+)
+{
+    return parseField(line, start, 2, yds[0]) && parseField(line, start + 3, 3, yds[1]) &&
+           parseField(line, start + 7, 5, yds[2]);
+}
+
 bool compare(string& one, string& two)
 {
     if (one.compare(two) == 0)
@@ -345,27 +401,40 @@ bool compare(SinexSolNeq& one, SinexSolNeq& two)
     return false;
 }
 
-bool compare(SinexSolMatrix& one, SinexSolMatrix& two)
-{
-    if (one.row == two.row && one.col == two.col)
-    {
-        return true;
-    }
-    return false;
-}
-
+// keys used to bucket entries before comparing them for duplicates, each must only use fields
+// that are also checked by the corresponding compare() function
+const string& dedupeKey(string& entry) { return entry; }
+const string& dedupeKey(SinexInputFile& entry) { return entry.file; }
+const string& dedupeKey(SinexSolStatistic& entry) { return entry.name; }
+const string& dedupeKey(SinexSatPc& entry) { return entry.svn; }
+const string& dedupeKey(SinexSatEcc& entry) { return entry.svn; }
+const string& dedupeKey(SinexSatFreqChn& entry) { return entry.svn; }
+const string& dedupeKey(SinexSatId& entry) { return entry.svn; }
+const string& dedupeKey(SinexPreCode& entry) { return entry.precesscode; }
+const string& dedupeKey(SinexSourceId& entry) { return entry.source; }
+const string& dedupeKey(SinexNutCode& entry) { return entry.nutcode; }
+const string& dedupeKey(SinexSatPrn& entry) { return entry.svn; }
+const string& dedupeKey(SinexSatCom& entry) { return entry.svn; }
+const string& dedupeKey(SinexAck& entry) { return entry.agency; }
+const string& dedupeKey(SinexInputHistory& entry) { return entry.contents; }
+
+/** Removes duplicates from an unsorted list, keeping the first of each.
+ * Entries are bucketed by key so that only entries which may be equal are compared.
+ */
 template <typename TYPE>
 void dedupe(list<TYPE>& source)
 {
-    list<TYPE> copy;
+    unordered_map<string, vector<TYPE*>> kept;
 
     for (auto it = source.begin(); it != source.end();)
     {
         bool found = false;
 
-        for (auto it2 = copy.begin(); it2 != copy.end(); it2++)
+        auto& bucket = kept[dedupeKey(*it)];
+
+        for (auto& keptEntry_ptr : bucket)
         {
-            if (compare(*it, *it2))
+            if (compare(*it, *keptEntry_ptr))
             {
                 found = true;
                 break;
@@ -378,7 +447,7 @@ void dedupe(list<TYPE>& source)
         }
         else
         {
-            copy.push_back(*it);
+            bucket.push_back(&*it);
             it++;
         }
     }
@@ -446,17 +515,7 @@ void dedupeSinex()
     dedupeB(theSinex.listgalpcs);
     dedupeB(theSinex.listnormaleqns);
 
-    for (matrix_type t = ESTIMATE; t < MAX_MATRIX_TYPE;
-         t             = static_cast<matrix_type>(static_cast<int>(t) + 1))
-        for (matrix_value v = CORRELATION; v < MAX_MATRIX_VALUE;
-             v              = static_cast<matrix_value>(static_cast<int>(v) + 1))
-        {
-            if (theSinex.matrixmap[t][v].empty())
-                continue;
-
-            dedupeB(theSinex.matrixmap[t][v]);
-        }
-
+    // matrices are deduplicated as they are assembled
     return;
 }
 
@@ -1824,18 +1883,31 @@ void parseSolutionEstimates(string& line)
     sst.ptcode   = line.substr(19, 2);
     sst.solnnum  = line.substr(22, 4);
 
-    sst.index = (int)str2num(buff, 1, 5);
+    sst.unit       = line.substr(40, 4);
+    sst.constraint = line[45];
 
-    int readcount =
-        sscanf(buff + 27, "%2lf:%3lf:%5lf", &sst.refepoch[0], &sst.refepoch[1], &sst.refepoch[2]);
+    bool pass = parseField(line, 1, 5, sst.index) && parseYdsField(line, 27, sst.refepoch) &&
+                parseField(line, 47, 21, sst.estimate) && parseField(line, 69, 11, sst.stddev);
 
-    sst.unit = line.substr(40, 4);
+    if (pass == false)
+    {
+        // not strictly in columns, fall back to the slower, more lenient parser
+        sst.index = (int)str2num(buff, 1, 5);
 
-    sst.constraint = line[45];
+        int readcount = sscanf(
+            buff + 27,
+            "%2lf:%3lf:%5lf",
+            &sst.refepoch[0],
+            &sst.refepoch[1],
+            &sst.refepoch[2]
+        );
 
-    readcount += sscanf(buff + 47, "%21lf %11lf", &sst.estimate, &sst.stddev);
+        readcount += sscanf(buff + 47, "%21lf %11lf", &sst.estimate, &sst.stddev);
 
-    if (readcount == 5)
+        pass = (readcount == 5);
+    }
+
+    if (pass)
     {
         // see comment at top of file
         if (sst.refepoch[0] != 0 || sst.refepoch[1] != 0 || sst.refepoch[2] != 0)
@@ -1963,26 +2035,41 @@ void parseApriori(string& line)
     sst.ptcode     = line.substr(19, 2);
     sst.solnnum    = line.substr(22, 4);
 
-    char unit[5];
+    bool pass = parseYdsField(line, 27, sst.epoch) && parseField(line, 47, 21, sst.param) &&
+                parseField(line, 69, 11, sst.stddev);
 
-    unit[4] = '\0';
+    if (pass)
+    {
+        sst.unit       = trim(line.substr(40, 4));
+        sst.constraint = line[45];
+    }
+    else
+    {
+        // not strictly in columns, fall back to the slower, more lenient parser
+        char unit[5];
 
-    int readcount = sscanf(
-        buff + 27,
-        "%2lf:%3lf:%5lf %4s %c %21lf %11lf",
-        &sst.epoch[0],
-        &sst.epoch[1],
-        &sst.epoch[2],
-        unit,
-        &sst.constraint,
-        &sst.param,
-        &sst.stddev
-    );
+        unit[4] = '\0';
+
+        int readcount = sscanf(
+            buff + 27,
+            "%2lf:%3lf:%5lf %4s %c %21lf %11lf",
+            &sst.epoch[0],
+            &sst.epoch[1],
+            &sst.epoch[2],
+            unit,
+            &sst.constraint,
+            &sst.param,
+            &sst.stddev
+        );
 
-    if (readcount == 7)
-    {
         sst.unit = unit;
 
+        pass = (readcount == 7);
+    }
+
+    if (pass)
+    {
+
         // see comment at top of file
         if (sst.epoch[0] != 0 || sst.epoch[1] != 0 || sst.epoch[2] != 0)
         {
@@ -2096,25 +2183,39 @@ void parseNormals(string& line)
     sst.site    = line.substr(14, 4);
     sst.pt      = line.substr(19, 2);
     sst.solnnum = line.substr(22, 4);
-    char unit[5];
+    bool pass = parseYdsField(line, 27, sst.epoch) && parseField(line, 47, 21, sst.normal);
 
-    unit[4] = '\0';
+    if (pass)
+    {
+        sst.unit       = trim(line.substr(40, 4));
+        sst.constraint = line[45];
+    }
+    else
+    {
+        // not strictly in columns, fall back to the slower, more lenient parser
+        char unit[5];
 
-    int readcount = sscanf(
-        buff + 27,
-        "%2lf:%3lf:%5lf %4s %c %21lf",
-        &sst.epoch[0],
-        &sst.epoch[1],
-        &sst.epoch[2],
-        unit,
-        &sst.constraint,
-        &sst.normal
-    );
+        unit[4] = '\0';
+
+        int readcount = sscanf(
+            buff + 27,
+            "%2lf:%3lf:%5lf %4s %c %21lf",
+            &sst.epoch[0],
+            &sst.epoch[1],
+            &sst.epoch[2],
+            unit,
+            &sst.constraint,
+            &sst.normal
+        );
 
-    if (readcount == 6)
-    {
         sst.unit = unit;
 
+        pass = (readcount == 6);
+    }
+
+    if (pass)
+    {
+
         // see comment at top of file
         if (sst.epoch[0] != 0 || sst.epoch[1] != 0 || sst.epoch[2] != 0)
         {
@@ -2171,52 +2272,64 @@ void writeSnxNormal(ofstream& out, list<SinexRecData>* pstns = nullptr)
     }
 }
 
-matrix_type  mat_type;
-matrix_value mat_value;
+matrix_type  mat_type  = ESTIMATE;
+matrix_value mat_value = COVARIANCE;
+
+set<int> filteredParams;  ///< Parameter indices of the current file dropped by the station filter
 
-void parseMatrix(string& line)  //, matrix_type type, matrix_value value)
+/** Parses a line of a SOLUTION/MATRIX_* block directly into the packed matrix for the block
+ */
+void parseMatrix(string& line)
 {
     const char* buff = line.c_str();
 
-    // 	//todo aaron, this is only half complete, the maxrow/col arent used but should be with
-    // multiple input matrices.
-    int            maxrow = 0;
-    int            maxcol = 0;
-    SinexSolMatrix smt;
-
-    int readcount = sscanf(
-        buff,
-        " %5d %5d %21lf %21lf %21lf",
-        &smt.row,
-        &smt.col,
-        &smt.value[0],
-        &smt.value[1],
-        &smt.value[2]
-    );
+    int    row;
+    int    col;
+    double value[3];
+    int    numvals = 0;
 
-    if (readcount > 2)
+    if (parseField(line, 1, 5, row) && parseField(line, 7, 5, col))
     {
-        if (smt.row < smt.col)
+        for (; numvals < 3; numvals++)
         {
-            // xor swap
-            smt.row ^= smt.col;
-            smt.col ^= smt.row;
-            smt.row ^= smt.col;
+            if (parseField(line, 13 + 22 * numvals, 21, value[numvals]) == false)
+            {
+                break;
+            }
         }
+    }
+    else
+    {
+        // not strictly in columns, fall back to the slower, more lenient parser
+        int readcount = sscanf(
+            buff,
+            " %5d %5d %21lf %21lf %21lf",
+            &row,
+            &col,
+            &value[0],
+            &value[1],
+            &value[2]
+        );
 
-        int covars = readcount - 2;
+        numvals = readcount - 2;
+    }
 
-        for (int i = readcount - 2; i < 3; i++)
-            smt.value[i] = -1;
+    if (numvals <= 0 || filteredParams.count(row))
+    {
+        return;
+    }
 
-        smt.numvals = readcount - 2;
+    auto& matrix = theSinex.matrices[mat_type][mat_value];
 
-        if (smt.row > maxrow)
-            maxrow = smt.row;
-        if (smt.col > maxcol)
-            maxcol = smt.col;
+    for (int i = 0; i < numvals; i++)
+    {
+        if (filteredParams.count(col + i))
+        {
+            continue;
+        }
 
-        theSinex.matrixmap[mat_type][mat_value].push_back(smt);
+        // elements continue along the row, symmetric so it doesnt matter which triangle is given
+        matrix.set(row, col + i, value[i]);
     }
 }
 
@@ -3150,6 +3263,56 @@ void parseSinexSatAttMode(string& line)
 
 void nullFunction(string& line) {}
 
+/** Column of the station code in the lines of a block, or -1 if the block is not keyed by station
+ */
+int sinexSiteColumn(const string& blockName)
+{
+    if (blockName == "SITE/GPS_PHASE_CENTER" || blockName == "SITE/GAL_PHASE_CENTER")
+    {
+        // keyed by antenna type
+        return -1;
+    }
+
+    if (blockName.rfind("SITE/", 0) == 0 || blockName.rfind("MODEL/", 0) == 0 ||
+        blockName == "SOLUTION/EPOCHS" || blockName == "BIAS/EPOCHS" ||
+        blockName == "SOLUTION/DATA_HANDLING")
+    {
+        return 1;
+    }
+
+    if (blockName == "SOLUTION/ESTIMATE" || blockName == "SOLUTION/APRIORI" ||
+        blockName == "SOLUTION/NORMAL_EQUATION_VECTOR")
+    {
+        return 14;
+    }
+
+    return -1;
+}
+
+/** Selects the matrix that following SOLUTION/MATRIX_* lines are assembled into
+ */
+void selectMatrix(
+    matrix_type   type,   ///< Type of matrix block
+    const string& header  ///< Full block header line, eg "+SOLUTION/MATRIX_ESTIMATE L COVA"
+)
+{
+    mat_type = type;
+
+    if (header.find(" CORR") != string::npos)
+        mat_value = CORRELATION;
+    else if (header.find(" COVA") != string::npos)
+        mat_value = COVARIANCE;
+    else
+        mat_value = INFORMATION;  // normal equation matrices have no type
+
+    auto& matrix = theSinex.matrices[mat_type][mat_value];
+
+    if (matrix.empty())
+    {
+        matrix.reserve(theSinex.numparam);
+    }
+}
+
 bool readSinex(const string& filepath)
 {
     // 	BOOST_LOG_TRIVIAL(info)
@@ -3172,8 +3335,18 @@ bool readSinex(const string& filepath)
 
     theSinex.currentFile = filepath;
 
+    set<string> stationFilter;
+    for (auto& id : acsConfig.snx_stations)
+    {
+        stationFilter.insert(boost::to_upper_copy(id.substr(0, 4)));
+    }
+
+    filteredParams.clear();
+
     void (*parseFunction)(string&) = nullFunction;
 
+    int siteColumn = -1;
+
     string closure;
 
     bool failure = false;
@@ -3214,6 +3387,20 @@ bool readSinex(const string& filepath)
         }
         else if (line[0] == ' ')
         {
+            if (siteColumn >= 0 && stationFilter.empty() == false &&
+                line.size() >= siteColumn + 4 &&
+                stationFilter.count(boost::to_upper_copy(trim(line.substr(siteColumn, 4)))) == 0)
+            {
+                // not a requested station, keep track of its parameters to also drop matrix entries
+                int index;
+                if (siteColumn == 14 && parseField(line, 1, 5, index))
+                {
+                    filteredParams.insert(index);
+                }
+
+                continue;
+            }
+
             try
             {
                 // this probably needs specialty parsing - use a prepared function pointer.
@@ -3338,14 +3525,17 @@ bool readSinex(const string& filepath)
             else if (line == "+SOLUTION/MATRIX_ESTIMATE")
             {
                 parseFunction = parseMatrix;
+                selectMatrix(ESTIMATE, closure);
             }
             else if (line == "+SOLUTION/MATRIX_APRIORI")
             {
                 parseFunction = parseMatrix;
+                selectMatrix(APRIORI, closure);
             }
             else if (line == "+SOLUTION/NORMAL_EQUATION_MATRIX")
             {
                 parseFunction = parseMatrix;
+                selectMatrix(NORMAL_EQN, closure);
             }
             else if (line == "+SOLUTION/DATA_HANDLING")
             {
@@ -3401,6 +3591,18 @@ bool readSinex(const string& filepath)
                 BOOST_LOG_TRIVIAL(warning) << "Unknown header line: " << line;
             }  // Skip unknown sections
 
+            string blockName = line.substr(1);
+
+            siteColumn = sinexSiteColumn(blockName);
+
+            if (acsConfig.snx_blocks.empty() == false &&
+                std::find(acsConfig.snx_blocks.begin(), acsConfig.snx_blocks.end(), blockName) ==
+                    acsConfig.snx_blocks.end())
+            {
+                // not a requested block, skip its contents
+                parseFunction = nullFunction;
+            }
+
             // 			int 	i;
             // 									failure = read_snx_matrix			(filestream,
             // NORMAL_EQN, INFORMATION, c);			break; 				case 15: if
@@ -336,18 +336,62 @@ struct SinexSolNeq
 +SOLUTION/MATRIX_ESTIMATE C TYPE (mandatory)
 +SOLUTION/MATRIX_APRIORI C TYPE (recommended)
 +SOLUTION/MATRIX_NORMAL_EQUATION C (mandatory for normal equations)
-* (Not used until I understand it better)
 * C must be L or U (matrix is always symmetric about main diagonal)
 * TYPE must be one of CORR/COVA/INFO for correlation, covariance and info (covariance inverse)
 * APRIORI VALUES are 21.16lf, estimates and normal_equations are 21.14lf!
 *ROW__ COL__ ELEM1________________ ELEM2________________ ELEM3________________
 */
-struct SinexSolMatrix
+/** Symmetric solution matrix, assembled directly into packed lower triangular storage.
+ * Rows and columns are the 1-based parameter indices of the solution/estimate block.
+ * Elements are stored row major, so growing the dimension only appends to the storage.
+ */
+struct SinexPackedMatrix
 {
-    int    row;       // 5 - must match the solution/estimate row
-    int    col;       // 5 - must match the solution/estimate col
-    int    numvals;
-    double value[3];  // each d21.14 cols col, col+1, col+2 of the row
+    int            dim = 0;  ///< Number of rows (and columns) in the matrix
+    vector<double> values;   ///< Packed lower triangle, elements not in the file are zero
+
+    static size_t packedIndex(int row, int col) { return (size_t)row * (row - 1) / 2 + col - 1; }
+
+    bool empty() const { return dim == 0; }
+
+    void reserve(int numParams) { values.reserve((size_t)numParams * (numParams + 1) / 2); }
+
+    void set(int row, int col, double value)
+    {
+        if (row < col)
+        {
+            std::swap(row, col);
+        }
+
+        if (row > dim)
+        {
+            dim = row;
+            values.resize((size_t)dim * (dim + 1) / 2, 0);
+        }
+
+        values[packedIndex(row, col)] = value;
+    }
+
+    double get(int row, int col) const
+    {
+        if (row < col)
+        {
+            std::swap(row, col);
+        }
+
+        if (row > dim || col < 1)
+        {
+            return 0;
+        }
+
+        return values[packedIndex(row, col)];
+    }
+
+    void clear()
+    {
+        dim = 0;
+        values.clear();
+    }
 };
 
 //=============================================================================
@@ -641,7 +685,7 @@ struct Sinex
     map<string, map<string, map<GTime, SinexSolEstimate, std::greater<GTime>>>> estimatesMap;
     map<int, SinexSolApriori>                                                   apriorimap;
     list<SinexSolNeq>                                                           listnormaleqns;
-    map<matrix_value, list<SinexSolMatrix>> matrixmap[MAX_MATRIX_TYPE];
+    SinexPackedMatrix matrices[MAX_MATRIX_TYPE][MAX_MATRIX_VALUE];
     map<string, map<string, map<char, map<GTime, SinexDataHandling, std::greater<GTime>>>>>
         mapdatahandling;
 
@@ -11,6 +11,7 @@
 #include "common/erp.hpp"
 #include "common/mongoRead.hpp"
 #include "common/navigation.hpp"
+#include "common/productWriter.hpp"
 #include "common/receiver.hpp"
 #include "common/rinexClkWrite.hpp"
 #include "common/rinexObsWrite.hpp"
@@ -309,6 +310,9 @@ void updateSp3Body(
 
     // Note position is in kilometers and clock values microseconds.
     // There need to be one entry per satellite in the header for correct file format.
+    string lines;
+    lines.reserve(sp3FileData.sats.size() * 2 * 81);
+
     for (auto& [Sat, enable] : sp3FileData.sats)
     {
         auto it = entryList.find(Sat);
@@ -323,71 +327,61 @@ void updateSp3Body(
                 predictedChar = ' ';
 
             {
-                tracepdeex(
-                    0,
-                    sp3Stream,
-                    "P%s%14.6f%14.6f%14.6f%14.6f%15s%c%3s%c\n",
-                    entry.Sat.id().c_str(),
-                    entry.satPos.x() / 1000,
-                    entry.satPos.y() / 1000,
-                    entry.satPos.z() / 1000,
-                    entry.satClk * 1e6,
-                    "",
-                    predictedChar,
-                    "",
-                    predictedChar
-                );
+                lines += 'P';
+                lines += entry.Sat.id();
+                appendFixed(lines, entry.satPos.x() / 1000, 14, 6);
+                appendFixed(lines, entry.satPos.y() / 1000, 14, 6);
+                appendFixed(lines, entry.satPos.z() / 1000, 14, 6);
+                appendFixed(lines, entry.satClk * 1e6, 14, 6);
+                lines.append(15, ' ');
+                lines += predictedChar;
+                lines.append(3, ' ');
+                lines += predictedChar;
+                lines += '\n';
             }
 
             if (acsConfig.output_sp3_velocities)
             {
-                tracepdeex(
-                    0,
-                    sp3Stream,
-                    "V%s%14.6f%14.6f%14.6f%14.6f%15s%c%3s%c\n",
-                    entry.Sat.id().c_str(),
-                    entry.satVel.x() * 10,
-                    entry.satVel.y() * 10,
-                    entry.satVel.z() * 10,
-                    entry.satClkVel * 1e10,
-                    "",
-                    predictedChar,
-                    "",
-                    predictedChar
-                );
+                lines += 'V';
+                lines += entry.Sat.id();
+                appendFixed(lines, entry.satVel.x() * 10, 14, 6);
+                appendFixed(lines, entry.satVel.y() * 10, 14, 6);
+                appendFixed(lines, entry.satVel.z() * 10, 14, 6);
+                appendFixed(lines, entry.satClkVel * 1e10, 14, 6);
+                lines.append(15, ' ');
+                lines += predictedChar;
+                lines.append(3, ' ');
+                lines += predictedChar;
+                lines += '\n';
             }
         }
         else
         {
             {
-                tracepdeex(
-                    0,
-                    sp3Stream,
-                    "P%s%14.6f%14.6f%14.6f%14.6f\n",
-                    Sat.id().c_str(),
-                    0,
-                    0,
-                    0,
-                    NO_SP3_CLK
-                );
+                lines += 'P';
+                lines += Sat.id();
+                appendFixed(lines, 0, 14, 6);
+                appendFixed(lines, 0, 14, 6);
+                appendFixed(lines, 0, 14, 6);
+                appendFixed(lines, NO_SP3_CLK, 14, 6);
+                lines += '\n';
             }
 
             if (acsConfig.output_sp3_velocities)
             {
-                tracepdeex(
-                    0,
-                    sp3Stream,
-                    "V%s%14.6f%14.6f%14.6f%14.6f\n",
-                    Sat.id().c_str(),
-                    0,
-                    0,
-                    0,
-                    NO_SP3_CLK
-                );
+                lines += 'V';
+                lines += Sat.id();
+                appendFixed(lines, 0, 14, 6);
+                appendFixed(lines, 0, 14, 6);
+                appendFixed(lines, 0, 14, 6);
+                appendFixed(lines, NO_SP3_CLK, 14, 6);
+                lines += '\n';
             }
         }
     }
 
+    sp3Stream << lines;
+
     tracepdeex(0, sp3Stream, "EOF\n");
 }
 
@@ -460,7 +454,12 @@ void writeSysSetSp3(
         entryList[Sat] = entry;
     }
 
-    updateSp3Body(filename, entryList, time, outSys);
+    // the entries are a snapshot of this epoch, the file itself may be written later
+    queueProductOutput(
+        sp3ProductQueue,
+        [filename, entryList = std::move(entryList), time, outSys]() mutable
+        { updateSp3Body(filename, entryList, time, outSys); }
+    );
 }
 
 void outputSp3(
@@ -1,19 +1,73 @@
 #pragma once
 
+#include <chrono>
 #include "common/navigation.hpp"
+#include "common/obsCache.hpp"
 #include "common/rinex.hpp"
 #include "common/streamObs.hpp"
 
 struct RinexParser : Parser, ObsLister
 {
     char                           ctype;
-    double                         version;
+    double                         version = 0;
     E_Sys                          nav_system;
     E_TimeSys                      time_system;
     map<E_Sys, map<int, CodeType>> sysCodeTypes;
     ObsList                        tempObsList;
     RinexStation                   rnxRec = {};
 
+    int    lookaheadEpochs = 1;  ///< Number of epochs to have buffered after each parse
+    size_t maxBufferedObs  = 0;  ///< Stop parsing ahead at this many buffered observations, 0 for none
+
+    string                     sourcePath;  ///< Path of the rinex file being parsed
+    string                     cachePath;   ///< Path of its observation cache, empty to disable
+    unique_ptr<ObsCacheReader> cacheReader_ptr;
+    unique_ptr<ObsCacheWriter> cacheWriter_ptr;
+
+    int    parsedEpochs = 0;  ///< Number of epochs parsed so far, for throughput reporting
+    double parseSeconds = 0;  ///< Time spent parsing epochs so far (s)
+
+    /** Check whether the header has been read, after which parsing only modifies this parser
+     */
+    bool headerRead() { return version > 0; }
+
+    /** Read the header, then use the observation cache for the body if there is a valid one,
+     * or start writing one otherwise. Only rinex 3+ files are cached, as the conversion of
+     * rinex 2 codes depends on the configuration.
+     */
+    void openObsCache(std::istream& inputStream)
+    {
+        readRnxH(inputStream, version, ctype, nav_system, time_system, sysCodeTypes, nav, rnxRec);
+
+        if (ctype != 'O' || version <= 2.99)
+        {
+            return;
+        }
+
+        cacheReader_ptr = make_unique<ObsCacheReader>();
+        if (cacheReader_ptr->open(cachePath, sourcePath))
+        {
+            BOOST_LOG_TRIVIAL(info) << "Reading observations for " << sourcePath << " from cache "
+                                    << cachePath;
+            return;
+        }
+
+        cacheReader_ptr.reset();
+
+        cacheWriter_ptr = make_unique<ObsCacheWriter>();
+        if (cacheWriter_ptr->open(cachePath, sourcePath) == false)
+        {
+            cacheWriter_ptr.reset();
+        }
+    }
+
+    void reportThroughput(const char* source)
+    {
+        BOOST_LOG_TRIVIAL(info) << "Parsed " << parsedEpochs << " epochs of " << sourcePath
+                                << " from " << source << " in " << parseSeconds << "s ("
+                                << parsedEpochs / std::max(parseSeconds, 1e-9) << " epochs/s)";
+    }
+
     void parse(std::istream& inputStream)
     {
         // read some of the input,(up to next epoch header?)
@@ -21,27 +75,93 @@ struct RinexParser : Parser, ObsLister
         // eg. header metadata
         // eg. list of (ObsLists) with multiple sats, signals combined for each epoch.
 
-        int stat = 0;
-        // account for rinex comment in the middle of the file
-        while (stat <= 0 && inputStream)
+        size_t bufferedObs = 0;
+        for (auto& obsList : obsListList)
         {
-            stat = readRnx(
-                inputStream,
-                ctype,
-                tempObsList,
-                nav,
-                rnxRec,
-                version,
-                nav_system,
-                time_system,
-                sysCodeTypes
-            );
+            bufferedObs += obsList.size();
         }
 
-        if (tempObsList.size() > 0)
+        if (cachePath.empty() == false && inputStream.tellg() == 0)
         {
+            openObsCache(inputStream);
+        }
+
+        // always read at least one epoch, then continue until the lookahead is filled
+        do
+        {
+            auto        startTime = std::chrono::steady_clock::now();
+            const char* finished  = nullptr;
+
+            if (cacheReader_ptr)
+            {
+                bool more = cacheReader_ptr->readEpoch(tempObsList);
+                if (more == false)
+                {
+                    // the body of the rinex file is not needed, mark it as finished
+                    finished = "cache";
+
+                    cacheReader_ptr.reset();
+                    inputStream.setstate(std::ios::eofbit);
+                }
+            }
+            else
+            {
+                int stat = 0;
+                // account for rinex comment in the middle of the file
+                while (stat <= 0 && inputStream)
+                {
+                    stat = readRnx(
+                        inputStream,
+                        ctype,
+                        tempObsList,
+                        nav,
+                        rnxRec,
+                        version,
+                        nav_system,
+                        time_system,
+                        sysCodeTypes
+                    );
+                }
+
+                if (cacheWriter_ptr && tempObsList.empty() == false)
+                {
+                    cacheWriter_ptr->writeEpoch(tempObsList);
+                }
+
+                if (cacheWriter_ptr && inputStream.eof())
+                {
+                    finished = "rinex";
+
+                    cacheWriter_ptr->finish();
+                    cacheWriter_ptr.reset();
+                }
+            }
+
+            parseSeconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+            if (tempObsList.empty() == false)
+            {
+                parsedEpochs++;
+            }
+
+            if (finished)
+            {
+                reportThroughput(finished);
+            }
+
+            if (tempObsList.empty())
+            {
+                break;
+            }
+
+            bufferedObs += tempObsList.size();
+
             obsListList.push_back(std::move(tempObsList));
+            tempObsList.clear();
         }
+        while (inputStream && obsListList.size() < lookaheadEpochs &&
+               (maxBufferedObs == 0 || bufferedObs < maxBufferedObs));
     }
 
     string parserType() { return "RinexParser"; }
@@ -625,18 +625,23 @@ VectorEnu tideOceanLoadAdjusted(
     return denu;
 }
 
-/** Displacement by ocean tide loading with HARDISP
+/** Displacement by ocean tide loading with HARDISP, at a set of equally spaced epochs.
+ * The constituent admittances are interpolated once and shared by all epochs.
  * See ref [1] 7.1.2, [5], [7]
  */
-VectorEnu tideOceanLoadHardisp(
-    Trace&   trace,           ///< Trace to output to
-    GTime    time,            ///< GPS time
-    TideMap& otlDisplacement  ///< OTL displacements in amplitude and phase
+vector<VectorEnu> tideOceanLoadHardisp(
+    Trace&   trace,            ///< Trace to output to
+    GTime    time,             ///< GPS time of first epoch
+    TideMap& otlDisplacement,  ///< OTL displacements in amplitude and phase
+    int      count,            ///< Number of epochs
+    double   interval          ///< Spacing of epochs (s)
 )
 {
-    if (otlDisplacement.empty())
+    vector<VectorEnu> denus(count);
+
+    if (otlDisplacement.empty() || count <= 0)
     {
-        return VectorEnu();
+        return denus;
     }
 
     tracepdeex(4, trace, "\n%s:\n", __FUNCTION__);
@@ -659,20 +664,35 @@ VectorEnu tideOceanLoadHardisp(
             break;
     }
 
-    double du[1];
-    double dn[1];
-    double de[1];
+    vector<double> du(count);
+    vector<double> dn(count);
+    vector<double> de(count);
 
-    iers2010::hisp::hardisp_impl(1, 0, tamp, tph, time, du, dn, de);
+    iers2010::hisp::hardisp_impl(count, interval, tamp, tph, time, du.data(), dn.data(), de.data());
 
-    VectorEnu denu;
-    denu.e() = de[0];
-    denu.n() = dn[0];
-    denu.u() = du[0];
+    for (int j = 0; j < count; j++)
+    {
+        auto& denu = denus[j];
+        denu.e()   = de[j];
+        denu.n()   = dn[j];
+        denu.u()   = du[j];
 
-    tracepdeex(5, trace, "%s: denu=%.3f %.3f %.3f\n", __FUNCTION__, denu[0], denu[1], denu[2]);
+        tracepdeex(5, trace, "%s: denu=%.3f %.3f %.3f\n", __FUNCTION__, denu[0], denu[1], denu[2]);
+    }
 
-    return denu;
+    return denus;
+}
+
+/** Displacement by ocean tide loading with HARDISP
+ * See ref [1] 7.1.2, [5], [7]
+ */
+VectorEnu tideOceanLoadHardisp(
+    Trace&   trace,           ///< Trace to output to
+    GTime    time,            ///< GPS time
+    TideMap& otlDisplacement  ///< OTL displacements in amplitude and phase
+)
+{
+    return tideOceanLoadHardisp(trace, time, otlDisplacement, 1, 0).front();
 }
 
 /** Displacement by atmospheric tide loading
@@ -869,31 +889,21 @@ VectorEnu tideOceanPole(
     return denu;
 }
 
-/* Tidal displacement by Earth tides
+/** Tidal displacements by Earth tides at a set of equally spaced epochs
  * See ref [1] 7.1
  */
-void tideDisp(
-    Trace&    trace,   ///< Trace to output to
-    GTime     time,    ///< GPS time
-    string    id,      ///< Receiver id
-    Vector3d& recPos,  ///< Receiver position in ECEF (m)
-    Vector3d& solid,   ///< Displacement by solid Earth tide
-    Vector3d& otl,     ///< Displacement by ocean tide
-    Vector3d& atl,     ///< Displacement by atmospheric tide
-    Vector3d& spole,   ///< Displacement by solid Earth pole tide
-    Vector3d& opole    ///< Displacement by ocean pole tide
+void tideDispNodes(
+    Trace&              trace,     ///< Trace to output to
+    GTime               start,     ///< GPS time of first epoch
+    double              interval,  ///< Spacing of epochs (s)
+    int                 count,     ///< Number of epochs
+    string              id,        ///< Receiver id
+    Vector3d&           recPos,    ///< Receiver position in ECEF (m)
+    vector<TideMatrix>& nodes      ///< Output displacements for each epoch
 )
 {
-    int lv = 3;
+    nodes.assign(count, TideMatrix::Zero());
 
-    string timeStr = time.to_string();
-
-    tracepdeex(lv, trace, "\n\n%s: time=%s", __FUNCTION__, time.to_string().c_str());
-
-    ERPValues erpv = getErp(nav.erp, time);
-
-    MjDateTT  mjdTT(time);
-    MjDateUt1 mjdUt1(time, erpv.ut1Utc);
     if (recPos.isZero())
         return;
 
@@ -901,16 +911,6 @@ void tideDisp(
 
     auto& recOpts = acsConfig.getRecOpts(id);
 
-    VectorEcef rSun;
-    VectorEcef rMoon;
-
-    if (recOpts.tideModels.solid)
-    {
-        // Sun and Moon positions in ECEF
-        planetPosEcef(time, E_ThirdBody::MOON, rMoon, erpv);
-        planetPosEcef(time, E_ThirdBody::SUN, rSun, erpv);
-    }
-
     auto& otlMap = otlDisplacementMap[id];
     auto& atlMap = atlDisplacementMap[id];
 
@@ -919,30 +919,178 @@ void tideDisp(
     if (recOpts.tideModels.atl && atlMap.empty())
         BOOST_LOG_TRIVIAL(warning) << "No atl parameters found for " << id;
 
-    if (recOpts.tideModels.solid)
+    vector<VectorEnu> otlDenus;
+    if (recOpts.tideModels.otl)
     {
-        solid = tideSolidEarthDehant(trace, time, rSun, rMoon, recPos);
+        otlDenus = tideOceanLoadHardisp(trace, start, otlMap, count, interval);
     }
-    if (recOpts.tideModels.otl)
+
+    for (int i = 0; i < count; i++)
     {
-        VectorEnu denu = tideOceanLoadHardisp(trace, time, otlMap);
-        otl            = (Vector3d)enu2ecef(pos, denu);
+        GTime time = start + i * interval;
+        auto& node = nodes[i];
+
+        ERPValues erpv = getErp(nav.erp, time);
+
+        MjDateTT  mjdTT(time);
+        MjDateUt1 mjdUt1(time, erpv.ut1Utc);
+
+        if (recOpts.tideModels.solid)
+        {
+            // Sun and Moon positions in ECEF
+            VectorEcef rSun;
+            VectorEcef rMoon;
+            planetPosEcef(time, E_ThirdBody::MOON, rMoon, erpv);
+            planetPosEcef(time, E_ThirdBody::SUN, rSun, erpv);
+
+            node.col(TIDE_SOLID) = tideSolidEarthDehant(trace, time, rSun, rMoon, recPos);
+        }
+        if (recOpts.tideModels.otl)
+        {
+            node.col(TIDE_OTL) = (Vector3d)enu2ecef(pos, otlDenus[i]);
+        }
+        if (recOpts.tideModels.atl)
+        {
+            VectorEnu denu              = tideAtmosLoad(trace, mjdUt1, atlMap);
+            node.col(TIDE_ATL) = (Vector3d)enu2ecef(pos, denu);
+        }
+        if (recOpts.tideModels.spole)
+        {
+            VectorEnu denu                = tideSolidPole(trace, mjdTT, pos, erpv);
+            node.col(TIDE_SPOLE) = (Vector3d)enu2ecef(pos, denu);
+        }
+        if (recOpts.tideModels.opole)
+        {
+            VectorEnu denu                = tideOceanPole(trace, mjdTT, pos, erpv);
+            node.col(TIDE_OPOLE) = (Vector3d)enu2ecef(pos, denu);
+        }
     }
-    if (recOpts.tideModels.atl)
+}
+
+/** Interpolate tidal displacements from nodes evaluated on a uniform grid of epochs.
+ * Nodes are evaluated in blocks as required and kept until they are no longer needed.
+ */
+TideMatrix TideInterpolator::interpolate(
+    Trace&    trace,   ///< Trace to output to
+    GTime     time,    ///< GPS time
+    string    id,      ///< Receiver id
+    Vector3d& recPos,  ///< Receiver position in ECEF (m)
+    double    spacing  ///< Spacing of nodes (s)
+)
+{
+    if (spacing != interval || (recPos - nodePos).norm() > TIDE_NODE_POSITION_TOLERANCE)
     {
-        VectorEnu denu = tideAtmosLoad(trace, mjdUt1, atlMap);
-        atl            = (Vector3d)enu2ecef(pos, denu);
+        nodeMap.clear();
+        interval = spacing;
+        nodePos  = recPos;
     }
-    if (recOpts.tideModels.spole)
+
+    long   index = (long)floor(time.bigTime / interval);
+    double x     = (double)(time.bigTime - index * (long double)interval) / interval;
+
+    TideMatrix disp = TideMatrix::Zero();
+
+    for (int k = TIDE_NODES_BEFORE; k <= TIDE_NODES_AFTER; k++)
     {
-        VectorEnu denu = tideSolidPole(trace, mjdTT, pos, erpv);
-        spole          = (Vector3d)enu2ecef(pos, denu);
+        long nodeIndex = index + k;
+
+        auto it = nodeMap.find(nodeIndex);
+        if (it == nodeMap.end())
+        {
+            // evaluate the whole block containing the missing node in one go
+            long blockStart = (long)floor((double)nodeIndex / TIDE_BLOCK_NODES) * TIDE_BLOCK_NODES;
+
+            GTime blockTime;
+            blockTime.bigTime = blockStart * (long double)interval;
+
+            vector<TideMatrix> nodes;
+            tideDispNodes(trace, blockTime, interval, TIDE_BLOCK_NODES, id, nodePos, nodes);
+
+            for (int i = 0; i < TIDE_BLOCK_NODES; i++)
+            {
+                nodeMap[blockStart + i] = nodes[i];
+            }
+
+            it = nodeMap.find(nodeIndex);
+        }
+
+        auto& [dummy, node] = *it;
+
+        // lagrange basis polynomial for this node
+        double basis = 1;
+        for (int j = TIDE_NODES_BEFORE; j <= TIDE_NODES_AFTER; j++)
+        {
+            if (j != k)
+            {
+                basis *= (x - j) / (k - j);
+            }
+        }
+
+        disp += basis * node;
     }
-    if (recOpts.tideModels.opole)
+
+    // forget nodes that are no longer needed
+    nodeMap.erase(nodeMap.begin(), nodeMap.lower_bound(index - TIDE_BLOCK_NODES));
+
+    return disp;
+}
+
+/* Tidal displacement by Earth tides
+ * See ref [1] 7.1
+ */
+void tideDisp(
+    Trace&            trace,         ///< Trace to output to
+    GTime             time,          ///< GPS time
+    string            id,            ///< Receiver id
+    Vector3d&         recPos,        ///< Receiver position in ECEF (m)
+    Vector3d&         solid,         ///< Displacement by solid Earth tide
+    Vector3d&         otl,           ///< Displacement by ocean tide
+    Vector3d&         atl,           ///< Displacement by atmospheric tide
+    Vector3d&         spole,         ///< Displacement by solid Earth pole tide
+    Vector3d&         opole,         ///< Displacement by ocean pole tide
+    TideInterpolator* interpolator_ptr  ///< Optional interpolator to use instead of evaluating the models directly
+)
+{
+    int lv = 3;
+
+    string timeStr = time.to_string();
+
+    tracepdeex(lv, trace, "\n\n%s: time=%s", __FUNCTION__, time.to_string().c_str());
+
+    if (recPos.isZero())
+        return;
+
+    auto& recOpts = acsConfig.getRecOpts(id);
+
+    TideMatrix disp;
+    if (interpolator_ptr && recOpts.tideModels.interpolation_interval > 0)
     {
-        VectorEnu denu = tideOceanPole(trace, mjdTT, pos, erpv);
-        opole          = (Vector3d)enu2ecef(pos, denu);
+        disp = interpolator_ptr->interpolate(
+            trace,
+            time,
+            id,
+            recPos,
+            recOpts.tideModels.interpolation_interval
+        );
     }
+    else
+    {
+        vector<TideMatrix> nodes;
+        tideDispNodes(trace, time, 0, 1, id, recPos, nodes);
+
+        disp = nodes.front();
+    }
+
+    if (recOpts.tideModels.solid)
+        solid = disp.col(TIDE_SOLID);
+    if (recOpts.tideModels.otl)
+        otl = disp.col(TIDE_OTL);
+    if (recOpts.tideModels.atl)
+        atl = disp.col(TIDE_ATL);
+    if (recOpts.tideModels.spole)
+        spole = disp.col(TIDE_SPOLE);
+    if (recOpts.tideModels.opole)
+        opole = disp.col(TIDE_OPOLE);
 
     tracepdeex(
         lv,
@@ -35,19 +35,6 @@ int nitem(const double* range)
     return getindex(range[1], range) + 1;
 }
 
-/* data index (i:lat,j:lon,k:hgt)
- */
-int dataindex(int i, int j, int k,
-              const int* ndata)  // todo aaron, convert to maps
-{
-    if (i < 0 || ndata[0] <= i || j < 0 || ndata[1] <= j || k < 0 || ndata[2] <= k)
-    {
-        return -1;
-    }
-
-    return i + ndata[0] * (j + ndata[1] * k);
-}
-
 /** read ionex dcb aux data
  */
 void readionexdcb(std::ifstream& in, Navigation* navi)
@@ -313,6 +300,9 @@ int readionexb(
     GTime time = {};
     int   type = 0;
 
+    TEC*   epochTec_ptr = nullptr;
+    double scale        = pow(10, nexp);
+
     // if (fdebug)
     // 	fprintf(fdebug, "readionexb:\n");
 
@@ -329,6 +319,7 @@ int readionexb(
         {
             type         = 1;
             time.bigTime = 0;
+            epochTec_ptr = nullptr;
         }
         else if (strstr(label, "END OF TEC MAP") == label)
         {
@@ -343,6 +334,7 @@ int readionexb(
         {
             type         = 2;
             time.bigTime = 0;
+            epochTec_ptr = nullptr;
         }
         else if (strstr(label, "END OF RMS MAP") == label)
         {
@@ -362,6 +354,7 @@ int readionexb(
             }
 
             auto& epochTec = navi->tecMap[time];
+            epochTec_ptr   = &epochTec;
 
             if (type == 1)
             {
@@ -389,7 +382,7 @@ int readionexb(
                 );
             }
         }
-        else if (strstr(label, "LAT/LON1/LON2/DLON/H") == label && time.bigTime && type)
+        else if (strstr(label, "LAT/LON1/LON2/DLON/H") == label && epochTec_ptr && type)
         {
             double lon[3];
             double lat = str2num(buff, 2, 6);
@@ -402,7 +395,7 @@ int readionexb(
             int k = getindex(hgt, hgts);
             int n = nitem(lon);
 
-            auto& epochTec = navi->tecMap[time];
+            auto& epochTec = *epochTec_ptr;
 
             for (int m = 0; m < n; m++)
             {
@@ -413,7 +406,7 @@ int readionexb(
 
                 int j = getindex(lon[0] + lon[2] * m, lons);
 
-                int index = dataindex(i, j, k, epochTec.ndata);
+                int index = epochTec.gridIndex(i, j, k);
                 if (index < 0)
                     continue;
 
@@ -422,9 +415,9 @@ int readionexb(
                     continue;
 
                 if (type == 1)
-                    epochTec.tecPointVector[index].data = x * pow(10, nexp);
+                    epochTec.tecPointVector[index].data = x * scale;
                 if (type == 2)
-                    epochTec.tecPointVector[index].rms = x * pow(10, nexp);
+                    epochTec.tecPointVector[index].rms = x * scale;
             }
         }
     }
@@ -23,19 +23,68 @@ map<string, long> endLinePos;
 
 static int ionexMapIndex = 0;
 
-double
-ionVtec(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& vtecstd, KFState& kfState)
+bool ionVtecCoefs(Trace& trace, GTime time, VectorPos& ionPP, int layer, vector<double>& coefs)
 {
     switch (acsConfig.ionModelOpts.model)
     {
         case E_IonoModel::SPHERICAL_HARMONICS:
-            return ionVtecSphhar(trace, time, ionPP, layer, vtecstd, kfState);
+            return ionVtecCoefsSphhar(trace, time, ionPP, layer, coefs);
         case E_IonoModel::SPHERICAL_CAPS:
-            return ionVtecSphcap(trace, time, ionPP, layer, vtecstd, kfState);
+            return ionVtecCoefsSphcap(trace, time, ionPP, layer, coefs);
         case E_IonoModel::BSPLINE:
-            return ionVtecBsplin(trace, time, ionPP, layer, vtecstd, kfState);
+            return ionVtecCoefsBsplin(trace, time, ionPP, layer, coefs);
         default:
-            return 0;
+            return false;
+    }
+}
+
+/** Evaluate the VTEC and its variance at every node of one layer of the IONEX grid.
+ * Each latitude row is evaluated at once, as products of the row's design matrix with the model
+ * state values and variances, which are gathered from the filter only once per epoch.
+ */
+void ionVtecGrid(
+    Trace&          trace,      ///< Trace to output to
+    GTime           time,       ///< Time of the map
+    int             layer,      ///< Layer number
+    const VectorXd& stateVals,  ///< Values of the model states, indexed by basis function number
+    const VectorXd& stateVars,  ///< Variances of the model states
+    MatrixXd&       vtecGrid,   ///< Output VTEC, indexed by latitude row and longitude column
+    MatrixXd&       varGrid     ///< Output VTEC variance
+)
+{
+    int numBasis = stateVals.rows();
+
+    vtecGrid = MatrixXd::Zero(ionexLatres, ionexLonres);
+    varGrid  = MatrixXd::Zero(ionexLatres, ionexLonres);
+
+    MatrixXd       rowCoefs(ionexLonres, numBasis);
+    vector<double> coefs;
+
+    for (int ilat = 0; ilat < ionexLatres; ilat++)
+    {
+        rowCoefs.setZero();
+
+        VectorPos ipp;
+        ipp[0] = (ionexLatmin + (ionexLatres - ilat - 1) * ionexLatinc) * D2R;
+
+        for (int ilon = 0; ilon < ionexLonres; ilon++)
+        {
+            ipp[1] = (ionexLonmin + ilon * ionexLoninc) * D2R;
+
+            bool pass = ionVtecCoefs(trace, time, ipp, layer, coefs);
+            if (pass == false)
+            {
+                continue;
+            }
+
+            for (int i = 0; i < numBasis && i < coefs.size(); i++)
+            {
+                rowCoefs(ilon, i) = coefs[i];
+            }
+        }
+
+        vtecGrid.row(ilat) = (rowCoefs * stateVals).transpose();
+        varGrid.row(ilat)  = (rowCoefs.cwiseAbs2() * stateVars).transpose();
     }
 }
 
@@ -148,17 +197,35 @@ void writeIonexEpoch(Trace& trace, Trace& ionex, GTime time, KFState& kfState)
 
     vector<double> tecrmsList;
 
+    // gather the model states once, rather than for every basis function at every grid node
+    int      numBasis  = acsConfig.ionModelOpts.numBasis;
+    VectorXd stateVals = VectorXd::Zero(numBasis);
+    VectorXd stateVars = VectorXd::Zero(numBasis);
+
+    for (int i = 0; i < numBasis; i++)
+    {
+        KFKey key;
+        key.type = KF::IONOSPHERIC;
+        key.num  = i;
+
+        kfState.getKFValue(key, stateVals(i), &stateVars(i));
+    }
+
     for (int ihgt = 0; ihgt < acsConfig.ionModelOpts.layer_heights.size(); ihgt++)
+    {
+        MatrixXd vtecGrid;
+        MatrixXd varGrid;
+        ionVtecGrid(trace, time, ihgt, stateVals, stateVars, vtecGrid, varGrid);
+
         for (int ilat = 0; ilat < ionexLatres; ilat++)
         {
-            VectorPos ipp;
-            ipp[0] = ionexLatmin + (ionexLatres - ilat - 1) * ionexLatinc;
+            double lat = ionexLatmin + (ionexLatres - ilat - 1) * ionexLatinc;
 
             tracepdeex(
                 0,
                 ionex,
                 "  %6.1f%6.1f%6.1f%6.1f%6.1f%28sLAT/LON1/LON2/DLON/H",
-                ipp[0],
+                lat,
                 ionexLonmin,
                 ionexLonmin + (ionexLonres - 1) * ionexLoninc,
                 ionexLoninc,
@@ -166,24 +233,20 @@ void writeIonexEpoch(Trace& trace, Trace& ionex, GTime time, KFState& kfState)
                 " "
             );
 
-            ipp[0] *= D2R;
-
             for (int ilon = 0; ilon < ionexLonres; ilon++)
             {
                 if (ilon % 16 == 0)
                     tracepdeex(0, ionex, "\n");
 
-                ipp[1] = (ionexLonmin + ilon * ionexLoninc) * D2R;
-
-                double var  = 0;
-                double iono = ionVtec(trace, time, ipp, ihgt, var, kfState) / pow(10, IONEX_NEXP);
+                double var  = varGrid(ilat, ilon);
+                double iono = vtecGrid(ilat, ilon) / pow(10, IONEX_NEXP);
 
                 tracepdeex(
                     5,
                     std::cout,
                     "IPP: %8.4f,%9.4f; layr: %1d; delay: %12.6f; var: %.4e\n",
-                    ipp[0] * R2D,
-                    ipp[1] * R2D,
+                    lat,
+                    ionexLonmin + ilon * ionexLoninc,
                     ihgt,
                     iono,
                     var
@@ -211,6 +274,7 @@ void writeIonexEpoch(Trace& trace, Trace& ionex, GTime time, KFState& kfState)
 
             tracepdeex(0, ionex, "\n");
         }
+    }
 
     tracepdeex(0, ionex, "%6d%54sEND OF TEC MAP\n", ionexMapIndex, " ");
     tracepdeex(0, ionex, "%6d%54sSTART OF RMS MAP\n", ionexMapIndex, " ");
@@ -179,48 +179,48 @@ double ionCoefBsplin(Trace& trace, int ind, IonoObs& obs, bool slant)
     return out;
 }
 
-/** Estimate Ionosphere VTEC using Ionospheric gridmaps
+/** Evaluates all B-splines basis functions for an observation in one pass
+ */
+void ionCoefsBsplin(
+    Trace&          trace,
+    IonoObs&        obs,    ///< Ionosphere measurement struct
+    vector<double>& coefs,  ///< Output coefficients, indexed by basis function number
+    bool            slant   ///< state to delay gain; false: state to VTEC gain
+)
+{
+    coefs.assign(acsConfig.ionModelOpts.numBasis, 0);
+
+    for (int ind = 0; ind < coefs.size() && ind < bspBasisMap.size(); ind++)
+    {
+        coefs[ind] = ionCoefBsplin(trace, ind, obs, slant);
+    }
+}
+
+/** Basis function coefficients for the VTEC of one layer of the B-spline model
     Ion_pp				I		Ionosphere Piercing Point
     layer				I 		Layer number
-    vari				O		variance of VTEC
-returns: VETC at piercing point
+    coefs				O		coefficients, zero for basis functions of other layers
+returns: false if the piercing point is outside of the model
 */
-double
-ionVtecBsplin(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& var, KFState& kfState)
+bool ionVtecCoefsBsplin(Trace& trace, GTime time, VectorPos ionPP, int layer, vector<double>& coefs)
 {
-    var = 0;
-
     if (ippCheckBsplin(time, ionPP) == false)
     {
-        return 0;
+        return false;
     }
 
-    double iono = 0;
-    GObs   tmpobs;
+    IonoObs tmpobs;
     tmpobs.ippMap[layer].latDeg      = ionPP.latDeg();
     tmpobs.ippMap[layer].lonDeg      = ionPP.lonDeg();
     tmpobs.ippMap[layer].slantFactor = 1;
 
-    for (int ind = 0; ind < acsConfig.ionModelOpts.numBasis; ind++)
-    {
-        auto& basis = bspBasisMap[ind];
-
-        if (basis.ind != layer)
-            continue;
-
-        double coef = ionCoefBsplin(trace, ind, tmpobs, false);
+    coefs.assign(acsConfig.ionModelOpts.numBasis, 0);
 
-        KFKey keyC;
-        keyC.type = KF::IONOSPHERIC;
-        keyC.num  = ind;
-
-        double kfval = 0;
-        double kfvar = 0;
-        kfState.getKFValue(keyC, kfval, &kfvar);
-
-        iono += coef * kfval;
-        var += SQR(coef) * kfvar;
+    for (auto& [ind, basis] : bspBasisMap)
+    {
+        if (ind < coefs.size() && basis.ind == layer)
+            coefs[ind] = ionCoefBsplin(trace, ind, tmpobs, false);
     }
 
-    return iono;
+    return true;
 }
@@ -2,6 +2,8 @@
 
 #include "iono/ionoModel.hpp"
 #include <map>
+#include <set>
+#include <sstream>
 #include <string>
 #include "common/acsConfig.hpp"
 #include "common/algebra.hpp"
@@ -10,6 +12,7 @@
 #include "common/receiver.hpp"
 
 using std::map;
+using std::set;
 using std::string;
 
 /* Global parameters */
@@ -73,6 +76,176 @@ double ionModelCoef(Trace& trace, int ind, IonoObs& obs, bool slant)
     }
 }
 
+/** Evaluate all basis functions of the ionosphere model for an observation, for a row of the design
+ * matrix. Reentrant, so may be used while building measurements for receivers in parallel.
+ */
+void ionModelCoefs(
+    Trace&          trace,
+    IonoObs&        obs,    ///< Ionospheric observation metadata
+    vector<double>& coefs,  ///< Output coefficients, indexed by basis function number
+    bool            slant   ///< false: coefficients for VTEC, true: coefficients for STEC
+)
+{
+    switch (acsConfig.ionModelOpts.model)
+    {
+        case E_IonoModel::SPHERICAL_HARMONICS:
+            return ionCoefsSphhar(trace, obs, coefs, slant);
+        case E_IonoModel::SPHERICAL_CAPS:
+            return ionCoefsSphcap(trace, obs, coefs, slant);
+        case E_IonoModel::BSPLINE:
+            return ionCoefsBsplin(trace, obs, coefs, slant);
+        default:
+            break;
+    }
+
+    coefs.resize(acsConfig.ionModelOpts.numBasis);
+    for (int i = 0; i < coefs.size(); i++)
+    {
+        coefs[i] = ionModelCoef(trace, i, obs, slant);
+    }
+}
+
+/** Ionosphere measurements for a single receiver, kept separate until they are merged in order
+ */
+struct IonoRecMeasurements
+{
+    KFMeasEntryList    kfMeasEntryList;  ///< Measurements from this receiver
+    std::ostringstream trace;            ///< Trace output generated while building measurements
+    set<int>           usedBasis;        ///< Basis functions observed by this receiver
+};
+
+/** Build the ionosphere measurements and design matrix entries for a single receiver.
+ * Shared maps are only read and filter states are added under the filter's lock, so this may be
+ * called for many receivers in parallel.
+ */
+void ionRecMeasurements(
+    Receiver&               rec,           ///< Receiver to build measurements for
+    KFState&                kfState,       ///< Filter state
+    const map<E_Sys, int>&  recSysCount,   ///< Number of valid satellites per system for receiver
+    const map<E_Sys, bool>& reset_DCBs,    ///< Systems with a change of reference receiver
+    const map<E_Sys, int>&  mainObsCombo,  ///< Code combination of the reference receiver
+    IonoRecMeasurements&    recMeas        ///< Output measurements for this receiver
+)
+{
+    Trace& trace = recMeas.trace;
+
+    auto& recOpts = acsConfig.getRecOpts(rec.id);
+
+    vector<double> coefs;
+
+    for (auto& obs : only<GObs>(rec.obsList))
+    {
+        E_Sys sys = obs.Sat.sys;
+
+        auto& satOpts = acsConfig.getSatOpts(obs.Sat);
+
+        if (obs.ionExclude)
+        {
+            continue;
+        }
+        if (obs.stecType <= 0)
+        {
+            continue;
+        }
+
+        auto countIt = recSysCount.find(sys);
+        if (countIt == recSysCount.end() || countIt->second < MIN_NSAT_REC)
+        {
+            continue;
+        }
+
+        /************ Ionosphere Measurements ************/
+        KFKey obsKey;
+        obsKey.Sat = obs.Sat;
+        obsKey.str = rec.id;
+
+        KFMeasEntry meas(&kfState, obsKey);
+        meas.setValue(obs.stecVal);
+        meas.setNoise(obs.stecVar);
+
+        /************ receiver DCB ************/ /* We may need to change this for multi-code
+                                                    solutions */
+        SatSys sat0;
+        sat0.sys = sys;
+        sat0.prn = 0;
+
+        KFKey recDCBKey;
+        recDCBKey.type = KF::CODE_BIAS;
+        recDCBKey.str  = rec.id;
+        recDCBKey.Sat  = sat0;
+        recDCBKey.num  = obs.stecCodeCombo;
+
+        auto resetIt = reset_DCBs.find(sys);
+        if (resetIt != reset_DCBs.end() && resetIt->second)
+            kfState.removeState(recDCBKey);
+
+        auto refIt = ionRefRec.find(sys);
+        bool isRef = refIt != ionRefRec.end() && refIt->second == rec.id;
+
+        InitialState init = initialStateFromConfig(recOpts.code_bias);
+        if (isRef == false)
+            meas.addDsgnEntry(recDCBKey, 1, init);
+
+        /************ satellite DCB ************/ /* We may need to change this for multi-code
+                                                     solutions */
+        auto comboIt   = mainObsCombo.find(sys);
+        int  mainCombo = comboIt != mainObsCombo.end() ? comboIt->second : 0;
+
+        if (acsConfig.ionModelOpts.estimate_sat_dcb  /// todo aaron, ew..
+            || mainCombo != obs.stecCodeCombo)
+        {
+            InitialState init = initialStateFromConfig(satOpts.code_bias);
+
+            KFKey satDCBKey;
+            satDCBKey.type = KF::CODE_BIAS;
+            satDCBKey.Sat  = obs.Sat;
+            satDCBKey.num  = obs.stecCodeCombo;
+
+            meas.addDsgnEntry(satDCBKey, 1, init);
+        }
+
+        /************ Ionosphere basis ************/
+        obs.ionoSat = obs.Sat;
+
+        ionModelCoefs(trace, obs, coefs, true);
+
+        for (int i = 0; i < coefs.size(); i++)
+        {
+            double coef = coefs[i];
+
+            if (coef == 0)
+                continue;
+
+            recMeas.usedBasis.insert(i);
+
+            KFKey ionModelKey;
+            ionModelKey.type = KF::IONOSPHERIC;
+            ionModelKey.num  = i;
+
+            InitialState ionModelInit = initialStateFromConfig(acsConfig.ionModelOpts.ion);
+
+            meas.addDsgnEntry(ionModelKey, coef, ionModelInit);
+
+            tracepdeex(
+                4,
+                trace,
+                "#IONO_MOD %s %4d %9.5f %10.5f %8.5f %8.5f %12.5e %9.5f %12.5e\n",
+                ((string)meas.obsKey).c_str(),
+                i,
+                obs.ippMap[0].latDeg,
+                obs.ippMap[0].lonDeg,
+                obs.ippMap[0].slantFactor,
+                obs.stecToDelay,
+                coef,
+                obs.stecVal,
+                obs.stecVar
+            );
+        }
+
+        recMeas.kfMeasEntryList.push_back(meas);
+    }
+}
+
 /** Updating the ionosphere model parameters
  * The ionosphere model should be initialized by calling 'config_ionosph_model'
  * Ionosphere measurments from stations should be loaded using 'update_station_measr'
@@ -228,110 +401,48 @@ void filterIonosphere(
             kfState.removeState(key);
     }
 
-    // add measurements and create design matrix entries
-    KFMeasEntryList kfMeasEntryList;
+    // add measurements and create design matrix entries, separately for each receiver so they may
+    // be built in parallel, then merged in receiver order so the filter is independent of threading
+    vector<IonoRecMeasurements> recMeasList(receiverMap.size());
 
-    for (auto& [id, rec] : receiverMap)
-        for (auto& obs : only<GObs>(rec.obsList))
-        {
-            E_Sys sys = obs.Sat.sys;
+#ifdef ENABLE_PARALLELISATION
+    Eigen::setNbThreads(1);
+#pragma omp parallel for
+#endif
+    for (int r = 0; r < receiverMap.size(); r++)
+    {
+        auto recIterator = receiverMap.begin();
+        std::advance(recIterator, r);
 
-            auto& recOpts = acsConfig.getRecOpts(id);
-            auto& satOpts = acsConfig.getSatOpts(obs.Sat);
+        auto& [id, rec] = *recIterator;
 
-            if (obs.ionExclude)
-            {
-                continue;
-            }
-            if (obs.stecType <= 0)
-            {
-                continue;
-            }
-            if (stationList[rec.id][sys] < MIN_NSAT_REC)
-            {
-                continue;
-            }
+        auto stationIt = stationList.find(rec.id);
+        if (stationIt == stationList.end())
+        {
+            continue;
+        }
 
-            /************ Ionosphere Measurements ************/
-            KFKey obsKey;
-            obsKey.Sat = obs.Sat;
-            obsKey.str = rec.id;
-
-            KFMeasEntry meas(&kfState, obsKey);
-            meas.setValue(obs.stecVal);
-            meas.setNoise(obs.stecVar);
-
-            /************ receiver DCB ************/ /* We may need to change this for multi-code
-                                                        solutions */
-            SatSys sat0;
-            sat0.sys = sys;
-            sat0.prn = 0;
-
-            KFKey recDCBKey;
-            recDCBKey.type = KF::CODE_BIAS;
-            recDCBKey.str  = rec.id;
-            recDCBKey.Sat  = sat0;
-            recDCBKey.num  = obs.stecCodeCombo;
-
-            if (reset_DCBs[sys])
-                kfState.removeState(recDCBKey);
-
-            InitialState init = initialStateFromConfig(recOpts.code_bias);
-            if (rec.id != ionRefRec[sys])
-                meas.addDsgnEntry(recDCBKey, 1, init);
-
-            /************ satellite DCB ************/ /* We may need to change this for multi-code
-                                                         solutions */
-            if (acsConfig.ionModelOpts.estimate_sat_dcb  /// todo aaron, ew..
-                || mainObsCombo[sys] != obs.stecCodeCombo)
-            {
-                InitialState init = initialStateFromConfig(satOpts.code_bias);
+        auto& [dummy, recSysCount] = *stationIt;
 
-                KFKey satDCBKey;
-                satDCBKey.type = KF::CODE_BIAS;
-                satDCBKey.Sat  = obs.Sat;
-                satDCBKey.num  = obs.stecCodeCombo;
+        ionRecMeasurements(rec, kfState, recSysCount, reset_DCBs, mainObsCombo, recMeasList[r]);
+    }
+    Eigen::setNbThreads(0);
 
-                meas.addDsgnEntry(satDCBKey, 1, init);
-            }
+    KFMeasEntryList kfMeasEntryList;
+    for (auto& recMeas : recMeasList)
+    {
+        trace << recMeas.trace.str();
 
-            /************ Ionosphere basis ************/
-            obs.ionoSat = obs.Sat;
-            for (int i = 0; i < acsConfig.ionModelOpts.numBasis; i++)
-            {
-                double coef = ionModelCoef(trace, i, obs, true);
-
-                if (coef == 0)
-                    continue;
-
-                ionStateOutage[i] = 0;
-
-                KFKey ionModelKey;
-                ionModelKey.type = KF::IONOSPHERIC;
-                ionModelKey.num  = i;
-
-                InitialState ionModelInit = initialStateFromConfig(acsConfig.ionModelOpts.ion);
-
-                meas.addDsgnEntry(ionModelKey, coef, ionModelInit);
-
-                tracepdeex(
-                    4,
-                    trace,
-                    "#IONO_MOD %s %4d %9.5f %10.5f %8.5f %8.5f %12.5e %9.5f %12.5e\n",
-                    ((string)meas.obsKey).c_str(),
-                    i,
-                    obs.ippMap[0].latDeg,
-                    obs.ippMap[0].lonDeg,
-                    obs.ippMap[0].slantFactor,
-                    obs.stecToDelay,
-                    coef,
-                    obs.stecVal,
-                    obs.stecVar
-                );
-            }
+        for (int i : recMeas.usedBasis)
+        {
+            ionStateOutage[i] = 0;
+        }
 
-            kfMeasEntryList.push_back(meas);
+        for (auto& meas : recMeas.kfMeasEntryList)
+        {
+            kfMeasEntryList.push_back(std::move(meas));
         }
+    }
 
     // add process noise to existing states as per their initialisations.
     kfState.stateTransition(trace, time);
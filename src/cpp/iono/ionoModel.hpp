@@ -50,12 +50,14 @@ double ionCoefSphcap(Trace& trace, int ind, IonoObs& obs, bool slant = true);
 double ionCoefBsplin(Trace& trace, int ind, IonoObs& obs, bool slant = true);
 double ionCoefLocal(Trace& trace, int ind, IonoObs& obs);
 
-double
-ionVtecSphhar(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& var, KFState& kfState);
-double
-ionVtecSphcap(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& var, KFState& kfState);
-double
-ionVtecBsplin(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& var, KFState& kfState);
+void ionModelCoefs(Trace& trace, IonoObs& obs, vector<double>& coefs, bool slant = true);
+void ionCoefsSphhar(Trace& trace, IonoObs& obs, vector<double>& coefs, bool slant = true);
+void ionCoefsSphcap(Trace& trace, IonoObs& obs, vector<double>& coefs, bool slant = true);
+void ionCoefsBsplin(Trace& trace, IonoObs& obs, vector<double>& coefs, bool slant = true);
+
+bool ionVtecCoefsSphhar(Trace& trace, GTime time, VectorPos ionPP, int layer, vector<double>& coefs);
+bool ionVtecCoefsSphcap(Trace& trace, GTime time, VectorPos ionPP, int layer, vector<double>& coefs);
+bool ionVtecCoefsBsplin(Trace& trace, GTime time, VectorPos ionPP, int layer, vector<double>& coefs);
 
 int checkSSRRegion(VectorPos& pos);
 
@@ -8,9 +8,6 @@
 #include "orbprop/coordinates.hpp"
 #include "orbprop/planets.hpp"
 
-Legendre ionLeg;
-double   ionSPHLastColatitude = -100;
-
 struct SphBasis
 {
     int        layer  = 0;
@@ -38,7 +35,6 @@ int configIonModelSphhar(Trace& trace)
     else if (acsConfig.ionModelOpts.function_order > acsConfig.ionModelOpts.function_degree)
         acsConfig.ionModelOpts.function_order = acsConfig.ionModelOpts.function_degree;
 
-    int Nmax = acsConfig.ionModelOpts.function_degree + 1;
     int nlay = acsConfig.ionModelOpts.layer_heights.size();
     if (nlay == 0)
     {
@@ -46,8 +42,6 @@ int configIonModelSphhar(Trace& trace)
         nlay = 1;
     }
 
-    ionLeg.setNmax(Nmax);
-
     int ind = 0;
     for (int layer = 0; layer < nlay; layer++)
         for (int order = 0; order < acsConfig.ionModelOpts.function_order; order++)
@@ -159,6 +153,33 @@ bool ippCheckSphhar(GTime time, VectorPos& ionPP)
     return true;
 }
 
+/** Get the Legendre functions at a colatitude.
+ * The functions are held per thread so that basis functions may be evaluated in parallel, and are
+ * only recalculated when the colatitude changes.
+ */
+Legendre& sphLegendre(
+    double colat  ///< Colatitude (rad)
+)
+{
+    thread_local Legendre leg;
+    thread_local double   lastColat = -100;
+
+    int nmax = acsConfig.ionModelOpts.function_degree + 1;
+    if (leg.nmax != nmax)
+    {
+        leg.setNmax(nmax);
+        lastColat = -100;
+    }
+
+    if (colat != lastColat)
+    {
+        leg.calculate(cos(colat));
+        lastColat = colat;
+    }
+
+    return leg;
+}
+
 /** Evaluates spherical harmonics basis functions
     int ind			I
     obs				I		Ionosphere measurement struct
@@ -187,10 +208,9 @@ double ionCoefSphhar(
 
     double colat = obs.ippMap[basis.layer].latDeg * D2R;
 
-    if (fabs(ionSPHLastColatitude - colat) > 0.01)
-        ionLeg.calculate(cos(colat));
+    Legendre& leg = sphLegendre(colat);
 
-    double coeff = pow(-1, basis.order) * ionLeg.Pnm(basis.degree, basis.order);
+    double coeff = pow(-1, basis.order) * leg.Pnm(basis.degree, basis.order);
 
     double angle = basis.order * obs.ippMap[basis.layer].lonDeg * D2R;
 
@@ -207,52 +227,107 @@ double ionCoefSphhar(
     return coeff;
 }
 
-/** Estimate Ionosphere VTEC using Spherical Cap Harmonic models
-    gtime_t  time		I		time of solutions (not useful for this one
-    Ion_pp				I		Ionosphere Piercing Point
-    layer				I 		Layer number
-    vari				O		variance of VTEC
-returns: VETC at piercing point
-----------------------------------------------------------------------------*/
-double
-ionVtecSphhar(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& var, KFState& kfState)
+/** Evaluates all spherical harmonics basis functions for an observation in one pass.
+ * The Legendre functions are calculated once per layer, and the longitude harmonics by recurrence.
+ */
+void ionCoefsSphhar(
+    Trace&          trace,
+    IonoObs&        obs,    ///< Ionospheric observation metadata
+    vector<double>& coefs,  ///< Output coefficients, indexed by basis function number
+    bool            slant   ///< apply slant factor, false: coefficients for VTEC, true: for STEC
+)
 {
-    VectorPos ionpp_cpy = ionPP;
-    ionpp_cpy[2]        = acsConfig.ionModelOpts.layer_heights[layer];
+    coefs.assign(acsConfig.ionModelOpts.numBasis, 0);
 
-    ippCheckSphhar(time, ionpp_cpy);
+    int maxOrder = acsConfig.ionModelOpts.function_order;
 
-    var = 0;
-
-    IonoObs tmpobs;
-    tmpobs.ippMap[layer].latDeg      = ionpp_cpy.latDeg();
-    tmpobs.ippMap[layer].lonDeg      = ionpp_cpy.lonDeg();
-    tmpobs.ippMap[layer].slantFactor = 1;
+    vector<double> cosm(maxOrder + 1);
+    vector<double> sinm(maxOrder + 1);
 
-    double iono = 0;
+    int       layer   = -1;
+    IonoPP*   ipp_ptr = nullptr;
+    Legendre* leg_ptr = nullptr;
 
-    for (int basisNum = 0; basisNum < acsConfig.ionModelOpts.numBasis; basisNum++)
+    for (auto& [ind, basis] : sphBasisMap)
     {
-        auto& basis = sphBasisMap[basisNum];
+        if (ind >= coefs.size())
+            break;
 
-        if (basis.layer != layer)
+        if (basis.order > acsConfig.ionModelOpts.function_order)
+            continue;
+
+        if (basis.degree > acsConfig.ionModelOpts.function_degree)
             continue;
 
-        double coef = ionCoefSphhar(trace, basisNum, tmpobs, false);
+        if (basis.layer != layer)
+        {
+            layer = basis.layer;
+
+            // layers without piercing points use a default one, as in ionCoefSphhar()
+            auto& ipp = obs.ippMap[layer];
 
-        KFKey key;
-        key.type = KF::IONOSPHERIC;
-        key.num  = basisNum;
+            ipp_ptr = &ipp;
+            leg_ptr = &sphLegendre(ipp.latDeg * D2R);
 
-        double val   = 0;
-        double kfvar = 0;
-        kfState.getKFValue(key, val, &kfvar);
+            double lon    = ipp_ptr->lonDeg * D2R;
+            double cosLon = cos(lon);
+            double sinLon = sin(lon);
 
-        iono += coef * val;
-        var += SQR(coef) * kfvar;
+            cosm[0] = 1;
+            sinm[0] = 0;
+            for (int m = 1; m <= maxOrder; m++)
+            {
+                cosm[m] = cosm[m - 1] * cosLon - sinm[m - 1] * sinLon;
+                sinm[m] = sinm[m - 1] * cosLon + cosm[m - 1] * sinLon;
+            }
+        }
+
+        double coeff = leg_ptr->Pnm(basis.degree, basis.order);
+
+        if (basis.order % 2)
+            coeff = -coeff;
+
+        if (basis.trigType == E_TrigType::SIN)
+            coeff *= sinm[basis.order];
+        else if (basis.trigType == E_TrigType::COS)
+            coeff *= cosm[basis.order];
+
+        if (slant)
+        {
+            coeff *= ipp_ptr->slantFactor;
+        }
+
+        coefs[ind] = coeff;
+    }
+}
+
+/** Basis function coefficients for the VTEC of one layer of the spherical harmonic model
+    gtime_t  time		I		time of solutions (not useful for this one
+    Ion_pp				I		Ionosphere Piercing Point
+    layer				I 		Layer number
+    coefs				O		coefficients, zero for basis functions of other layers
+returns: false if the piercing point is outside of the model
+----------------------------------------------------------------------------*/
+bool ionVtecCoefsSphhar(Trace& trace, GTime time, VectorPos ionPP, int layer, vector<double>& coefs)
+{
+    ionPP[2] = acsConfig.ionModelOpts.layer_heights[layer];
+
+    ippCheckSphhar(time, ionPP);
+
+    IonoObs tmpobs;
+    tmpobs.ippMap[layer].latDeg      = ionPP.latDeg();
+    tmpobs.ippMap[layer].lonDeg      = ionPP.lonDeg();
+    tmpobs.ippMap[layer].slantFactor = 1;
+
+    ionCoefsSphhar(trace, tmpobs, coefs, false);
+
+    for (auto& [basisNum, basis] : sphBasisMap)
+    {
+        if (basisNum < coefs.size() && basis.layer != layer)
+            coefs[basisNum] = 0;
     }
 
-    return iono;
+    return true;
 }
 
 void ionOutputSphcal(Trace& trace, KFState& kfState)
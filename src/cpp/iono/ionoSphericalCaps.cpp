@@ -239,51 +239,95 @@ double ionCoefSphcap(Trace& trace, int ind, IonoObs& obs, bool slant)
     return out;
 }
 
-/** Estimate Ionosphere VTEC using Spherical Cap Harmonic models
+/** Evaluates all spherical cap harmonics basis functions for an observation in one pass.
+ * The longitude harmonics are calculated once per layer by recurrence.
+ */
+void ionCoefsSphcap(
+    Trace&          trace,
+    IonoObs&        obs,    ///< Ionosphere measurement struct
+    vector<double>& coefs,  ///< Output coefficients, indexed by basis function number
+    bool            slant   ///< false: output coefficients for Vtec, true: for delay
+)
+{
+    coefs.assign(acsConfig.ionModelOpts.numBasis, 0);
+
+    int maxOrder = 0;
+    for (auto& [ind, basis] : scpBasisMap)
+        maxOrder = std::max(maxOrder, basis.order);
+
+    vector<double> cosm(maxOrder + 1);
+    vector<double> sinm(maxOrder + 1);
+
+    int     layer   = -1;
+    IonoPP* ipp_ptr = nullptr;
+
+    for (auto& [ind, basis] : scpBasisMap)
+    {
+        if (ind >= coefs.size())
+            break;
+
+        if (basis.ind != layer)
+        {
+            layer   = basis.ind;
+            ipp_ptr = &obs.ippMap[layer];
+
+            double lon    = ipp_ptr->lonDeg * D2R;
+            double cosLon = cos(lon);
+            double sinLon = sin(lon);
+
+            cosm[0] = 1;
+            sinm[0] = 0;
+            for (int m = 1; m <= maxOrder; m++)
+            {
+                cosm[m] = cosm[m - 1] * cosLon - sinm[m - 1] * sinLon;
+                sinm[m] = sinm[m - 1] * cosLon + cosm[m - 1] * sinLon;
+            }
+        }
+
+        double out = legendre_function(basis.order, basis.degree, ipp_ptr->latDeg * D2R);
+
+        if (basis.parity)
+            out *= sinm[basis.order];
+        else
+            out *= cosm[basis.order];
+
+        if (slant)
+        {
+            out *= ipp_ptr->slantFactor * obs.stecToDelay;
+        }
+
+        coefs[ind] = out;
+    }
+}
+
+/** Basis function coefficients for the VTEC of one layer of the spherical cap harmonic model
     gtime_t  time		I		time of solutions (not useful for this one
     Ion_pp				I		Ionosphere Piercing Point
     layer				I 		Layer number
-    vari				O		variance of VTEC
-returns: VETC at piercing point
+    coefs				O		coefficients, zero for basis functions of other layers
+returns: false if the piercing point is outside of the model
 ----------------------------------------------------------------------------*/
-double
-ionVtecSphcap(Trace& trace, GTime time, VectorPos& ionPP, int layer, double& var, KFState& kfState)
+bool ionVtecCoefsSphcap(Trace& trace, GTime time, VectorPos ionPP, int layer, vector<double>& coefs)
 {
     if (ippCheckSphcap(time, ionPP) == false)
     {
-        var = 0;
-        return 0;
+        return false;
     }
 
-    var         = 0;
-    double iono = 0;
-    GObs   tmpobs;
+    IonoObs tmpobs;
     tmpobs.ippMap[layer].latDeg      = ionPP.latDeg();
     tmpobs.ippMap[layer].lonDeg      = ionPP.lonDeg();
     tmpobs.ippMap[layer].slantFactor = 1;
 
-    for (int ind = 0; ind < acsConfig.ionModelOpts.numBasis; ind++)
-    {
-        auto& basis = scpBasisMap[ind];
-
-        if (basis.ind != layer)
-            continue;
-
-        double coef = ionCoefSphcap(trace, ind, tmpobs, false);
+    ionCoefsSphcap(trace, tmpobs, coefs, false);
 
-        KFKey key;
-        key.type = KF::IONOSPHERIC;
-        key.num  = ind;
-
-        double val   = 0;
-        double kfvar = 0;
-        kfState.getKFValue(key, val, &kfvar);
-
-        iono += coef * val;
-        var += SQR(coef) * kfvar;
+    for (auto& [ind, basis] : scpBasisMap)
+    {
+        if (ind < coefs.size() && basis.ind != layer)
+            coefs[ind] = 0;
     }
 
-    return iono;
+    return true;
 }
 
 /** Initializes Spherical caps Ionosphere model
@@ -25,4 +25,8 @@ struct otl_input
     std::vector<std::vector<float>> dispNS_out;
     std::vector<std::string>        wave_names;
     MA3cf                           out_disp;  //  nstation, nphase, naxis
+    int                             tile_size = 8;      //  stations processed together
+    bool                            benchmark = false;  //  also time the per station reference
+    int                             grid_tile   = 64;   //  grid nodes along each side of a tile read at once
+    int                             grid_margin = 16;   //  grid nodes either side of a station used for interpolation
 };
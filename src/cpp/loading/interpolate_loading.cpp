@@ -21,6 +21,7 @@
 #include <boost/timer/timer.hpp>
 #include <fstream>
 #include <iostream>
+#include <sys/resource.h>
 #include <yaml-cpp/yaml.h>
 #include "loading/input_otl.h"
 #include "loading/load_functions.h"
@@ -56,6 +57,8 @@ void program_options(int argc, char* argv[], otl_input& input)
 			("code",     	po::value<std::string>(), 	"Station Code with or without DOMES number (ALIC 50137M0014)")
 			("input",		po::value<std::string>(),	"input file containing list of stations CSV format name, lon, lat")
 			("output",		po::value<std::string>(),	"Output BLQ file")
+			("tile",		po::value<int>(),	"Number of grid nodes along each side of the tiles read from the grid (default 64)")
+			("margin",		po::value<int>(),	"Number of grid nodes either side of a station used for the interpolation (default 16)")
 			;
 
     po::variables_map vm;
@@ -215,6 +218,15 @@ void program_options(int argc, char* argv[], otl_input& input)
         input.output_blq_file = "output.blq";
     }
 
+    if (vm.count("tile"))
+    {
+        input.grid_tile = vm["tile"].as<int>();
+    }
+    if (vm.count("margin"))
+    {
+        input.grid_margin = vm["margin"].as<int>();
+    }
+
     if (is_ecef)
     {
         for (int i = 0; i < input.xyz_coords.size(); i++)
@@ -257,14 +269,24 @@ int main(int argc, char* argv[])
                                 << "   * " << input.output_blq_file << "\n";
         BOOST_LOG_TRIVIAL(info) << " ========       END       ======= " << "\n";
 
-        loadGrid tideinfo;
+        cpu_timer timer;
+        loadGrid  tideinfo;
 
         tideinfo.set_name(input.tide_file[0]);
-        tideinfo.read();
+        tideinfo.read_axes();
 
         BOOST_LOG_TRIVIAL(debug) << "there is " << tideinfo.get_nwave() << " tides\n";
         input.wave_names = tideinfo.get_wave_names();
 
+        MA2f values;
+        tideinfo.interpolate_tiled(
+            input.lon,
+            input.lat,
+            input.grid_tile,
+            input.grid_margin,
+            values
+        );
+
         input.out_disp.resize(boost::extents[input.code.size()][tideinfo.get_nwave()][3]);
         std::fill(
             input.out_disp.data(),
@@ -276,18 +298,15 @@ int main(int argc, char* argv[])
             for (int i_wave = 0; i_wave < tideinfo.get_nwave(); i_wave++)
                 for (int i_dir = 0; i_dir < 3; i_dir++)
                     input.out_disp[i_sta][i_wave][i_dir] = std::complex<float>(
-                        tideinfo.interpolate(
-                            i_wave * 6 + 2 * i_dir,
-                            input.lon[i_sta],
-                            input.lat[i_sta]
-                        ),
-                        tideinfo.interpolate(
-                            i_wave * 6 + 2 * i_dir + 1,
-                            input.lon[i_sta],
-                            input.lat[i_sta]
-                        )
+                        values[i_sta][i_wave * 6 + 2 * i_dir],
+                        values[i_sta][i_wave * 6 + 2 * i_dir + 1]
                     );
 
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        BOOST_LOG_TRIVIAL(info) << "Interpolation Done \n\t" << timer.format()
+                                << "\tPeak memory " << usage.ru_maxrss / 1024.0 << " MB\n";
+
         write_BLQ(&input, 0);
     }
     catch (std::exception& e)
@@ -6,10 +6,14 @@
  */
 
 #include "loading/load_functions.h"
+#include <algorithm>
 #include <boost/multi_array.hpp>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 #include "loading/boost_ma_type.h"
 #include "loading/input_otl.h"
 #include "loading/loading.h"
@@ -85,6 +89,222 @@ void load_1_point(
     }
 }
 
+/** Compute the loading of all points.
+ *
+ * Equivalent to load_1_point() for each point, but the grid geometry is precomputed once, the
+ * Green's functions are evaluated one grid row at a time and applied to all tides while that row is
+ * in cache, and the points are processed in tiles so that each row of the tide grids is reused by
+ * all points of a tile. Land cells, which carry no tide, are skipped.
+ */
+void load_points(
+    tide*      tide_info,  ///< vector of classes containing the tide grids
+    otl_input* input,  ///< class containing the coordinates information and also the loading vector
+    loading&   load,   ///< class containing the Green's function, tabulated
+    int        tile_size  ///< number of points processed together
+)
+{
+    int n_tide  = input->tide_file.size();
+    int n_point = input->lat.size();
+    int n_lat   = tide_info[0].get_nlat();
+    int n_lon   = tide_info[0].get_nlon();
+
+    for (int it = 1; it < n_tide; it++)
+    {
+        if (tide_info[it].get_nlat() != n_lat || tide_info[it].get_nlon() != n_lon)
+            throw std::runtime_error("Tide grids " + input->tide_file[it] + " and " +
+                                     input->tide_file[0] + " have different dimensions");
+    }
+
+    if (tile_size < 1)
+        tile_size = 1;
+
+    // grid geometry shared by all points
+    std::vector<double> lat2_r(n_lat);
+    std::vector<double> cos_lat2(n_lat);
+    std::vector<double> sin_lat2(n_lat);
+    std::vector<double> lon2_r(n_lon);
+    for (int i_lat = 0; i_lat < n_lat; i_lat++)
+    {
+        lat2_r[i_lat]   = (double)(tide_info[0].get_lat(i_lat) * PI / 180.0);
+        cos_lat2[i_lat] = cos(lat2_r[i_lat]);
+        sin_lat2[i_lat] = sin(lat2_r[i_lat]);
+    }
+    for (int i_lon = 0; i_lon < n_lon; i_lon++)
+        lon2_r[i_lon] = (double)(tide_info[0].get_lon(i_lon) * PI / 180.0);
+
+    std::vector<double*> in_ptrs(n_tide);
+    std::vector<double*> out_ptrs(n_tide);
+    for (int it = 0; it < n_tide; it++)
+    {
+        in_ptrs[it]  = tide_info[it].get_in_ptr();
+        out_ptrs[it] = tide_info[it].get_out_ptr();
+    }
+
+    // columns of each row with any tide, land cells contribute nothing
+    std::vector<std::vector<int>> ocean_cols(n_lat);
+    for (int i_lat = 0; i_lat < n_lat; i_lat++)
+        for (int i_lon = 0; i_lon < n_lon; i_lon++)
+        {
+            size_t cell = (size_t)i_lat * n_lon + i_lon;
+            for (int it = 0; it < n_tide; it++)
+            {
+                if (in_ptrs[it][cell] != 0 || out_ptrs[it][cell] != 0)
+                {
+                    ocean_cols[i_lat].push_back(i_lon);
+                    break;
+                }
+            }
+        }
+
+    int n_tile = (n_point + tile_size - 1) / tile_size;
+
+#pragma omp parallel for schedule(dynamic)
+    for (int i_tile = 0; i_tile < n_tile; i_tile++)
+    {
+        int first = i_tile * tile_size;
+        int n_sta = std::min(tile_size, n_point - first);
+
+        // per point geometry, the longitude terms are the same for every row
+        std::vector<double> lat1_r(n_sta);
+        std::vector<double> cos_lat1(n_sta);
+        std::vector<double> sin_lat1(n_sta);
+        std::vector<double> sin_dlon(n_sta * n_lon);
+        std::vector<double> cos_dlon(n_sta * n_lon);
+        std::vector<double> hav_dlon(n_sta * n_lon);
+        for (int i_sta = 0; i_sta < n_sta; i_sta++)
+        {
+            float  lat0   = input->lat[first + i_sta];
+            float  lon0   = input->lon[first + i_sta];
+            double lon1_r = (double)(lon0 * PI / 180.0);
+
+            lat1_r[i_sta]   = (double)(lat0 * PI / 180.0);
+            cos_lat1[i_sta] = cos(lat1_r[i_sta]);
+            sin_lat1[i_sta] = sin(lat1_r[i_sta]);
+
+            for (int i_lon = 0; i_lon < n_lon; i_lon++)
+            {
+                double deltalon = lon2_r[i_lon] - lon1_r;
+                double half     = sin(deltalon / 2);
+
+                sin_dlon[i_sta * n_lon + i_lon] = sin(deltalon);
+                cos_dlon[i_sta * n_lon + i_lon] = cos(deltalon);
+                hav_dlon[i_sta * n_lon + i_lon] = half * half;
+            }
+        }
+
+        // sums over the grid, [point][tide][EW_in, EW_out, Z_in, Z_out, NS_in, NS_out]
+        std::vector<double> sums(n_sta * n_tide * 6, 0.0);
+
+        std::vector<double> green_z(n_lon);
+        std::vector<double> green_ns(n_lon);
+        std::vector<double> green_ew(n_lon);
+
+        for (int i_lat = 0; i_lat < n_lat; i_lat++)
+        {
+            auto& cols   = ocean_cols[i_lat];
+            int   n_cols = cols.size();
+            if (n_cols == 0)
+                continue;
+
+            double cos2 = cos_lat2[i_lat];
+            double sin2 = sin_lat2[i_lat];
+
+            for (int i_sta = 0; i_sta < n_sta; i_sta++)
+            {
+                double half_dlat = sin((lat2_r[i_lat] - lat1_r[i_sta]) / 2);
+                double hav_dlat  = half_dlat * half_dlat;
+                double cos12     = cos_lat1[i_sta] * cos2;
+                double sin1cos2  = sin_lat1[i_sta] * cos2;
+                double cos1sin2  = cos_lat1[i_sta] * sin2;
+
+                const double* sin_dlon_row = &sin_dlon[i_sta * n_lon];
+                const double* cos_dlon_row = &cos_dlon[i_sta * n_lon];
+                const double* hav_dlon_row = &hav_dlon[i_sta * n_lon];
+
+                for (int k = 0; k < n_cols; k++)
+                {
+                    int    i_lon = cols[k];
+                    double a     = hav_dlat + cos12 * hav_dlon_row[i_lon];
+                    double y     = sin_dlon_row[i_lon] * cos2;
+                    double x     = cos1sin2 - sin1cos2 * cos_dlon_row[i_lon];
+
+                    double dist = 2 * atan2(sqrt(a), sqrt(1 - a));
+                    if (dist != dist)
+                        dist = PI;
+
+                    // cos and sin of the azimuth atan2(y, x)
+                    double r      = sqrt(x * x + y * y);
+                    double cos_az = 1;
+                    double sin_az = 0;
+                    if (r > 0)
+                    {
+                        cos_az = x / r;
+                        sin_az = y / r;
+                    }
+
+                    double gz;
+                    double gh;
+                    load.interpolate_g(dist, gz, gh);
+
+                    green_z[k]  = gz;
+                    green_ns[k] = gh * cos_az;
+                    green_ew[k] = gh * sin_az;
+                }
+
+                // apply this row of the Green's functions to all tides
+                for (int it = 0; it < n_tide; it++)
+                {
+                    const double* tide_re = in_ptrs[it] + (size_t)i_lat * n_lon;
+                    const double* tide_im = out_ptrs[it] + (size_t)i_lat * n_lon;
+
+                    double ew_in  = 0;
+                    double ew_out = 0;
+                    double z_in   = 0;
+                    double z_out  = 0;
+                    double ns_in  = 0;
+                    double ns_out = 0;
+
+#pragma omp simd reduction(+ : ew_in, ew_out, z_in, z_out, ns_in, ns_out)
+                    for (int k = 0; k < n_cols; k++)
+                    {
+                        double re = tide_re[cols[k]];
+                        double im = tide_im[cols[k]];
+
+                        ew_in += green_ew[k] * re;
+                        ew_out += green_ew[k] * im;
+                        z_in += green_z[k] * re;
+                        z_out += green_z[k] * im;
+                        ns_in += green_ns[k] * re;
+                        ns_out += green_ns[k] * im;
+                    }
+
+                    double* sum = &sums[(i_sta * n_tide + it) * 6];
+                    sum[0] += ew_in;
+                    sum[1] += ew_out;
+                    sum[2] += z_in;
+                    sum[3] += z_out;
+                    sum[4] += ns_in;
+                    sum[5] += ns_out;
+                }
+            }
+        }
+
+        for (int i_sta = 0; i_sta < n_sta; i_sta++)
+            for (int it = 0; it < n_tide; it++)
+            {
+                int     idx = first + i_sta;
+                double* sum = &sums[(i_sta * n_tide + it) * 6];
+
+                input->dispEW_in[idx][it] += sum[0];
+                input->dispEW_out[idx][it] += sum[1];
+                input->dispZ_in[idx][it] += sum[2];
+                input->dispZ_out[idx][it] += sum[3];
+                input->dispNS_in[idx][it] += sum[4];
+                input->dispNS_out[idx][it] += sum[5];
+            }
+    }
+}
+
 void write_BLQ(otl_input* input, int mode)
 {
     std::ofstream out;
@@ -10,5 +10,6 @@
 #include "loading/loading.h"
 #include "loading/tide.h"
 void load_1_point(tide* tide_info, otl_input* input, loading load, int idx);
+void load_points(tide* tide_info, otl_input* input, loading& load, int tile_size);
 void write_BLQ(otl_input* input);
 void write_BLQ(otl_input* input, int code);
@@ -10,7 +10,10 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/math/interpolators/cardinal_cubic_b_spline.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <map>
 #include <netcdf>
 
 using namespace std;
@@ -35,39 +38,50 @@ void loadGrid::set_name(std::string name)
     return;
 };
 
+/** Read the dimensions, wave names and coordinates of the grid, but not the loads themselves
+ */
+void loadGrid::read_axes()
+{
+    NcFile datafile(fileName, NcFile::read);
+    nWave = datafile.getDim("nwaves").getSize();
+    // std::vector<std::string> test;
+    // NcGroupAtt attr = datafile.getAtt("wave_name");
+    NcGroupAtt attr = datafile.getAtt("wave_name");
+    cout << attr.getAttLength() << "\n";
+    cout << attr.getType().getTypeClassName() << "\n";
+    // std::string test;
+    // test = new char[5];
+    std::string test;
+    // test.resize(2);
+    attr.getValues(test);
+    boost::to_upper(test);
+
+    std::vector<std::string> words;
+    boost::split(wave_names, test, boost::is_any_of(", "), boost::token_compress_on);
+
+    NcVar lat_var = datafile.getVar("lat");
+    nLat          = lat_var.getDim(0).getSize();
+
+    NcVar lon_var = datafile.getVar("lon");
+    nLon          = lon_var.getDim(0).getSize();
+
+    lat.resize(boost::extents[nLat]);
+    lon.resize(boost::extents[nLon]);
+
+    lat_var.getVar(lat.origin());
+    lon_var.getVar(lon.origin());
+
+    datafile.close();
+}
+
 void loadGrid::read()
 {
     try
     {
         // std::cout << fileName << "\n";
+        read_axes();
+
         NcFile datafile(fileName, NcFile::read);
-        nWave = datafile.getDim("nwaves").getSize();
-        // std::vector<std::string> test;
-        // NcGroupAtt attr = datafile.getAtt("wave_name");
-        NcGroupAtt attr = datafile.getAtt("wave_name");
-        cout << attr.getAttLength() << "\n";
-        cout << attr.getType().getTypeClassName() << "\n";
-        // std::string test;
-        // test = new char[5];
-        std::string test;
-        // test.resize(2);
-        attr.getValues(test);
-        boost::to_upper(test);
-
-        std::vector<std::string> words;
-        boost::split(wave_names, test, boost::is_any_of(", "), boost::token_compress_on);
-
-        NcVar lat_var = datafile.getVar("lat");
-        nLat          = lat_var.getDim(0).getSize();
-
-        NcVar lon_var = datafile.getVar("lon");
-        nLon          = lon_var.getDim(0).getSize();
-
-        lat.resize(boost::extents[nLat]);
-        lon.resize(boost::extents[nLon]);
-
-        lat_var.getVar(lat.origin());
-        lon_var.getVar(lon.origin());
         load.resize(boost::extents[nWave][nLat][nLon]);
         NcVar amp_var = datafile.getVar("waves");
         amp_var.getVar(load.origin());
@@ -105,4 +119,136 @@ float loadGrid::interpolate(int itide, float lon_, float lat_)
     //		lon_slice =
     //	}
     return 0;
-}
\ No newline at end of file
+}
+
+/** Interpolate one layer of a window of the grid at a location, as interpolate() does for the full
+ * grid but only using the nodes within a margin of the location.
+ * The splines are parameterised by node index so the grid spacing and orientation are respected.
+ */
+float loadGrid::interpolate_window(
+    const float* layer,   ///< layer of the window, [wLat][wLon]
+    size_t       lat0,    ///< first latitude index of the window in the grid
+    size_t       lon0,    ///< first longitude index of the window in the grid
+    size_t       wLat,    ///< number of latitudes in the window
+    size_t       wLon,    ///< number of longitudes in the window
+    float        lon_,    ///< longitude of the location
+    float        lat_,    ///< latitude of the location
+    int          margin   ///< number of nodes either side of the location used for the splines
+)
+{
+    float dLon = nLon > 1 ? lon[1] - lon[0] : 1;
+    float dLat = nLat > 1 ? lat[1] - lat[0] : 1;
+
+    float  lonIndex = (lon_ - lon[0]) / dLon;
+    float  latIndex = (lat_ - lat[0]) / dLat;
+    long   iLon     = std::lround(lonIndex);
+    long   iLat     = std::lround(latIndex);
+    size_t lonStart = std::clamp<long>(iLon - margin, lon0, lon0 + wLon - 1);
+    size_t lonEnd   = std::clamp<long>(iLon + margin + 1, lon0 + 1, lon0 + wLon);
+    size_t latStart = std::clamp<long>(iLat - margin, lat0, lat0 + wLat - 1);
+    size_t latEnd   = std::clamp<long>(iLat + margin + 1, lat0 + 1, lat0 + wLat);
+
+    std::vector<float> lon_val(latEnd - latStart);
+    for (size_t iRow = latStart; iRow < latEnd; iRow++)
+    {
+        cardinal_cubic_b_spline<float> splines(
+            layer + (iRow - lat0) * wLon + (lonStart - lon0),
+            lonEnd - lonStart,
+            static_cast<float>(lonStart),
+            static_cast<float>(1.0)
+        );
+        lon_val[iRow - latStart] = splines(lonIndex);
+    }
+
+    cardinal_cubic_b_spline<float> splines2(
+        lon_val.data(),
+        lon_val.size(),
+        static_cast<float>(latStart),
+        static_cast<float>(1.0)
+    );
+    return splines2(latIndex);
+}
+
+/** Interpolate all layers of the grid at many locations without reading the whole grid.
+ *
+ * Locations are grouped by the tile of the grid containing their nearest node. Only tiles with
+ * locations are read, extended by a margin of nodes, and the layers are streamed one wave (6 layers)
+ * at a time, so memory use is bounded by the size of a tile rather than the grid.
+ * The locations of each tile are interpolated in parallel.
+ */
+void loadGrid::interpolate_tiled(
+    const std::vector<float>& lons,       ///< longitudes of the locations
+    const std::vector<float>& lats,       ///< latitudes of the locations
+    int                       tile_size,  ///< number of nodes along each side of a tile
+    int                       margin,     ///< number of nodes either side of a location used for the splines
+    MA2f&                     values      ///< output values, [location][layer]
+)
+{
+    if (tile_size < 1)
+        tile_size = 1;
+
+    // the splines use derivatives estimated at the end points, which requires 5 nodes
+    if (margin < 2)
+        margin = 2;
+
+    size_t nSta = lons.size();
+    values.resize(boost::extents[nSta][nWave]);
+
+    float dLon = nLon > 1 ? lon[1] - lon[0] : 1;
+    float dLat = nLat > 1 ? lat[1] - lat[0] : 1;
+
+    // group the locations by tile
+    std::map<std::pair<long, long>, std::vector<int>> tiles;
+    for (int iSta = 0; iSta < nSta; iSta++)
+    {
+        long iLon = std::clamp<long>(std::lround((lons[iSta] - lon[0]) / dLon), 0, nLon - 1);
+        long iLat = std::clamp<long>(std::lround((lats[iSta] - lat[0]) / dLat), 0, nLat - 1);
+
+        tiles[{iLat / tile_size, iLon / tile_size}].push_back(iSta);
+    }
+
+    NcFile datafile(fileName, NcFile::read);
+    NcVar  amp_var = datafile.getVar("waves");
+
+    std::vector<float> window;
+    for (auto& [tileId, stations] : tiles)
+    {
+        auto [tLat, tLon] = tileId;
+
+        size_t lat0   = std::max<long>(tLat * tile_size - margin, 0);
+        size_t lon0   = std::max<long>(tLon * tile_size - margin, 0);
+        size_t latEnd = std::min<long>((tLat + 1) * tile_size + margin, nLat);
+        size_t lonEnd = std::min<long>((tLon + 1) * tile_size + margin, nLon);
+        size_t wLat   = latEnd - lat0;
+        size_t wLon   = lonEnd - lon0;
+
+        for (size_t iWave = 0; iWave < nWave; iWave += 6)
+        {
+            size_t nLayer = std::min<size_t>(6, nWave - iWave);
+
+            window.resize(nLayer * wLat * wLon);
+            amp_var.getVar({iWave, lat0, lon0}, {nLayer, wLat, wLon}, window.data());
+
+            int nStaTile = stations.size();
+#pragma omp parallel for collapse(2)
+            for (int i = 0; i < nStaTile; i++)
+                for (int iLayer = 0; iLayer < nLayer; iLayer++)
+                {
+                    int iSta = stations[i];
+
+                    values[iSta][iWave + iLayer] = interpolate_window(
+                        window.data() + iLayer * wLat * wLon,
+                        lat0,
+                        lon0,
+                        wLat,
+                        wLon,
+                        lons[iSta],
+                        lats[iSta],
+                        margin
+                    );
+                }
+        }
+    }
+
+    datafile.close();
+}
@@ -8,6 +8,7 @@
 
 #include <boost/multi_array.hpp>
 #include <string>
+#include <vector>
 #include "loading/boost_ma_type.h"
 /**
  * Implementation of the class  to manage the tides.
@@ -35,9 +36,29 @@ class loadGrid
 
     float interpolate(int, float, float);
 
+    void read_axes();
+    void interpolate_tiled(
+        const std::vector<float>& lons,
+        const std::vector<float>& lats,
+        int                       tile_size,
+        int                       margin,
+        MA2f&                     values
+    );
+
     std::vector<std::string> get_wave_names() { return wave_names; };
 
    private:
+    float interpolate_window(
+        const float* layer,
+        size_t       lat0,
+        size_t       lon0,
+        size_t       wLat,
+        size_t       wLon,
+        float        lon_,
+        float        lat_,
+        int          margin
+    );
+
     std::string              fileName;
     std::vector<std::string> wave_names;
     size_t                   nLon;
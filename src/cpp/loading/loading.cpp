@@ -104,4 +104,84 @@ double loading::interpolate_gz(double x)
 double loading::interpolate_gh(double x)
 {
     return interpolate(dist, Gh, x, false);
-}
\ No newline at end of file
+}
+
+/** Tabulate the Green's function segments on a uniform grid of distances, so that interpolate_g()
+ * finds the segment for a distance directly rather than by searching from the start of the table.
+ * Results are identical to interpolate_gz() and interpolate_gh().
+ */
+void loading::tabulate(int n_bucket)
+{
+    int size = dist.size();
+    if (size < 2)
+    {
+        BOOST_LOG_TRIVIAL(error) << fileName << " greens function has too few entries\n\t";
+        exit(0);
+    }
+
+    Gz_slope.resize(size - 1);
+    Gh_slope.resize(size - 1);
+    for (int i = 0; i < size - 1; i++)
+    {
+        Gz_slope[i] = (Gz[i + 1] - Gz[i]) / (dist[i + 1] - dist[i]);
+        Gh_slope[i] = (Gh[i + 1] - Gh[i]) / (dist[i + 1] - dist[i]);
+    }
+
+    bucket_width = PI / n_bucket;
+    bucket_segment.resize(n_bucket);
+
+    int i = 0;
+    for (int b = 0; b < n_bucket; b++)
+    {
+        double start = b * bucket_width;
+        while (i < size - 2 && start > dist[i + 1])
+            i++;
+
+        bucket_segment[b] = i;
+    }
+}
+
+/** Interpolate both Green's functions at a distance using the tabulated segments
+ */
+void loading::interpolate_g(double x, double& gz, double& gh) const
+{
+    int size = dist.size();
+
+    if (x == 0)
+    {
+        gz = 0;
+        gh = 0;
+        return;
+    }
+
+    int i;
+    if (x >= dist[size - 2])  // special case: beyond right end
+    {
+        i = size - 2;
+    }
+    else
+    {
+        int b = std::min((int)(x / bucket_width), (int)bucket_segment.size() - 1);
+
+        i = bucket_segment[b];
+        while (x > dist[i + 1])
+            i++;
+    }
+
+    // no extrapolation beyond the ends of the table
+    if (x < dist[i])
+    {
+        gz = Gz[i];
+        gh = Gh[i];
+    }
+    else if (x > dist[i + 1])
+    {
+        gz = Gz[i + 1];
+        gh = Gh[i + 1];
+    }
+    else
+    {
+        gz = Gz[i] + Gz_slope[i] * (x - dist[i]);
+        gh = Gh[i] + Gh_slope[i] * (x - dist[i]);
+    }
+}
@@ -18,6 +18,8 @@ class loading
     void   read();
     double interpolate_gz(double);
     double interpolate_gh(double);
+    void   tabulate(int n_bucket);
+    void   interpolate_g(double x, double& gz, double& gh) const;
 
    private:
     std::string         fileName;
@@ -25,4 +27,10 @@ class loading
     std::vector<double> dist;
     std::vector<double> Gz;
     std::vector<double> Gh;
+
+    // Lookup of the Green's function segments from a uniform grid of distances
+    double              bucket_width = 0;
+    std::vector<int>    bucket_segment;  ///< first segment ending at or after the start of each bucket
+    std::vector<double> Gz_slope;        ///< gradient of Gz over each segment
+    std::vector<double> Gh_slope;        ///< gradient of Gh over each segment
 };
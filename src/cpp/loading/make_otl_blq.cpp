@@ -64,6 +64,8 @@ void program_options(int argc, char* argv[], otl_input& input)
 			("code",		po::value<std::string>(), "Station Code with or without DOMES number (ALIC 50137M0014)")
 			("input",		po::value<std::string>(), "input file containing list of stations CSV format name, lon, lat")
 			("output",		po::value<std::string>()->default_value("output.blq"),	"Output BLQ file")
+			("tile",		po::value<int>(),	"Number of stations convolved together per pass over the tide grids (default 8)")
+			("benchmark",	po::bool_switch()->default_value(false),	"Also run the per station reference convolution, report the timing of both and the largest difference")
 
 			;
 
@@ -242,6 +244,12 @@ void program_options(int argc, char* argv[], otl_input& input)
         input.output_blq_file = "output.blq";
     }
 
+    if (vm.count("tile"))
+    {
+        input.tile_size = vm["tile"].as<int>();
+    }
+    input.benchmark = vm["benchmark"].as<bool>();
+
     if (is_ecef)
     {
         for (int i = 0; i < input.xyz_coords.size(); i++)
@@ -316,36 +324,74 @@ int main(int argc, char* argv[])
         input.dispNS_out.resize(input.code.size());
         input.dispEW_out.resize(input.code.size());
 
-        for (int i = 0; i < input.code.size(); i++)
+        auto reset = [&]()
         {
-            input.dispZ_in[i].resize(input.tide_file.size());
-            input.dispNS_in[i].resize(input.tide_file.size());
-            input.dispEW_in[i].resize(input.tide_file.size());
+            for (int i = 0; i < input.code.size(); i++)
+            {
+                input.dispZ_in[i].assign(input.tide_file.size(), 0.0);
+                input.dispNS_in[i].assign(input.tide_file.size(), 0.0);
+                input.dispEW_in[i].assign(input.tide_file.size(), 0.0);
 
-            input.dispZ_out[i].resize(input.tide_file.size());
-            input.dispNS_out[i].resize(input.tide_file.size());
-            input.dispEW_out[i].resize(input.tide_file.size());
+                input.dispZ_out[i].assign(input.tide_file.size(), 0.0);
+                input.dispNS_out[i].assign(input.tide_file.size(), 0.0);
+                input.dispEW_out[i].assign(input.tide_file.size(), 0.0);
+            }
+        };
 
-            for (int i2 = 0; i2 < input.tide_file.size(); i2++)
-            {
-                input.dispZ_in[i][i2]  = 0.0;
-                input.dispNS_in[i][i2] = 0.0;
-                input.dispEW_in[i][i2] = 0.0;
+        double n_cells = (double)tideinfo[0].get_nlat() * tideinfo[0].get_nlon();
 
-                input.dispZ_out[i][i2]  = 0.0;
-                input.dispNS_out[i][i2] = 0.0;
-                input.dispEW_out[i][i2] = 0.0;
+        otl_input reference;
+        if (input.benchmark)
+        {
+            reset();
+
+            cpu_timer ref_timer;
+#pragma omp parallel for
+            for (unsigned int i_poi = 0; i_poi < input.lat.size(); i_poi++)
+            {
+                load_1_point(tideinfo, &input, load, i_poi);
             }
+            ref_timer.stop();
+
+            BOOST_LOG_TRIVIAL(info) << "Reference convolution Done \n\t" << ref_timer.format()
+                                    << "\t" << input.lat.size() * n_cells / (ref_timer.elapsed().wall * 1e-9)
+                                    << " station-cells per second\n";
+
+            reference = input;
         }
 
-#pragma omp parallel for
-        for (unsigned int i_poi = 0; i_poi < input.lat.size(); i_poi++)
+        reset();
+
+        cpu_timer conv_timer;
+        load.tabulate(1 << 16);
+        load_points(tideinfo, &input, load, input.tile_size);
+        conv_timer.stop();
+
+        BOOST_LOG_TRIVIAL(info) << "Convolution Done \n\t" << conv_timer.format() << "\t"
+                                << input.lat.size() * n_cells / (conv_timer.elapsed().wall * 1e-9)
+                                << " station-cells per second\n";
+
+        if (input.benchmark)
         {
-            // BOOST_LOG_TRIVIAL(info) << " Processing coordinates # " << i_poi << " \n\t" <<
-            // timer.format() ;
-            load_1_point(tideinfo, &input, load, i_poi);
-            //			BOOST_LOG_TRIVIAL(info) << " end  pt  " << i_poi << " \n\t" <<
-            // timer.format() ;
+            double max_diff = 0;
+            double max_val  = 0;
+            for (int i = 0; i < input.code.size(); i++)
+                for (int it = 0; it < input.tide_file.size(); it++)
+                    for (auto [disp, ref] : {
+                             std::make_pair(input.dispZ_in[i][it], reference.dispZ_in[i][it]),
+                             std::make_pair(input.dispZ_out[i][it], reference.dispZ_out[i][it]),
+                             std::make_pair(input.dispNS_in[i][it], reference.dispNS_in[i][it]),
+                             std::make_pair(input.dispNS_out[i][it], reference.dispNS_out[i][it]),
+                             std::make_pair(input.dispEW_in[i][it], reference.dispEW_in[i][it]),
+                             std::make_pair(input.dispEW_out[i][it], reference.dispEW_out[i][it])
+                         })
+                    {
+                        max_diff = std::max(max_diff, (double)std::abs(disp - ref));
+                        max_val  = std::max(max_val, (double)std::abs(ref));
+                    }
+
+            BOOST_LOG_TRIVIAL(info) << "Largest difference to reference: " << max_diff
+                                    << " m, largest displacement " << max_val << " m\n";
         }
 
         write_BLQ(&input);
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include "common/constants.hpp"
+#include "common/eigenIncluder.hpp"
+
+using std::array;
+using std::map;
+
+/** Chebyshev interpolant of a smooth vector valued function of time over one segment.
+ * Fitted from samples at the Chebyshev nodes, evaluated with Clenshaw's recurrence.
+ */
+template <typename VECTOR, int N>
+struct ChebyshevSegment
+{
+    long double          mid       = 0;  ///< Time of the middle of the segment (s)
+    double               halfWidth = 1;  ///< Half of the segment length (s)
+    array<VECTOR, N>     coeffs;         ///< Coefficients of the function
+    array<VECTOR, N - 1> derivCoeffs;    ///< Coefficients of the time derivative of the function
+
+    template <size_t M>
+    static VECTOR clenshaw(const array<VECTOR, M>& series, double x)
+    {
+        VECTOR b1 = VECTOR::Zero();
+        VECTOR b2 = VECTOR::Zero();
+
+        for (int j = M - 1; j >= 1; j--)
+        {
+            VECTOR b0 = 2 * x * b1 - b2 + series[j];
+            b2        = b1;
+            b1        = b0;
+        }
+
+        return x * b1 - b2 + series[0];
+    }
+
+    /** Fit the segment to a function, using a sampler of the form bool(long double time, VECTOR&)
+     */
+    template <typename SAMPLER>
+    bool fit(
+        long double start,   ///< Time of start of segment (s)
+        double      width,   ///< Length of segment (s)
+        SAMPLER     sampler  ///< Function to fit, returns false on failure
+    )
+    {
+        halfWidth = width / 2;
+        mid       = start + halfWidth;
+
+        array<VECTOR, N> samples;
+        for (int k = 0; k < N; k++)
+        {
+            double x = cos(PI * (k + 0.5) / N);
+
+            bool pass = sampler(mid + x * halfWidth, samples[k]);
+            if (pass == false)
+            {
+                return false;
+            }
+        }
+
+        for (int j = 0; j < N; j++)
+        {
+            VECTOR sum = VECTOR::Zero();
+            for (int k = 0; k < N; k++)
+            {
+                sum += samples[k] * cos(PI * j * (k + 0.5) / N);
+            }
+
+            coeffs[j] = sum * 2 / N;
+        }
+        coeffs[0] /= 2;
+
+        // differentiate the series, scaling from normalised to real time
+        array<VECTOR, N + 1> deriv;
+        deriv[N]     = VECTOR::Zero();
+        deriv[N - 1] = VECTOR::Zero();
+        for (int j = N - 1; j >= 1; j--)
+        {
+            deriv[j - 1] = deriv[j + 1] + 2 * j * coeffs[j];
+        }
+        deriv[0] /= 2;
+
+        for (int j = 0; j < N - 1; j++)
+        {
+            derivCoeffs[j] = deriv[j] / halfWidth;
+        }
+
+        return true;
+    }
+
+    VECTOR value(long double time) const
+    {
+        return clenshaw(coeffs, (double)(time - mid) / halfWidth);
+    }
+
+    VECTOR rate(long double time) const
+    {
+        return clenshaw(derivCoeffs, (double)(time - mid) / halfWidth);
+    }
+};
+
+/** Thread safe collection of Chebyshev segments of fixed length, fitted on first use.
+ * Segments are aligned to multiples of their length so all consumers share them.
+ */
+template <typename KEY, typename VECTOR, int N>
+struct ChebyshevCache
+{
+    using Segment = ChebyshevSegment<VECTOR, N>;
+
+    double                             width;  ///< Length of each segment (s)
+    map<std::pair<KEY, long>, Segment> segmentMap;
+    std::shared_mutex                  segmentMutex;
+
+    ChebyshevCache(double width)
+        : width{width}
+    {
+    }
+
+    /** Evaluate the interpolant for a key at a time, fitting its segment first if required
+     */
+    template <typename SAMPLER>
+    bool evaluate(
+        const KEY&  key,      ///< Key of the function being interpolated
+        long double time,     ///< Time to evaluate at (s)
+        SAMPLER     sampler,  ///< Function to fit, returns false on failure
+        VECTOR&     value,    ///< Output value
+        VECTOR*     rate_ptr  ///< Optional output rate
+    )
+    {
+        long index = (long)std::floor(time / width);
+        auto id    = std::make_pair(key, index);
+
+        {
+            std::shared_lock<std::shared_mutex> guard(segmentMutex);
+
+            auto it = segmentMap.find(id);
+            if (it != segmentMap.end())
+            {
+                auto& [dummy, segment] = *it;
+
+                value = segment.value(time);
+                if (rate_ptr)
+                    *rate_ptr = segment.rate(time);
+
+                return true;
+            }
+        }
+
+        // fit outside of the lock, the sampler may be slow and take locks of its own
+        Segment segment;
+        bool    pass = segment.fit(index * (long double)width, width, sampler);
+        if (pass == false)
+        {
+            return false;
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> guard(segmentMutex);
+
+            segmentMap.emplace(id, segment);
+        }
+
+        value = segment.value(time);
+        if (rate_ptr)
+            *rate_ptr = segment.rate(time);
+
+        return true;
+    }
+
+    /** Remove all fitted segments, eg. when the data the sampler uses has changed
+     */
+    void clear()
+    {
+        std::unique_lock<std::shared_mutex> guard(segmentMutex);
+
+        segmentMap.clear();
+    }
+};
@@ -14,23 +14,20 @@
 #include "common/common.hpp"
 #include "common/constants.hpp"
 #include "common/erp.hpp"
+#include "orbprop/chebyshev.hpp"
 #include "orbprop/iers2010.hpp"
 #include "orbprop/planets.hpp"
 
-array<FrameSwapper, 2> FrameSwapper::cacheArr;
+constexpr double FRAME_TERMS_SEGMENT = 6 * 60 * 60;  ///< Length of each interpolated segment (s)
+constexpr int    FRAME_TERMS_NODES   = 16;           ///< Chebyshev nodes (coefficients) per segment
+
+/** Shared interpolants of the time dependent terms of the celestial to terrestrial rotation
+ */
+ChebyshevCache<int, Vector6d, FRAME_TERMS_NODES> frameTermsCache(FRAME_TERMS_SEGMENT);
 
 FrameSwapper::FrameSwapper(GTime time, const ERPValues& erpv) : time0{time}, erpv{erpv}
 {
-    for (auto& cache : cacheArr)
-    {
-        if (time0 == cache.time0 && erpv == cache.erpv)
-        {
-            *this = cache;
-            return;
-        }
-    }
-
-    eci2ecef(time, erpv, i2t_mat, &di2t_mat);
+    eci2ecefInterpolated(time, erpv, i2t_mat, &di2t_mat);
 
     if (cmc.initialized)
     {
@@ -40,19 +37,19 @@ FrameSwapper::FrameSwapper(GTime time, const ERPValues& erpv) : time0{time}, erp
     }
 }
 
-void eci2ecef(
-    GTime            time,    ///< Current time
-    const ERPValues& erpVal,  ///< Structure containing the erp values
-    Matrix3d&        U,       ///< Matrix3d containing the rotation matrix
-    Matrix3d*        dU_ptr   ///< Matrix3d containing the time derivative of the rotation matrix
+/** Calculate the terms of the celestial to terrestrial rotation that depend only on time.
+ * These are the expensive parts of the rotation - the CIP coordinates and CIO locator from the
+ * precession-nutation model, and the tidal/libration corrections to the pole and UT1.
+ * Terms are {X, Y, s, dxp, dyp, dut1} in rad, rad, rad, rad, rad, s
+ */
+void frameTerms(
+    GTime     time,    ///< Current time
+    double    ut1Utc,  ///< UT1-UTC used for the fundamental arguments of the tidal corrections
+    Vector6d& terms    ///< Output terms
 )
 {
-    double   xp      = erpVal.xp;
-    double   yp      = erpVal.yp;
-    double   lod     = erpVal.lod;
-    double   ut1_utc = erpVal.ut1Utc;
-    double   dx00    = 0.1725 * DMAS2R;
-    double   dy00    = -0.2650 * DMAS2R;
+    double   dx00 = 0.1725 * DMAS2R;
+    double   dy00 = -0.2650 * DMAS2R;
     IERS2010 iers;
 
     double xp_pm  = 0;
@@ -64,8 +61,8 @@ void eci2ecef(
     double ut1_o  = 0;
     double lod_o  = 0;
 
-    iers.PMGravi(time, ut1_utc, xp_pm, yp_pm, ut1_pm, lod_pm);
-    FundamentalArgs fundArgs(time, ut1_utc);
+    iers.PMGravi(time, ut1Utc, xp_pm, yp_pm, ut1_pm, lod_pm);
+    FundamentalArgs fundArgs(time, ut1Utc);
 
     if (hfEop.initialized)
     {
@@ -73,14 +70,38 @@ void eci2ecef(
     }
     else
     {
-        iers.PMUTOcean(time, ut1_utc, xp_o, yp_o, ut1_o);  //, lod_pm);
+        iers.PMUTOcean(time, ut1Utc, xp_o, yp_o, ut1_o);  //, lod_pm);
     }
 
-    double xp_ = xp + (xp_pm + xp_o) * 1e-6 * AS2R;
-    double yp_ = yp + (yp_pm + yp_o) * 1e-6 * AS2R;
+    MjDateTT mjDateTT(time);
 
-    ut1_utc += (ut1_pm + ut1_o) * 1e-6;
-    lod += lod_pm * 1e-6;
+    double X_iau = 0;
+    double Y_iau = 0;
+    double S_iau = 0;
+    Sofa::iauXys(mjDateTT, X_iau, Y_iau, S_iau);
+
+    terms(0) = X_iau + dx00;
+    terms(1) = Y_iau + dy00;
+    terms(2) = S_iau;
+    terms(3) = (xp_pm + xp_o) * 1e-6 * AS2R;
+    terms(4) = (yp_pm + yp_o) * 1e-6 * AS2R;
+    terms(5) = (ut1_pm + ut1_o) * 1e-6;
+}
+
+/** Assemble the celestial to terrestrial rotation from its time dependent terms and the erps
+ */
+void eci2ecef(
+    GTime            time,    ///< Current time
+    const ERPValues& erpVal,  ///< Structure containing the erp values
+    const Vector6d&  terms,   ///< Time dependent terms of the rotation, from frameTerms()
+    Matrix3d&        U,       ///< Matrix3d containing the rotation matrix
+    Matrix3d*        dU_ptr   ///< Matrix3d containing the time derivative of the rotation matrix
+)
+{
+    double xp_ = erpVal.xp + terms(3);
+    double yp_ = erpVal.yp + terms(4);
+
+    double ut1_utc = erpVal.ut1Utc + terms(5);
 
     MjDateUt1 mjDateUt1(time, ut1_utc);
     MjDateTT  mjDateTT(time);
@@ -91,16 +112,10 @@ void eci2ecef(
     Matrix3d theta;
     theta = Eigen::AngleAxisd(-era, Vector3d::UnitZ());
 
-    double X_iau = 0;
-    double Y_iau = 0;
-    double S_iau = 0;
-    Sofa::iauXys(mjDateTT, X_iau, Y_iau, S_iau);
-    X_iau += dx00;
-    Y_iau += dy00;
     Matrix<double, 3, 3, Eigen::RowMajor> RC2I;
     Matrix<double, 3, 3, Eigen::RowMajor> RPOM;
 
-    iauC2ixys(X_iau, Y_iau, S_iau, (double (*)[3]) & RC2I(0, 0));
+    iauC2ixys(terms(0), terms(1), terms(2), (double (*)[3]) & RC2I(0, 0));
     iauPom00(xp_, yp_, sp, (double (*)[3]) & RPOM(0, 0));
 
     U = RPOM * theta * RC2I;
@@ -118,6 +133,57 @@ void eci2ecef(
     }
 }
 
+/** Celestial to terrestrial rotation, evaluating all models directly
+ */
+void eci2ecef(
+    GTime            time,    ///< Current time
+    const ERPValues& erpVal,  ///< Structure containing the erp values
+    Matrix3d&        U,       ///< Matrix3d containing the rotation matrix
+    Matrix3d*        dU_ptr   ///< Matrix3d containing the time derivative of the rotation matrix
+)
+{
+    Vector6d terms;
+    frameTerms(time, erpVal.ut1Utc, terms);
+
+    eci2ecef(time, erpVal, terms, U, dU_ptr);
+}
+
+/** Celestial to terrestrial rotation, using shared interpolants of the time dependent terms.
+ * The erp values are applied exactly, only the precession-nutation and tidal terms are interpolated.
+ * Thread safe.
+ */
+void eci2ecefInterpolated(
+    GTime            time,    ///< Current time
+    const ERPValues& erpVal,  ///< Structure containing the erp values
+    Matrix3d&        U,       ///< Matrix3d containing the rotation matrix
+    Matrix3d*        dU_ptr   ///< Matrix3d containing the time derivative of the rotation matrix
+)
+{
+    // the tidal terms only depend on ut1-utc through the fundamental arguments, where sub-second
+    // offsets have sub-microarcsecond effects, so the interpolants are shared for all erp values
+    auto sampler = [](long double sampleTime, Vector6d& sampleTerms)
+    {
+        GTime time;
+        time.bigTime = sampleTime;
+
+        frameTerms(time, 0, sampleTerms);
+        return true;
+    };
+
+    Vector6d terms;
+    frameTermsCache.evaluate(0, time.bigTime, sampler, terms, nullptr);
+
+    eci2ecef(time, erpVal, terms, U, dU_ptr);
+}
+
+/** Discard the interpolants of the time dependent rotation terms, so that they are refitted with
+ * the current models. Required when high frequency EOP data is loaded after segments were fitted.
+ */
+void resetFrameTerms()
+{
+    frameTermsCache.clear();
+}
+
 /** Transform geodetic postion to ecef
  */
 VectorEcef pos2ecef(const VectorPos& pos)  ///< geodetic position {lat,lon,h} (rad,m)
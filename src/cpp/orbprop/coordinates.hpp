@@ -66,6 +66,15 @@ struct XFormData
 
 void eci2ecef(GTime time, const ERPValues& erpVal, Matrix3d& U, Matrix3d* dU_ptr = nullptr);
 
+void eci2ecefInterpolated(
+    GTime            time,
+    const ERPValues& erpVal,
+    Matrix3d&        U,
+    Matrix3d*        dU_ptr = nullptr
+);
+
+void resetFrameTerms();
+
 void pos2enu(const VectorPos& pos, double* E);
 
 VectorEnu ecef2enu(const VectorPos& pos, const VectorEcef& r);
@@ -84,8 +93,6 @@ Vector3d ecef2body(AttStatus& attStatus, VectorEcef& ecef, MatrixXd* dEdQ_ptr =
 
 struct FrameSwapper
 {
-    static array<FrameSwapper, 2> cacheArr;
-
     GTime     time0;
     ERPValues erpv;
 
@@ -93,8 +100,6 @@ struct FrameSwapper
     Matrix3d di2t_mat;
     Vector3d translation = Vector3d::Zero();
 
-    void setCache(int cache) { cacheArr[cache] = *this; }
-
     FrameSwapper() {}
 
     FrameSwapper(GTime time, const ERPValues& erpv);
@@ -133,6 +138,20 @@ struct FrameSwapper
         return (Vector3d)(i2t_mat.transpose() * ((Vector3d)rEcef - translation));
     }
 
+    /** Transform a set of ECI vectors, stored as columns, to ECEF
+     */
+    Eigen::Matrix3Xd toEcef(const Eigen::Matrix3Xd& rEci) const
+    {
+        return (i2t_mat * rEci).colwise() + translation;
+    }
+
+    /** Transform a set of ECEF vectors, stored as columns, to ECI
+     */
+    Eigen::Matrix3Xd toEci(const Eigen::Matrix3Xd& rEcef) const
+    {
+        return i2t_mat.transpose() * (rEcef.colwise() - translation);
+    }
+
     VectorEci operator()(const VectorEcef rEcef, const GTime time)
     {
         VectorEci eci = operator()(rEcef);
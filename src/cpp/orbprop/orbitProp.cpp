@@ -61,7 +61,14 @@ void OrbitIntegrator::computeCommon(GTime time)
 
     for (auto body : enum_values<E_ThirdBody>())
     {
-        jplEphPos(nav.jplEph_ptr, time, body, planetsPosMap[body], &planetsVelMap[body]);
+        VectorEci pos;
+        VectorEci vel;
+        bool      pass = planetPosEci(time, body, pos, &vel);
+        if (pass)
+        {
+            planetsPosMap[body] = pos;
+            planetsVelMap[body] = vel;
+        }
     }
 
     Array6d dood_arr = IERS2010::doodson(time, erpv.ut1Utc);
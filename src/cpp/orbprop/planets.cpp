@@ -9,12 +9,46 @@
 #include "common/enums.h"
 #include "common/erp.hpp"
 #include "common/navigation.hpp"
+#include "orbprop/chebyshev.hpp"
 #include "orbprop/coordinates.hpp"
 
 using std::lock_guard;
 
 std::mutex jplEphMutex;
 
+constexpr double THIRD_BODY_SEGMENT = 6 * 60 * 60;  ///< Length of each interpolated segment (s)
+constexpr int    THIRD_BODY_NODES   = 16;           ///< Chebyshev nodes (coefficients) per segment
+
+/** Shared interpolants of third body positions, keyed by body and whether they are in ECEF
+ */
+ChebyshevCache<std::pair<E_ThirdBody, bool>, Vector3d, THIRD_BODY_NODES> thirdBodyCache(
+    THIRD_BODY_SEGMENT
+);
+
+/** Evaluate a third body position from the shared interpolants, fitting the segment if required
+ */
+template <typename SAMPLER>
+bool interpolateThirdBody(
+    GTime       time,       ///< Time of position
+    E_ThirdBody thirdBody,  ///< Body to get position of
+    bool        ecef,       ///< Interpolant is in ECEF rather than ECI
+    SAMPLER     sampler,    ///< Function returning the position at a time, for fitting
+    Vector3d&   pos,        ///< Output position (m)
+    Vector3d*   vel_ptr     ///< Optional output velocity (m/s)
+)
+{
+    auto timeSampler = [&sampler](long double sampleTime, Vector3d& samplePos)
+    {
+        GTime time;
+        time.bigTime = sampleTime;
+
+        return sampler(time, samplePos);
+    };
+
+    return thirdBodyCache
+        .evaluate(std::make_pair(thirdBody, ecef), time.bigTime, timeSampler, pos, vel_ptr);
+}
+
 bool jplEphPos(
     struct jpl_eph_data* jplEph_ptr,  ///< Pointer to jpl binary data
     MjDateTT             mjdTT,       ///< Julian_TT
@@ -83,11 +117,34 @@ bool jplEphPos(
     return false;
 }
 
+/** Position (and velocity) of a third body in ECI, from interpolants of the JPL ephemeris
+ */
+bool planetPosEci(
+    GTime       time,       ///< Time of position
+    E_ThirdBody thirdBody,  ///< Body to get position of
+    VectorEci&  pos,        ///< Output position (m)
+    VectorEci*  vel_ptr     ///< Optional output velocity (m/s)
+)
+{
+    if (nav.jplEph_ptr == nullptr)
+    {
+        // let the direct function do the complaining
+        return jplEphPos(nav.jplEph_ptr, time, thirdBody, pos, vel_ptr);
+    }
+
+    auto sampler = [thirdBody](GTime sampleTime, Vector3d& samplePos)
+    { return jplEphPos(nav.jplEph_ptr, sampleTime, thirdBody, samplePos); };
+
+    return interpolateThirdBody(time, thirdBody, false, sampler, pos, vel_ptr);
+}
+
+/** Position of a third body in ECEF, using the provided earth rotation parameters
+ */
 bool planetPosEcef(GTime time, E_ThirdBody thirdBody, VectorEcef& rBody, ERPValues erpv)
 {
     VectorEci rBodyEci;
 
-    bool pass = jplEphPos(nav.jplEph_ptr, time, thirdBody, rBodyEci);
+    bool pass = planetPosEci(time, thirdBody, rBodyEci);
     if (pass == false)
     {
         double pvh[2][3];
@@ -119,3 +176,20 @@ bool planetPosEcef(GTime time, E_ThirdBody thirdBody, VectorEcef& rBody, ERPValu
 
     return true;
 }
+
+/** Position of a third body in ECEF, ignoring earth rotation parameters.
+ * Uses interpolants of the rotated positions so that repeated queries avoid the frame rotation.
+ */
+bool planetPosEcef(GTime time, E_ThirdBody thirdBody, VectorEcef& rBody)
+{
+    auto sampler = [thirdBody](GTime sampleTime, Vector3d& samplePos)
+    {
+        VectorEcef sampleEcef;
+        bool       pass = planetPosEcef(sampleTime, thirdBody, sampleEcef, ERPValues{});
+
+        samplePos = sampleEcef;
+        return pass;
+    };
+
+    return interpolateThirdBody(time, thirdBody, true, sampler, rBody, nullptr);
+}
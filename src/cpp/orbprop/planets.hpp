@@ -45,7 +45,11 @@ bool jplEphPos(
     Vector3d*            vel_ptr = nullptr
 );
 
-bool planetPosEcef(GTime time, E_ThirdBody thirdBody, VectorEcef& ecef, ERPValues erpv = {});
+bool planetPosEci(GTime time, E_ThirdBody thirdBody, VectorEci& pos, VectorEci* vel_ptr = nullptr);
+
+bool planetPosEcef(GTime time, E_ThirdBody thirdBody, VectorEcef& ecef, ERPValues erpv);
+
+bool planetPosEcef(GTime time, E_ThirdBody thirdBody, VectorEcef& ecef);
 
 // From DE440
 static map<const E_ThirdBody, double> GM_values = {
@@ -1,5 +1,6 @@
 // #pragma GCC optimize ("O0")
 
+#include <chrono>
 #include "3rdparty/jpl/jpl_eph.hpp"
 #include "architectureDocs.hpp"
 #include "common/acsConfig.hpp"
@@ -39,6 +40,21 @@ Input Input_Files__()
     DOCS_REFERENCE(IGS_Files__);
 }
 
+constexpr long PRODUCT_TAIL_SIZE = 1 << 16;  ///< Bytes of a product searched for its last record
+
+/** Time span of the data records in an sp3 or clk file
+ */
+struct ProductSpan
+{
+    GTime       start;
+    GTime       stop;
+    set<SatSys> sats;  ///< Satellites listed in the file's header
+};
+
+map<string, ProductSpan> productCatalogue;  ///< Spans of windowed product files, by filename
+
+bool checkModifyTimes = true;  ///< Check files that have already been read for modification
+
 /** Check that filename is valid and the file exists
  */
 bool checkValidFile(
@@ -67,6 +83,11 @@ bool checkValidFiles(vector<string>& paths, const string& description)
 
 bool fileChanged(string filename)
 {
+    if (checkModifyTimes == false && acsConfig.configModifyTimeMap.count(filename))
+    {
+        return false;
+    }
+
     bool valid = checkValidFile(filename);
     if (valid == false)
     {
@@ -109,6 +130,11 @@ bool fileChanged(string filename)
 
 void removeInvalidFiles(vector<string>& files)
 {
+    if (checkModifyTimes == false)
+    {
+        return;
+    }
+
     for (auto it = files.begin(); it != files.end();)
     {
         auto& filename = *it;
@@ -124,6 +150,224 @@ void removeInvalidFiles(vector<string>& files)
     }
 }
 
+/** Get the time of a line of an sp3 or clk file, if it is the start of a data record
+ */
+bool productRecordTime(
+    const string& line,  ///< Line of the file
+    GTime&        time   ///< Output time of the record
+)
+{
+    if (line.size() > 3 && line[0] == '*')
+    {
+        // sp3 epoch header
+        return str2time(line.c_str(), 3, 28, time) == 0;
+    }
+
+    if (line.size() > 3 && (line.compare(0, 3, "AS ") == 0 || line.compare(0, 3, "AR ") == 0))
+    {
+        // clock data record, the time follows the variable length name of the satellite/receiver
+        size_t nameStart = line.find_first_not_of(' ', 3);
+        if (nameStart == string::npos)
+        {
+            return false;
+        }
+
+        size_t nameEnd = line.find(' ', nameStart);
+        if (nameEnd == string::npos)
+        {
+            return false;
+        }
+
+        return str2time(line.c_str(), nameEnd, 28, time) == 0;
+    }
+
+    return false;
+}
+
+/** Get the satellites listed in a header line of an sp3 or clk file
+ */
+void productHeaderSats(
+    const string& line,  ///< Line of the file
+    set<SatSys>&  sats   ///< Satellites to add to
+)
+{
+    int start;
+    int width;
+    int count;
+    if (line.size() > 9 && line[0] == '+' && line[1] == ' ')
+    {
+        // sp3 satellite list
+        start = 9;
+        width = 3;
+        count = 17;
+    }
+    else if (line.size() > 60 && line.compare(60, 8, "PRN LIST") == 0)
+    {
+        // clk satellite list
+        start = 0;
+        width = 4;
+        count = 15;
+    }
+    else
+    {
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int pos = start + i * width;
+        if (pos + 3 > line.size())
+        {
+            break;
+        }
+
+        string id = line.substr(pos, 3);
+        if (id == "  0" || id == "   ")
+        {
+            continue;
+        }
+
+        SatSys Sat(id.c_str());
+        if (Sat.prn != 0)
+        {
+            sats.insert(Sat);
+        }
+    }
+}
+
+/** Find the times of the first and last records of an sp3 or clk file, and the satellites listed
+ * in its header.
+ * Only the start of the file and a block from its end are read, rather than parsing the whole file
+ */
+bool productFileSpan(
+    const string& filename,  ///< File to find the span of
+    ProductSpan&  span       ///< Output span of the file's records
+)
+{
+    std::ifstream inputStream(filename);
+    if (!inputStream)
+    {
+        return false;
+    }
+
+    bool   found = false;
+    string line;
+    while (std::getline(inputStream, line))
+    {
+        found = productRecordTime(line, span.start);
+        if (found)
+        {
+            break;
+        }
+
+        productHeaderSats(line, span.sats);
+    }
+
+    if (found == false)
+    {
+        return false;
+    }
+
+    inputStream.clear();
+    inputStream.seekg(0, std::ios::end);
+    long size = inputStream.tellg();
+    long tail = std::max(0L, size - PRODUCT_TAIL_SIZE);
+
+    // search the tail for the last record, or the whole file if the tail doesnt contain any
+    span.stop = GTime::noTime();
+    for (long start : {tail, 0L})
+    {
+        inputStream.clear();
+        inputStream.seekg(start);
+
+        if (start > 0)
+        {
+            // skip the partial line
+            std::getline(inputStream, line);
+        }
+
+        while (std::getline(inputStream, line))
+        {
+            GTime recordTime;
+            if (productRecordTime(line, recordTime) && recordTime > span.stop)
+            {
+                span.stop = recordTime;
+            }
+        }
+
+        if (span.stop != GTime::noTime() || start == 0)
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+/** Check whether a product file has data within the product window around the current epoch,
+ * for satellites of processed systems.
+ * Files are catalogued when first seen, and loaded by the caller only once they are required.
+ */
+bool productInWindow(
+    const string& filename,  ///< Product file to check
+    GTime         time       ///< Time of the current epoch
+)
+{
+    if (acsConfig.product_window <= 0)
+    {
+        return true;
+    }
+
+    if (time == GTime::noTime())
+    {
+        // not processing yet, wait for the first epoch to know what is required
+        return false;
+    }
+
+    auto it = productCatalogue.find(filename);
+    if (it == productCatalogue.end())
+    {
+        ProductSpan span;
+        bool        pass = productFileSpan(filename, span);
+        if (pass == false)
+        {
+            BOOST_LOG_TRIVIAL(warning)
+                << "Could not find time span of " << filename << ", loading in full";
+
+            return true;
+        }
+
+        BOOST_LOG_TRIVIAL(debug) << "Catalogued " << filename << " from " << span.start << " to "
+                                 << span.stop << " with " << span.sats.size() << " satellites";
+
+        it = productCatalogue.emplace(filename, span).first;
+    }
+
+    auto& [dummy, span] = *it;
+
+    if (time + acsConfig.product_window < span.start)
+        return false;
+    if (time - acsConfig.product_window > span.stop)
+        return false;
+
+    if (span.sats.empty())
+    {
+        // no satellite list in the header, assume it is required
+        return true;
+    }
+
+    for (auto& Sat : span.sats)
+    {
+        if (acsConfig.process_sys[Sat.sys])
+        {
+            return true;
+        }
+    }
+
+    // only has satellites of systems that arent being processed
+    return false;
+}
+
 /** Create a receiver object from an input
  */
 void addReceiverData(
@@ -227,6 +471,15 @@ void addReceiverData(
         {
             parser_ptr                                             = make_unique<RinexParser>();
             static_cast<RinexParser*>(parser_ptr.get())->rnxRec.id = id;
+
+            if (protocol == "file" && acsConfig.rnx_obs_cache_directory.empty() == false)
+            {
+                auto& rinexParser = static_cast<RinexParser&>(*parser_ptr);
+
+                rinexParser.sourcePath = subInputName;
+                rinexParser.cachePath =
+                    obsCachePath(acsConfig.rnx_obs_cache_directory, subInputName);
+            }
         }
         else if (inputFormat == "UBX")
         {
@@ -299,10 +552,27 @@ void addReceiverData(
     }
 }
 
-void reloadInputFiles()
+void reloadInputFiles(
+    GTime time  ///< Time of the current epoch, or noTime before processing starts
+)
 {
     DOCS_REFERENCE(Input_Files__);
 
+    // only look for modifications to files already read periodically, the checks can be expensive
+    {
+        static auto lastCheckTime = std::chrono::steady_clock::time_point();
+
+        auto now = std::chrono::steady_clock::now();
+
+        checkModifyTimes = std::chrono::duration<double>(now - lastCheckTime).count() >=
+                           acsConfig.file_check_interval;
+
+        if (checkModifyTimes)
+        {
+            lastCheckTime = now;
+        }
+    }
+
     removeInvalidFiles(acsConfig.atx_files);
     for (auto& atxfile : acsConfig.atx_files)
     {
@@ -319,6 +589,11 @@ void reloadInputFiles()
     removeInvalidFiles(acsConfig.sp3_files);
     for (auto& sp3file : acsConfig.sp3_files)
     {
+        if (productInWindow(sp3file, time) == false)
+        {
+            continue;
+        }
+
         if (fileChanged(sp3file) == false)
         {
             continue;
@@ -387,6 +662,11 @@ void reloadInputFiles()
     removeInvalidFiles(acsConfig.clk_files);
     for (auto& clkfile : acsConfig.clk_files)
     {
+        if (productInWindow(clkfile, time) == false)
+        {
+            continue;
+        }
+
         if (fileChanged(clkfile) == false)
         {
             continue;
@@ -687,6 +967,9 @@ void reloadInputFiles()
         BOOST_LOG_TRIVIAL(info) << "Loading HFEOP file " << hfeopfile;
 
         hfEop.read(hfeopfile);
+
+        // interpolated frame terms fitted before this data was available use the ocean tide model
+        resetFrameTerms();
     }
 
     removeInvalidFiles(acsConfig.atmos_ocean_dealiasing_files);
@@ -13,7 +13,7 @@ struct Network;
 struct KFState;
 struct GTime;
 
-void reloadInputFiles();
+void reloadInputFiles(GTime time);
 
 bool checkValidFile(const string& path, const string& description = "");
 
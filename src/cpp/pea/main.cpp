@@ -16,6 +16,7 @@
 #include "common/algebraTrace.hpp"
 #include "common/api.hpp"
 #include "common/debug.hpp"
+#include "common/ephPrecise.hpp"
 #include "common/fileLog.hpp"
 #include "common/gTime.hpp"
 #include "common/mongoRead.hpp"
@@ -23,6 +24,7 @@
 #include "common/navigation.hpp"
 #include "common/ntripBroadcast.hpp"
 #include "common/observations.hpp"
+#include "common/productWriter.hpp"
 #include "common/receiver.hpp"
 #include "common/rinexClkWrite.hpp"
 #include "common/rinexNavWrite.hpp"
@@ -31,6 +33,7 @@
 #include "common/sinex.hpp"
 #include "common/streamNtrip.hpp"
 #include "common/streamObs.hpp"
+#include "common/streamRinex.hpp"
 #include "common/summary.hpp"
 #include "common/tcpSocket.hpp"
 #include "common/testUtils.hpp"
@@ -317,18 +320,109 @@ void mainOncePerEpochPerSatellite(
 void cullData(GTime time)
 {
     cullOldEphs(time);
+    cullOldPrecise(time);
     cullOldSSRs(time);
     cullOldBiases(time);
 
     mongoCull(time);
 }
 
+/** Parse epochs ahead from rinex observation files, with the files of all stations read in
+ * parallel.
+ * Headers are read serially on first use as they populate shared navigation data, after which
+ * each parser only writes to its own buffered observation lists.
+ */
+void preloadRinexObservations()
+{
+    if (acsConfig.rnx_preload_epochs <= 0)
+    {
+        return;
+    }
+
+    vector<ObsStream*> rinexStreams;
+    vector<ObsStream*> preloadStreams;
+
+    for (auto& [id, streamParser_ptr] : streamParserMultimap)
+    {
+        auto obsStream_ptr = dynamic_cast<ObsStream*>(streamParser_ptr.get());
+        if (obsStream_ptr == nullptr)
+        {
+            continue;
+        }
+
+        if (dynamic_cast<RinexParser*>(&obsStream_ptr->parser) == nullptr)
+        {
+            continue;
+        }
+
+        rinexStreams.push_back(obsStream_ptr);
+    }
+
+    if (rinexStreams.empty())
+    {
+        return;
+    }
+
+    // share the memory budget between stations, assuming a few signals per observation
+    size_t obsBytes = sizeof(GObs) + 4 * sizeof(Sig);
+    size_t maxObs = acsConfig.rnx_preload_memory_mb * 1024 * 1024 / obsBytes / rinexStreams.size();
+
+    for (auto& obsStream_ptr : rinexStreams)
+    {
+        auto& obsStream   = *obsStream_ptr;
+        auto& rinexParser = dynamic_cast<RinexParser&>(obsStream.parser);
+
+        if (obsStream.stream.isDead())
+        {
+            continue;
+        }
+
+        if (rinexParser.headerRead() == false)
+        {
+            // the header modifies shared navigation data, read it (and a single epoch) serially
+            rinexParser.lookaheadEpochs = 1;
+
+            obsStream.parse();
+        }
+
+        // the limits must be set before the refill check, or the epoch buffered with the header
+        // would satisfy the default lookahead and skip the preload
+        rinexParser.lookaheadEpochs = acsConfig.rnx_preload_epochs;
+        rinexParser.maxBufferedObs  = std::max(maxObs, (size_t)1);
+
+        // refill once half of the lookahead has been used, so that files arent reopened every epoch
+        if (rinexParser.obsListList.size() * 2 > rinexParser.lookaheadEpochs)
+        {
+            continue;
+        }
+
+        preloadStreams.push_back(obsStream_ptr);
+    }
+
+    if (preloadStreams.empty())
+    {
+        return;
+    }
+
+    Eigen::setNbThreads(1);
+#ifdef ENABLE_PARALLELISATION
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < preloadStreams.size(); i++)
+    {
+        auto& obsStream = *preloadStreams[i];
+
+        obsStream.parse();
+    }
+    Eigen::setNbThreads(0);
+}
+
 void mainOncePerEpoch(Network& pppNet, Network& ionNet, ReceiverMap& receiverMap, GTime time)
 {
     avoidCollisions(receiverMap);
 
-    // reload any new or modified files
-    reloadInputFiles();
+    // reload any new or modified files, and load products needed for this epoch
+    reloadInputFiles(time);
 
     addDefaultBias();
 
@@ -366,18 +460,11 @@ void mainOncePerEpoch(Network& pppNet, Network& ionNet, ReceiverMap& receiverMap
         nav.erp.filterValues = getErpFromFilter(pppNet.kfState);
     }
 
-    const int DT = 1;
-    for (int dt : {DT, 0})
-    {
-        ERPValues erpv = getErp(nav.erp, time + dt);
-
-        FrameSwapper frameSwapper(time + dt, erpv);
-
-        frameSwapper.setCache(dt);
-    }
-
     loadSBASdata(pppTrace, time, nav);
 
+    // index any newly received ephemerides before the parallel per-station lookups
+    syncEphIndices(nav);
+
     // try to get svns & block types of all used satellites
     for (auto& [Sat, satNav] : nav.satNavMap)
     {
@@ -723,7 +810,7 @@ int main(int argc, char** argv)
     boost::posix_time::ptime logptime = currentLogptime();
     createDirectories(logptime);
 
-    reloadInputFiles();
+    reloadInputFiles(GTime::noTime());
 
     addDefaultBias();
 
@@ -1023,6 +1110,8 @@ int main(int argc, char** argv)
                     streamParser_ptr->parse();
                 }
 
+            preloadRinexObservations();
+
             for (auto& [id, streamParser_ptr] : streamParserMultimap)
             {
                 ObsStream* obsStream_ptr;
@@ -1249,6 +1338,8 @@ int main(int argc, char** argv)
 
     mainPostProcessing(pppNet, ionNet, receiverMap);
 
+    waitForProductQueues();
+
     GTime peaStopTime = timeGet();
     BOOST_LOG_TRIVIAL(info) << "\n"
                             << "PEA started  processing at : " << peaStartTime << "\n"
@@ -604,12 +604,14 @@ void mincon(
             // create a subset matrix for positions only
             vector<int> posIndices;
             for (int i = 0; i < T.rows(); i++)
-            {
-                if (T.row(i).any())
+                for (DesignMatrix::InnerIterator it(T, i); it; ++it)
                 {
-                    posIndices.push_back(i);
+                    if (it.value() != 0)
+                    {
+                        posIndices.push_back(i);
+                        break;
+                    }
                 }
-            }
 
             // calculate position deltas and their variances according to transform
             VectorXd tTheta = T * Theta;  // will correspond to (but not be) pseudoobservations
@@ -806,30 +806,30 @@ void removeBadAmbiguities(
             }
 
             auto& rec     = *key.rec_ptr;
-            auto& satStat = rec.satStatMap[key.Sat];
+            auto& satStat = rec.satStats[key.Sat];
 
-            string preprocSigName;
-            string sigName;
+            SigStat* sigStat_ptr;
+            SigStat* preprocSigStat_ptr;
 
             if (acsConfig.process_ppp)
             {
                 E_ObsCode obsCode = int_to_enum<E_ObsCode>(key.num);
                 E_FType   ft      = code2Freq[key.Sat.sys][obsCode];
 
-                preprocSigName = ft2string(ft);
-                sigName        = enum_to_string(obsCode);
+                preprocSigStat_ptr = &satStat.sigStats[ft];
+                sigStat_ptr        = &satStat.sigStats[obsCode];
             }
             else
             {
                 E_FType ft = (E_FType)key.num;
 
-                preprocSigName =
-                    ft2string(ft);  // todo aaron, is this redundant now that network is gone?
-                sigName = preprocSigName;
+                preprocSigStat_ptr =
+                    &satStat.sigStats[ft];  // todo aaron, is this redundant now that network is gone?
+                sigStat_ptr = preprocSigStat_ptr;
             }
 
-            auto& sigStat        = satStat.sigStatMap[sigName];
-            auto& preprocSigStat = satStat.sigStatMap[preprocSigName];
+            auto& sigStat        = *sigStat_ptr;
+            auto& preprocSigStat = *preprocSigStat_ptr;
 
             if (sigStat.phaseRejectCount >= acsConfig.ambErrors.phase_reject_limit)
             {
@@ -894,7 +894,7 @@ void removeBadAmbiguities(
 
             // for ionosphere free, need to reset all connected singals
             if (acsConfig.pppOpts.ionoOpts.use_if_combo)
-                for (auto& [sigNam, sigStat] : satStat.sigStatMap)
+                for (auto& sigStat : satStat.sigStats)
                 {
                     if (sigStat.savedSlip.any &&
                         ((acsConfig.ambErrors.resetOnSlip.LLI && sigStat.savedSlip.LLI) ||
@@ -937,8 +937,8 @@ void removeBadAmbiguities(
         }
 
     for (auto& [id, rec] : receiverMap)
-        for (auto& [sat, satStat] : rec.satStatMap)
-            for (auto& [sig, sigStat] : satStat.sigStatMap)
+        for (auto& satStat : rec.satStats)
+            for (auto& sigStat : satStat.sigStats)
             {
                 sigStat.savedSlip.any = false;
             }
@@ -1076,7 +1076,7 @@ void removeBadIonospheres(
         if (key.rec_ptr == nullptr)
         {
             auto& rec     = *key.rec_ptr;
-            auto& satStat = rec.satStatMap[key.Sat];
+            auto& satStat = rec.satStats[key.Sat];
 
             if (satStat.lastIonTime != GTime::noTime() &&
                 (tsync - satStat.lastIonTime).to_double() >
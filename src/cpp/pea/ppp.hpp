@@ -50,6 +50,23 @@ void spp(
     KFState*  remote_ptr  = nullptr
 );
 
+bool raimExhaustive(
+    Trace&    trace,
+    ObsList&  obsList,
+    Solution& sol,
+    string    id,
+    KFState*  kfState_ptr
+);
+
+bool raim(
+    Trace&    trace,
+    ObsList&  obsList,
+    Solution& sol,
+    string    id,
+    KFState*  kfState_ptr,
+    KFMeas*   sppMeas_ptr
+);
+
 void testEclipse(ObsList& obsList);
 
 void pppCorrections(Trace& trace, ObsList& obsList, Vector3d& rRec, Receiver& rec);
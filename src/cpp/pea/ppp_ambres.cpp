@@ -20,6 +20,10 @@
 
 static bool filterError = false;
 
+/** Lambda warm starts carried between epochs, by filter id
+ */
+static map<string, map<KFKey, LambdaWarmStart>> lambdaWarmStartMaps;
+
 bool recordFilterError(RejectCallbackDetails rejectDetails)
 {
     filterError = true;
@@ -176,6 +180,89 @@ void applyUCAmbiguities(
     kfState.filterKalman(trace, kfMeas, "/AR", true);
 }
 
+/** Condition the filter on the fixed ambiguity combinations directly, using the Schur complement.
+ * Only the columns of the covariance that correspond to ambiguities are multiplied, and the generic
+ * measurement construction and pre/postfit checks of filterKalman are skipped.
+ */
+bool conditionOnFixedAmbiguities(
+    Trace&     trace,    ///< Debug trace
+    KFState&   kfState,  ///< Reference to Kalman filter containing float solutions
+    GinAR_mtx& mtrx  ///< Reference to structure containing fixed ambiguities and Z transformations
+)
+{
+    int nz = mtrx.zfix.size();
+    int nx = mtrx.ambmap.size();
+
+    tracepdeex(1, trace, "   %d out of %d ambiguities resolved, conditioning...\n", nz, nx);
+
+    vector<int> indices;
+    indices.reserve(nx);
+    for (int j = 0; j < nx; j++)
+    {
+        auto it = kfState.kfIndexMap.find(mtrx.ambmap[j]);
+        if (it == kfState.kfIndexMap.end())
+        {
+            return false;
+        }
+
+        auto& [key, index] = *it;
+        indices.push_back(index);
+    }
+
+    MatrixXd& Z = mtrx.Ztrs;
+
+    for (int i = 0; i < nz; i++)
+    {
+        tracepdeex(4, trace, "      Applying:  ");
+
+        for (int j = 0; j < nx; j++)
+        {
+            if (Z(i, j) == 0)
+            {
+                continue;
+            }
+
+            KFKey& key = mtrx.ambmap[j];
+
+            tracepdeex(
+                4,
+                trace,
+                "%+3.0f A(%s,%s,%3s) ",
+                Z(i, j),
+                key.str.c_str(),
+                key.Sat.id().c_str(),
+                key.code().c_str()
+            );
+        }
+
+        tracepdeex(4, trace, "= %+10.5f\n", mtrx.zfix(i));
+    }
+
+    // innovations of the integer constraints, and cross covariance of all states with them
+    VectorXd v   = mtrx.zfix - Z * kfState.x(indices);
+    MatrixXd PZt = kfState.P(all, indices) * Z.transpose();
+    MatrixXd S   = Z * PZt(indices, all);
+    S.diagonal().array() += FIXED_AMB_VAR;
+
+    LDLT<MatrixXd> ldlt(S);
+    if (ldlt.info() != Eigen::Success || ldlt.isPositive() == false)
+    {
+        tracepdeex(1, trace, "WARNING: fixed ambiguity covariance not positive definite\n");
+        return false;
+    }
+
+    MatrixXd K = ldlt.solve(PZt.transpose()).transpose();
+
+    kfState.dx = K * v;
+    kfState.x += kfState.dx;
+    kfState.P -= K * PZt.transpose();
+
+    // remove asymmetry from rounding
+    kfState.P = (kfState.P + kfState.P.transpose()).eval() / 2;
+
+    return true;
+}
+
 void fixAndHoldAmbiguities(
     Trace&   trace,   ///< Debug trace
     KFState& kfState  ///< Filter state
@@ -219,11 +306,15 @@ void fixAndHoldAmbiguities(
     ARmtx.Paflt = kfState.P(indices, indices);
 
     GinAR_opt ARopt;
-    ARopt.mode   = acsConfig.ambrOpts.mode;
-    ARopt.sucthr = acsConfig.ambrOpts.succsThres;
-    ARopt.ratthr = acsConfig.ambrOpts.ratioThres;
-    ARopt.nset   = acsConfig.ambrOpts.lambda_set;
-    ARopt.nitr   = acsConfig.ambrOpts.AR_max_itr;
+    ARopt.mode      = acsConfig.ambrOpts.mode;
+    ARopt.partition = acsConfig.ambrOpts.partition;
+    ARopt.sucthr    = acsConfig.ambrOpts.succsThres;
+    ARopt.ratthr    = acsConfig.ambrOpts.ratioThres;
+    ARopt.nset      = acsConfig.ambrOpts.lambda_set;
+    ARopt.nitr      = acsConfig.ambrOpts.AR_max_itr;
+
+    if (acsConfig.ambrOpts.warm_start)
+        ARopt.warmStartMap_ptr = &lambdaWarmStartMaps[kfState.id];
 
     if (traceLevel > 4)
         AR_VERBO = true;
@@ -232,7 +323,17 @@ void fixAndHoldAmbiguities(
     int nfix = GNSS_AR(trace, ARmtx, ARopt);
     if (nfix > 0)
     {
-        applyUCAmbiguities(trace, kfState, ARmtx);
+        // filters being smoothed need the constraints recorded as measurements
+        bool conditioned = false;
+        if (kfState.rts_basename.empty())
+        {
+            conditioned = conditionOnFixedAmbiguities(trace, kfState, ARmtx);
+        }
+
+        if (conditioned == false)
+        {
+            applyUCAmbiguities(trace, kfState, ARmtx);
+        }
     }
 
     while (0)
@@ -64,9 +64,8 @@ bool deweightMeas(RejectCallbackDetails rejectDetails)
          {"postDeweightSigma", preSigma * deweightFactor}}
     );
 
-    kfMeas.R.row(measIndex) *= deweightFactor;
-    kfMeas.R.col(measIndex) *= deweightFactor;
-    if (kfMeas.H_star.size() > 0)
+    kfMeas.R.scale(measIndex, deweightFactor);
+    if (kfMeas.H_star.rows() > 0)
         kfMeas.H_star.row(measIndex) *= deweightFactor;
 
     map<string, void*>& metaDataMap = kfMeas.metaDataMaps[measIndex];
@@ -82,8 +81,8 @@ bool deweightMeas(RejectCallbackDetails rejectDetails)
         trace << "\n" << obs.Sat.id() << " will be excluded next SPP iteration";
     }
 
-    MatrixXd* otherNoiseMatrix_ptr = (MatrixXd*)metaDataMap["otherNoiseMatrix_ptr"];
-    long int  otherIndex           = (long int)metaDataMap["otherIndex"];
+    NoiseMatrix* otherNoiseMatrix_ptr = (NoiseMatrix*)metaDataMap["otherNoiseMatrix_ptr"];
+    long int     otherIndex           = (long int)metaDataMap["otherIndex"];
 
     if (otherNoiseMatrix_ptr)
     {
@@ -91,8 +90,7 @@ bool deweightMeas(RejectCallbackDetails rejectDetails)
         // its available.
         auto& otherNoiseMatrix = *otherNoiseMatrix_ptr;
 
-        otherNoiseMatrix.row(otherIndex) *= deweightFactor;
-        otherNoiseMatrix.col(otherIndex) *= deweightFactor;
+        otherNoiseMatrix.scale(otherIndex, deweightFactor);
     }
 
     return false;
@@ -113,7 +111,7 @@ bool pseudoMeasTest(RejectCallbackDetails rejectDetails)
 
     for (auto& [key, stateIndex] : kfState.kfIndexMap)
     {
-        if (kfMeas.H(measIndex, stateIndex) &&
+        if (kfMeas.H.coeff(measIndex, stateIndex) &&
             key.type == KF::ORBIT)  // Eugene: do this to other pseudoObs as well?
         {
             rejectDetails.kfKey      = key;
@@ -165,9 +163,8 @@ bool deweightStationMeas(RejectCallbackDetails rejectDetails)
 
         addRejectDetails(kfState.time, trace, kfState, key, "Station Meas Deweighted", description);
 
-        kfMeas.R.row(i) *= deweightFactor;
-        kfMeas.R.col(i) *= deweightFactor;
-        if (kfMeas.H_star.size() > 0)
+        kfMeas.R.scale(i, deweightFactor);
+        if (kfMeas.H_star.rows() > 0)
             kfMeas.H_star.row(i) *= deweightFactor;
 
         map<string, void*>& metaDataMap = kfMeas.metaDataMaps[i];
@@ -179,8 +176,8 @@ bool deweightStationMeas(RejectCallbackDetails rejectDetails)
             *used_ptr = false;
         }
 
-        MatrixXd* otherNoiseMatrix_ptr = (MatrixXd*)metaDataMap["otherNoiseMatrix_ptr"];
-        long int  otherIndex           = (long int)metaDataMap["otherIndex"];
+        NoiseMatrix* otherNoiseMatrix_ptr = (NoiseMatrix*)metaDataMap["otherNoiseMatrix_ptr"];
+        long int     otherIndex           = (long int)metaDataMap["otherIndex"];
 
         if (otherNoiseMatrix_ptr)
         {
@@ -188,8 +185,7 @@ bool deweightStationMeas(RejectCallbackDetails rejectDetails)
             // if its available.
             auto& otherNoiseMatrix = *otherNoiseMatrix_ptr;
 
-            otherNoiseMatrix.row(otherIndex) *= deweightFactor;
-            otherNoiseMatrix.col(otherIndex) *= deweightFactor;
+            otherNoiseMatrix.scale(otherIndex, deweightFactor);
         }
     }
 
@@ -454,7 +450,7 @@ bool rejectAllMeasByState(RejectCallbackDetails rejectDetails)
 
     for (int measIndex = 0; measIndex < kfMeas.H.rows(); measIndex++)
     {
-        if (kfMeas.H(measIndex, stateIndex))
+        if (kfMeas.H.coeff(measIndex, stateIndex))
         {
             rejectDetails.measIndex = measIndex;
 
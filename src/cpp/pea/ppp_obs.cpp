@@ -129,7 +129,18 @@ tideDelta(Trace& trace, GTime time, Receiver& rec, VectorEcef& rRec, ReceiverOpt
             if (recOpts.tideModels.solid || recOpts.tideModels.otl || recOpts.tideModels.atl ||
                 recOpts.tideModels.spole || recOpts.tideModels.opole)
             {
-                tideDisp(trace, time, rec.id, rRec, solid, otl, atl, spole, opole);
+                tideDisp(
+                    trace,
+                    time,
+                    rec.id,
+                    rRec,
+                    solid,
+                    otl,
+                    atl,
+                    spole,
+                    opole,
+                    &rec.tideInterpolator
+                );
             }
 
             return {solid, otl, atl, spole, opole};
@@ -581,10 +592,12 @@ inline static void pppRecPCV(COMMON_PPP_ARGS)
             recAtxFt = F1;
     }
 
-    double az  = 0;
-    double zen = 0;
-    double recPCVDelta =
-        antPcv(rec.antennaId, Sat.sys, recAtxFt, time, rec.attStatus, satStat.e * +1, &az, &zen);
+    auto& pcvHandle = rec.recPcvHandles[Sat.sys];
+    pcvHandle.bind(rec.antennaId, Sat.sys, time);
+
+    double az          = 0;
+    double zen         = 0;
+    double recPCVDelta = pcvHandle.evaluate(rec.attStatus, satStat.e * +1, recAtxFt, &az, &zen);
 
     InitialState init = initialStateFromConfig(recOpts.pcv);
 
@@ -651,8 +664,11 @@ inline static void pppSatPCV(COMMON_PPP_ARGS)
             satAtxFt = F1;
     }
 
-    double satPCVDelta =
-        antPcv(Sat.id(), Sat.sys, satAtxFt, time, satNav.attStatus, satStat.e * -1);
+    // handles are kept per receiver so that they may be bound from parallel receiver threads
+    auto& pcvHandle = rec.satPcvHandles[Sat];
+    pcvHandle.bind(Sat.id(), Sat.sys, time);
+
+    double satPCVDelta = pcvHandle.evaluate(satNav.attStatus, satStat.e * -1, satAtxFt);
 
     measEntry.componentsMap[E_Component::SAT_PCV] = {satPCVDelta, "+ PCV_s", 0};
 }
@@ -1038,9 +1054,12 @@ inline static void pppIonModel(COMMON_PPP_ARGS)
             Sat.id()
         );
 
-        for (int i = 0; i < acsConfig.ionModelOpts.numBasis; i++)
+        vector<double> coeffs;
+        ionModelCoefs(trace, obs, coeffs);
+
+        for (int i = 0; i < coeffs.size(); i++)
         {
-            double coeff = ionModelCoef(trace, i, obs);
+            double coeff = coeffs[i];
 
             if (coeff == 0)
                 continue;
@@ -1715,6 +1734,7 @@ void receiverUducGnss(
         return;
     }
 
+    vector<GObs*> satPosObsList;
     for (auto& obs : only<GObs>(rec.obsList))
     {
         if (acsConfig.process_sys[obs.Sat.sys] == false)
@@ -1722,20 +1742,22 @@ void receiverUducGnss(
             continue;
         }
 
-        auto& satOpts = acsConfig.getSatOpts(obs.Sat);
+        satPosObsList.push_back(&obs);
+    }
 
-        satPosClk(
-            trace,
-            obs.time,
-            obs,
-            nav,
-            satOpts.posModel.sources,
-            satOpts.clockModel.sources,
-            &kfState,
-            &remoteKF,
-            E_OffsetType::COM,
-            E_Relativity::OFF
-        );
+    satPosClks(
+        trace,
+        satPosObsList,
+        nav,
+        &kfState,
+        &remoteKF,
+        E_OffsetType::COM,
+        E_Relativity::OFF
+    );
+
+    for (auto obs_ptr : satPosObsList)
+    {
+        auto& obs = *obs_ptr;
 
         traceJson(
             1,
@@ -1863,8 +1885,8 @@ void receiverUducGnss(
 
                     SatNav&  satNav         = *obs.satNav_ptr;
                     SatStat& satStat        = *obs.satStat_ptr;
-                    SigStat& sigStat        = satStat.sigStatMap[sigName];
-                    SigStat& preprocSigStat = satStat.sigStatMap[ft2string(ft)];
+                    SigStat& sigStat        = satStat.sigStats[sig.code];
+                    SigStat& preprocSigStat = satStat.sigStats[ft];
 
                     if (preprocSigStat.slip.any)
                     {
@@ -72,7 +72,7 @@ Architecture Combinators__() {}
 struct Duo
 {
     map<KFKey, int>& indexMap;
-    MatrixXd&        designMatrix;
+    DesignMatrix&    designMatrix;
 };
 
 void explainMeasurements(Trace& trace, KFMeas& kfMeas, KFState& kfState)
@@ -94,15 +94,17 @@ void explainMeasurements(Trace& trace, KFMeas& kfMeas, KFState& kfState)
 
         for (auto duo :
              {Duo{kfState.kfIndexMap, kfMeas.H}, Duo{kfMeas.noiseIndexMap, kfMeas.H_star}})
-            for (int col = 0; col < duo.designMatrix.cols(); col++)
+        {
+            if (duo.designMatrix.cols() > 0)
             {
-                if (col == 0)
-                {
-                    trace << "\n"
-                          << "============================";
-                }
+                trace << "\n"
+                      << "============================";
+            }
 
-                double entry = duo.designMatrix(i, col);
+            for (DesignMatrix::InnerIterator it(duo.designMatrix, i); it; ++it)
+            {
+                int    col   = it.col();
+                double entry = it.value();
 
                 if (entry == 0)
                 {
@@ -122,6 +124,7 @@ void explainMeasurements(Trace& trace, KFMeas& kfMeas, KFState& kfState)
                     }
                 }
             }
+        }
         trace << "\n";
     }
 }
@@ -143,24 +146,23 @@ void alternatePostfits(Trace& trace, KFMeas& kfMeas, KFState& kfState)
         bool first = true;
 
         for (int row = 0; row < kfMeas.H_star.rows(); row++)
-        {
-            double& entry = kfMeas.H_star(row, col);
-
-            if (entry == 0)
+            for (DesignMatrix::InnerIterator it(kfMeas.H_star, row); it; ++it)
             {
-                continue;
-            }
+                if (it.col() != col || it.value() == 0)
+                {
+                    continue;
+                }
 
-            if (first)
-            {
-                first = false;
+                if (first)
+                {
+                    first = false;
 
-                trace << "\n"
-                      << "Removing " << kfKey << " from postfit residual calculations";
-            }
+                    trace << "\n"
+                          << "Removing " << kfKey << " from postfit residual calculations";
+                }
 
-            entry = 0;
-        }
+                it.valueRef() = 0;
+            }
     }
 }
 
@@ -339,12 +341,12 @@ KFMeas makeGFLCs(KFMeas& kfMeas, KFState& kfState)
                 continue;
             for (int i_2 = 0; i_2 < kfMeas.obsKeys.size(); i_2++)
             {
-                double coeff_2 = duo.designMatrix(i_2, index);
+                double coeff_2 = duo.designMatrix.coeff(i_2, index);
                 if (coeff_2 == 0)
                     continue;
                 for (int i_1 = 0; i_1 < i_2; i_1++)
                 {
-                    double coeff_1 = duo.designMatrix(i_1, index);
+                    double coeff_1 = duo.designMatrix.coeff(i_1, index);
                     if (coeff_1 == 0)
                         continue;
                     {
@@ -454,12 +456,12 @@ KFMeas makeRTKLCs1(KFMeas& kfMeas, KFState& kfState)
                 continue;
             for (int i_2 = 0; i_2 < kfMeas.obsKeys.size(); i_2++)
             {
-                double coeff_2 = duo.designMatrix(i_2, index);
+                double coeff_2 = duo.designMatrix.coeff(i_2, index);
                 if (coeff_2 == 0)
                     continue;
                 for (int i_1 = 0; i_1 < i_2; i_1++)
                 {
-                    double coeff_1 = duo.designMatrix(i_1, index);
+                    double coeff_1 = duo.designMatrix.coeff(i_1, index);
                     if (coeff_1 == 0)
                         continue;
                     {
@@ -568,12 +570,12 @@ KFMeas makeRTKLCs2(KFMeas& kfMeas, KFState& kfState)
                 continue;
             for (int i_2 = 0; i_2 < kfMeas.obsKeys.size(); i_2++)
             {
-                double coeff_2 = duo.designMatrix(i_2, index);
+                double coeff_2 = duo.designMatrix.coeff(i_2, index);
                 if (coeff_2 == 0)
                     continue;
                 for (int i_1 = 0; i_1 < i_2; i_1++)
                 {
-                    double coeff_1 = duo.designMatrix(i_1, index);
+                    double coeff_1 = duo.designMatrix.coeff(i_1, index);
                     if (coeff_1 == 0)
                         continue;
                     {
@@ -893,7 +895,7 @@ void updateAvgIonosphere(
 
         auto& rec = *key.rec_ptr;
 
-        auto& satStat = rec.satStatMap[key.Sat];
+        auto& satStat = rec.satStats[key.Sat];
 
         double diono  = 0;
         double dummy  = 0;
@@ -943,6 +945,8 @@ void updateAvgOrbits(
 
     FrameSwapper frameSwapper(time, erpv);
 
+    vector<KFKey>  keyList;
+    vector<SatPos> satPosList;
     for (auto& [key, index] : kfState.kfIndexMap)
     {
         if (key.type != KF::ORBIT || key.num != 0)
@@ -954,8 +958,19 @@ void updateAvgOrbits(
         satPos.Sat        = key.Sat;
         satPos.satNav_ptr = &nav.satNavMap[key.Sat];
 
-        bool pass = satPosBroadcast(trace, time, time, satPos, nav);
-        if (pass == false)
+        keyList.push_back(key);
+        satPosList.push_back(satPos);
+    }
+
+    vector<bool> passList;
+    satPosBroadcast(trace, time, time, satPosList, passList, nav);
+
+    for (int s = 0; s < keyList.size(); s++)
+    {
+        auto& key    = keyList[s];
+        auto& satPos = satPosList[s];
+
+        if (passList[s] == false)
         {
             continue;
         }
@@ -1229,6 +1244,25 @@ void chunkFilter(
     map<string, int> begX;
     map<string, int> endX;
 
+    // find the first and last measurements referencing each state in one pass over the design
+    vector<int> firstH(kfMeas.H.cols(), -1);
+    vector<int> lastH(kfMeas.H.cols(), -1);
+    for (int h = 0; h < kfMeas.H.rows(); h++)
+        for (DesignMatrix::InnerIterator it(kfMeas.H, h); it; ++it)
+        {
+            if (it.value() == 0)
+            {
+                continue;
+            }
+
+            if (firstH[it.col()] < 0)
+            {
+                firstH[it.col()] = h;
+            }
+
+            lastH[it.col()] = h;
+        }
+
     // Find chunks based on state variables
     for (auto& [kfKey, x] : kfState.kfIndexMap)
     {
@@ -1249,22 +1283,16 @@ void chunkFilter(
         }
 
         // Find corresponding measurements in H matrix
-        for (int h = 0; h < kfMeas.H.rows(); h++)
+        if (x < firstH.size() && firstH[x] >= 0)
         {
-            // std::cout << "Checking measurement " << h << " for chunkId " << chunkId << " : " <<
-            // kfMeas.H(h,x) <<
-            // "\n";
-            if (kfMeas.H(h, x))
+            // Fixed initialization bug: check if chunkId exists before accessing
+            if (begH.find(chunkId) == begH.end() || firstH[x] < begH[chunkId])
             {
-                // Fixed initialization bug: check if chunkId exists before accessing
-                if (begH.find(chunkId) == begH.end() || h < begH[chunkId])
-                {
-                    begH[chunkId] = h;
-                }
-                if (endH.find(chunkId) == endH.end() || h > endH[chunkId])
-                {
-                    endH[chunkId] = h;
-                }
+                begH[chunkId] = firstH[x];
+            }
+            if (endH.find(chunkId) == endH.end() || lastH[x] > endH[chunkId])
+            {
+                endH[chunkId] = lastH[x];
             }
         }
     }
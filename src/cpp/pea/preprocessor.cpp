@@ -293,7 +293,7 @@ bool computeSatellitePosition(
     double&    az
 )
 {
-    auto& satStat = rec.satStatMap[sat];
+    auto& satStat = rec.satStats[sat];
     auto& satOpts = acsConfig.getSatOpts(sat);
 
     // If satellite was observed, use pre-computed position
@@ -623,7 +623,7 @@ void recordSlips(Receiver& rec)
         {
             if (obs.satStat_ptr)
             {
-                SigStat& sigStat = obs.satStat_ptr->sigStatMap[ft2string(ft)];
+                SigStat& sigStat = obs.satStat_ptr->sigStats[ft];
 
                 if (sigStat.slip.any &&
                     ((acsConfig.exclude.LLI && sigStat.slip.LLI) ||
@@ -706,6 +706,7 @@ void preprocessor(
     VectorPos pos = ecef2pos(rec.aprioriPos);
 
     // prepare and connect navigation objects to the observations
+    vector<GObs*> satPosObsList;
     for (auto& obs : only<GObs>(obsList))
     {
         obs.mount = rec.id;
@@ -727,7 +728,7 @@ void preprocessor(
         }
 
         auto& satNav  = nav.satNavMap[obs.Sat];
-        auto& satStat = rec.satStatMap[obs.Sat];
+        auto& satStat = rec.satStats[obs.Sat];
 
         obs.rec_ptr     = &rec;
         obs.satNav_ptr  = &satNav;
@@ -735,17 +736,15 @@ void preprocessor(
 
         updateLamMap(obs.time, obs);
 
-        satPosClk(
-            trace,
-            obs.time,
-            obs,
-            nav,
-            satOpts.posModel.sources,
-            satOpts.clockModel.sources,
-            kfState_ptr,
-            remote_ptr,
-            E_OffsetType::APC
-        );
+        satPosObsList.push_back(&obs);
+    }
+
+    satPosClks(trace, satPosObsList, nav, kfState_ptr, remote_ptr, E_OffsetType::APC);
+
+    for (auto obs_ptr : satPosObsList)
+    {
+        auto& obs     = *obs_ptr;
+        auto& satStat = *obs.satStat_ptr;
 
         Vector3d rSat = obs.rSatApc;
         if (rSat.isZero())
@@ -778,7 +777,7 @@ void preprocessor(
         }
     obs2lcs(trace, obsList);
     obsVariances(obsList);
-    detectslips(trace, obsList);
+    detectslips(trace, obsList, rec.slipDetector);
 
     recordSlips(rec);
 
@@ -786,7 +785,7 @@ void preprocessor(
         for (auto& [ft, Sig] : obs.sigs)
             if (obs.satStat_ptr)
             {
-                if (obs.satStat_ptr->sigStatMap[ft2string(ft)].slip.any)
+                if (obs.satStat_ptr->sigStats[ft].slip.any)
                 {
                     rec.slipCount++;
                     break;
@@ -1,6 +1,8 @@
 // #pragma GCC optimize ("O0")
 
 #include <algorithm>
+#include <boost/math/distributions/chi_squared.hpp>
+#include <boost/math/distributions/normal.hpp>
 #include <math.h>
 #include <sstream>
 #include <string>
@@ -478,7 +480,8 @@ E_Solution estpos(
     string    id,                     ///< Id of receiver
     KFState*  kfState_ptr = nullptr,  ///< Optional kfstate pointer to retrieve ppp values from
     string    description = "SPP",    ///< Description to prepend to clarify outputs
-    bool      inRaim      = false     ///< Is in RAIM
+    bool      inRaim      = false,    ///< Is in RAIM
+    KFMeas*   kfMeas_ptr  = nullptr   ///< Optional output of the measurements of the last iteration
 )
 {
     if (obsList.empty())
@@ -871,6 +874,11 @@ E_Solution estpos(
             return E_Solution::FAILED;
         }
 
+        if (kfMeas_ptr)
+        {
+            *kfMeas_ptr = kfMeas;
+        }
+
         if (traceLevel >= 4)
         {
             outputResiduals(trace, kfMeas, suffix, iter, 0, kfMeas.H.rows());
@@ -970,7 +978,7 @@ E_Solution estpos(
  * Note: This is a simplified version of RAIM algorithm that tries to exclude multiple outliers
  * iteratively instead of checking all possible subsets when more than one outliers present
  */
-bool raim(
+bool raimExhaustive(
     Trace&    trace,    ///< Trace file to output to
     ObsList&  obsList,  ///< List of observations for this epoch
     Solution& sol,      ///< Solution object containing initial conditions and results
@@ -1197,6 +1205,470 @@ bool raim(
     return false;
 }
 
+/** Normal equations of a linearised pseudorange least squares solution.
+ * Measurements are removed by rank-one downdates, so the solution for any subset can be found
+ * without relinearising or rebuilding the measurements.
+ */
+struct RaimNormalEquations
+{
+    MatrixXd    N;               ///< Normal matrix H'WH
+    VectorXd    b;               ///< Weighted innovations H'Wv
+    double      c       = 0;     ///< Weighted sum of squared innovations v'Wv
+    vector<int> stateMeasCount;  ///< Number of measurements referencing each state
+    int         numMeas = 0;     ///< Number of measurements
+
+    RaimNormalEquations(int numX)
+    {
+        N              = MatrixXd::Zero(numX, numX);
+        b              = VectorXd::Zero(numX);
+        stateMeasCount = vector<int>(numX, 0);
+    }
+
+    /** Add (sign = 1) or remove (sign = -1) a measurement
+     */
+    void update(
+        const VectorXd& h,    ///< Design row of the measurement
+        double          w,    ///< Weight of the measurement
+        double          v,    ///< Innovation of the measurement
+        int             sign  ///< Direction of the update
+    )
+    {
+        N.selfadjointView<Eigen::Lower>().rankUpdate(h, sign * w);
+        b += sign * w * v * h;
+        c += sign * w * v * v;
+
+        for (int i = 0; i < h.rows(); i++)
+            if (h(i) != 0)
+                stateMeasCount[i] += sign;
+
+        numMeas += sign;
+    }
+
+    /** Solve for the chi-square statistic and degrees of freedom of the current set of measurements
+     */
+    bool solve(
+        double& chi2,  ///< Chi-square of the postfit residuals
+        int&    dof    ///< Degrees of freedom
+    ) const
+    {
+        // states that are no longer measured are removed, as in estpos()
+        vector<int> usedStates;
+        for (int i = 0; i < stateMeasCount.size(); i++)
+            if (stateMeasCount[i] > 0)
+                usedStates.push_back(i);
+
+        dof = numMeas - usedStates.size();
+        if (dof < 1)
+        {
+            return false;
+        }
+
+        MatrixXd Nsub = N.selfadjointView<Eigen::Lower>();
+        Nsub          = Nsub(usedStates, usedStates).eval();
+        VectorXd bsub = b(usedStates);
+
+        LDLT<MatrixXd> ldlt(Nsub);
+        if (ldlt.info() != Eigen::Success || ldlt.isPositive() == false)
+        {
+            return false;
+        }
+
+        chi2 = c - bsub.dot(ldlt.solve(bsub));
+        return true;
+    }
+};
+
+/** Relative tolerance within which candidates evaluated from the linearised normal equations are
+ * confirmed with full solutions, covering the change of linearisation point when excluding
+ */
+const double RAIM_CONFIRM_TOLERANCE = 0.1;
+
+/** Candidate exclusion evaluated from downdated normal equations
+ */
+struct RaimCandidate
+{
+    GObs*               obs_ptr;  ///< Observation to exclude
+    E_Solution          status;   ///< Expected status of a solution without the observation
+    double              chi2;     ///< Chi-square without the observation
+    double              qc;       ///< Chi-square threshold without the observation
+    double              gdop;     ///< GDOP without the observation
+    double              var;      ///< Chi-square per degree of freedom without the observation
+    bool                solved;   ///< The linearised solution without the observation was found
+    RaimNormalEquations normEqs;  ///< Normal equations without the observation
+};
+
+/** Receiver autonomous integrity monitoring (RAIM) failure detection and exclusion.
+ * Gives the same exclusions as raimExhaustive(), with fewer full solutions. Each candidate
+ * exclusion is first evaluated by downdating the normal equations of a single baseline solution,
+ * applying the chi-square and DOP checks of estpos(). Full solutions are then only computed for
+ * candidates that may pass these checks, or that are near the best linearised chi-square per
+ * degree of freedom. The best of those is selected as in raimExhaustive().
+ * Falls back to raimExhaustive() if there is no converged baseline solution.
+ */
+bool raim(
+    Trace&    trace,                  ///< Trace file to output to
+    ObsList&  obsList,                ///< List of observations for this epoch
+    Solution& sol,                    ///< Solution object containing initial conditions and results
+    string    id,                     ///< Id of receiver
+    KFState*  kfState_ptr = nullptr,  ///< Optional kfstate pointer to retrieve ppp values from
+    KFMeas*   sppMeas_ptr = nullptr   ///< Optional measurements of the SPP solution that failed
+)
+{
+    map<SatSys, SatStat> origSatStats;
+    map<SatSys, SatStat> bestSatStats;
+
+    auto backupSatStats = [&](map<SatSys, SatStat>& dest, bool backup)
+    {
+        for (auto& obs : only<GObs>(obsList))
+        {
+            if (obs.exclude)
+            {
+                continue;
+            }
+
+            if (backup)
+                dest[obs.Sat] = *obs.satStat_ptr;
+            else
+                *obs.satStat_ptr = dest[obs.Sat];
+        }
+    };
+
+    // Backup original satStats
+    backupSatStats(origSatStats, true);
+
+    // Baseline solution using all observations, keeping its final linearisation.
+    // The measurements of the spp solution that triggered RAIM are reused if they are available
+    KFMeas  baseMeas;
+    ObsList baseList;
+    if (sppMeas_ptr && sppMeas_ptr->H.rows() > 0 && sol.status == E_Solution::SINGLE_X)
+    {
+        baseMeas = *sppMeas_ptr;
+    }
+    else
+    {
+        // Solve on copies so that the observations are only updated from the chosen subset
+        for (auto& obs : only<GObs>(obsList))
+        {
+            if (obs.exclude == false)
+                baseList.push_back((shared_ptr<GObs>)obs);
+        }
+
+        Solution   baseSol    = sol;
+        E_Solution baseStatus = estpos(
+            trace,
+            baseList,
+            baseSol,
+            id,
+            kfState_ptr,
+            (string) "RAIM/" + id,
+            true,
+            &baseMeas
+        );
+
+        backupSatStats(origSatStats, false);
+
+        if (baseStatus != E_Solution::SINGLE && baseStatus != E_Solution::SINGLE_X)
+        {
+            return raimExhaustive(trace, obsList, sol, id, kfState_ptr);
+        }
+    }
+
+    trace << "\n" << tsync << "\tPerforming RAIM.";
+
+    int numMeas = baseMeas.H.rows();
+    int numX    = baseMeas.H.cols();
+
+    map<SatSys, int>    measIndexMap;
+    vector<VectorXd>    measH(numMeas);
+    vector<double>      measW(numMeas);
+    RaimNormalEquations normEqs(numX);
+
+    for (int i = 0; i < numMeas; i++)
+    {
+        GObs* obs_ptr = (GObs*)baseMeas.metaDataMaps[i]["sppObs_ptr"];
+
+        measIndexMap[obs_ptr->Sat] = i;
+        measH[i]                   = baseMeas.H.row(i).transpose();
+        measW[i]                   = 1 / baseMeas.R(i, i);
+
+        normEqs.update(measH[i], measW[i], baseMeas.V(i), 1);
+    }
+
+    boost::math::normal normDist;
+    double alpha = cdf(complement(normDist, acsConfig.sppOpts.chiSquareTest.sigma_threshold)) * 2;
+
+    vector<GObs*> exList;
+
+    auto isExcluded = [&](GObs& obs)
+    {
+        return std::find(exList.begin(), exList.end(), &obs) != exList.end();
+    };
+
+    // GDOP check of estpos(), using the geometry of the baseline solution
+    auto gdop = [&](GObs* candObs_ptr)
+    {
+        vector<AzEl> azels;
+        for (auto& obs : only<GObs>(obsList))
+        {
+            if (obs.exclude || &obs == candObs_ptr || isExcluded(obs) ||
+                measIndexMap.find(obs.Sat) == measIndexMap.end())
+            {
+                continue;
+            }
+
+            auto& satStat = *obs.satStat_ptr;
+            if (satStat.el < acsConfig.sppOpts.elevation_mask_deg * D2R)
+            {
+                continue;
+            }
+
+            azels.push_back(satStat);
+        }
+
+        Dops dops = dopCalc(azels);
+
+        return dops.gdop;
+    };
+
+    Solution bestSol = sol;
+    double   bestVar = bestSol.sppState.chi2PerDof;
+
+    int iter;
+    for (iter = 0; iter < acsConfig.sppOpts.raim.max_iterations; iter++)
+    {
+        tracepdeex(4, trace, "\n\nRAIM Iteration: %d", iter);
+
+        if (bestSol.sppState.dof < 2)  // Need dof >=2, otherwise all candidate subsets pass equally
+        {
+            tracepdeex(
+                3,
+                trace,
+                "\n%s: lack of satellites to perform RAIM, numSat=%2d",
+                __FUNCTION__,
+                bestSol.numMeas
+            );
+            return false;
+        }
+
+        // DOPs use the baseline geometry, which full solutions of the last iteration overwrote
+        backupSatStats(origSatStats, false);
+
+        // Evaluate each candidate from the linearised normal equations, in the order that
+        // raimExhaustive() tests them. Observations the baseline did not use leave them unchanged
+        vector<RaimCandidate> candidates;
+        double                minVar = INFINITY;
+
+        for (auto& obs : only<GObs>(obsList))
+        {
+            if (obs.exclude || isExcluded(obs))
+            {
+                continue;
+            }
+
+            RaimCandidate candidate =
+                {&obs, E_Solution::SINGLE_X, 0, 0, 0, INFINITY, false, normEqs};
+
+            auto it = measIndexMap.find(obs.Sat);
+            if (it != measIndexMap.end())
+            {
+                int i = it->second;
+                candidate.normEqs.update(measH[i], measW[i], baseMeas.V(i), -1);
+            }
+
+            int dof;
+            candidate.solved = candidate.normEqs.solve(candidate.chi2, dof);
+            if (dof < 1)
+            {
+                tracepdeex(
+                    3,
+                    trace,
+                    "\n%s: exSat=%s, lack of satellites nSat=%2d",
+                    __FUNCTION__,
+                    obs.Sat.id().c_str(),
+                    candidate.normEqs.numMeas
+                );
+
+                continue;
+            }
+
+            if (candidate.solved)
+            {
+                boost::math::chi_squared chiSqDist(dof);
+
+                // estpos() always enables the chi-square test within RAIM
+                candidate.qc   = quantile(complement(chiSqDist, alpha));
+                candidate.var  = candidate.chi2 / dof;
+                candidate.gdop = gdop(&obs);
+
+                if (candidate.chi2 <= candidate.qc && candidate.gdop > 0 &&
+                    candidate.gdop <= acsConfig.sppOpts.max_gdop)
+                {
+                    candidate.status = E_Solution::SINGLE;
+                }
+
+                minVar = std::min(minVar, candidate.var);
+
+                tracepdeex(
+                    4,
+                    trace,
+                    "\n%s: exSat=%s, linearised chi^2/dof=%f, status=%s",
+                    __FUNCTION__,
+                    obs.Sat.id().c_str(),
+                    candidate.var,
+                    enum_to_string(candidate.status)
+                );
+            }
+
+            candidates.push_back(std::move(candidate));
+        }
+
+        // Confirm candidates that could pass, or could be the best, with full solutions and choose
+        // between them exactly as raimExhaustive() does
+        double tolerance = 1 + RAIM_CONFIRM_TOLERANCE;
+
+        GObs*          exObs_ptr = nullptr;
+        ObsList        bestList;
+        RaimCandidate* best_ptr = nullptr;
+
+        for (auto& candidate : candidates)
+        {
+            bool mayPass = candidate.chi2 <= candidate.qc * tolerance && candidate.gdop > 0 &&
+                           candidate.gdop <= acsConfig.sppOpts.max_gdop * tolerance;
+
+            bool mayBeBest = candidate.var <= minVar * tolerance;
+
+            if (candidate.solved && mayPass == false && mayBeBest == false)
+            {
+                continue;
+            }
+
+            auto& testObs = *candidate.obs_ptr;
+
+            // Restore original satStats before each test
+            backupSatStats(origSatStats, false);
+
+            ObsList candList;
+            for (auto& obs : only<GObs>(obsList))
+            {
+                if (obs.exclude || &obs == &testObs || isExcluded(obs))
+                {
+                    continue;
+                }
+
+                candList.push_back((shared_ptr<GObs>)obs);
+            }
+
+            Solution   candSol = sol;
+            E_Solution status  = estpos(
+                trace,
+                candList,
+                candSol,
+                id,
+                kfState_ptr,
+                (string) "RAIM/" + id + "/" + testObs.Sat.id(),
+                true  // In RAIM, skip sigma check and omega test to avoid interferance with RAIM
+            );
+            if (status == E_Solution::NONE)
+            {
+                continue;
+            }
+
+            if (candSol.sppState.dof < 1)
+            {
+                continue;
+            }
+
+            double candVar = candSol.sppState.chi2PerDof;
+            tracepdeex(
+                3,
+                trace,
+                "\n%s: exSat=%s, chi^2/dof=%f, status=%s",
+                __FUNCTION__,
+                testObs.Sat.id().c_str(),
+                candVar,
+                enum_to_string(status)
+            );
+
+            if ((status < bestSol.status) || (status == bestSol.status && candVar > bestVar))
+            {
+                // This solution is worse
+                continue;
+            }
+
+            bestSol        = candSol;
+            bestSol.status = status;
+            bestVar        = candVar;
+            exObs_ptr      = &testObs;
+            bestList       = candList;
+            best_ptr       = &candidate;
+
+            // Store 'best' satStats for later use
+            backupSatStats(bestSatStats, true);
+        }
+
+        if (exObs_ptr == nullptr)
+        {
+            break;  // No observation excluded, stop iterating as the set hasn't changed
+        }
+
+        exList.push_back(exObs_ptr);
+        normEqs = best_ptr->normEqs;
+
+        if (bestSol.status != E_Solution::SINGLE)
+        {
+            continue;
+        }
+
+        sol = bestSol;
+
+        backupSatStats(
+            bestSatStats,
+            false
+        );  // Update satStats (AzEl and line-of-sight unit vector) w/ best SPP solution
+
+        // Copy best obs to real result
+        for (auto& bestObs : only<GObs>(bestList))
+            for (auto& origObs : only<GObs>(obsList))
+            {
+                if (bestObs.Sat != origObs.Sat)
+                {
+                    // Only use the equivalent obs in the real list according to the best list
+                    continue;
+                }
+
+                origObs.sppValid        = bestObs.sppValid;
+                origObs.sppCodeResidual = bestObs.sppCodeResidual;
+            }
+
+        for (auto& obs_ptr : exList)
+        {
+            obs_ptr->excludeOutlier = true;
+
+            tracepdeex(
+                3,
+                trace,
+                "\n%s\t%s excluded by RAIM",
+                tsync.to_string().c_str(),
+                obs_ptr->Sat.id().c_str()
+            );
+            BOOST_LOG_TRIVIAL(debug) << obs_ptr->Sat.id() << " was excluded from "
+                                     << obsList.front()->mount << " by RAIM";
+        }
+
+        BOOST_LOG_TRIVIAL(debug) << "SPP converged after RAIM";
+
+        return true;
+    }
+
+    // Restore original satStats if fails
+    backupSatStats(origSatStats, false);
+
+    tracepdeex(3, trace, "\n%s\tRAIM failed after %d iterations", tsync.to_string().c_str(), iter);
+    BOOST_LOG_TRIVIAL(debug) << "RAIM failed after " << iter << " iterations";
+
+    return false;
+}
+
 /** Compute receiver position, clock biases by single-point positioning with pseudorange
  * measurements
  */
@@ -1220,6 +1692,7 @@ void spp(
         return;
     }
 
+    vector<GObs*> satPosObsList;
     for (auto& obs : only<GObs>(obsList))
     {
         if (acsConfig.process_sys[obs.Sat.sys] == false)
@@ -1232,22 +1705,12 @@ void spp(
                 true)  // KALMAN or REMOTE is not available, or SSR is not updated when
                        // preprocessing all data
         {
-            auto& satOpts = acsConfig.getSatOpts(obs.Sat);
-
-            satPosClk(
-                trace,
-                obs.time,
-                obs,
-                nav,
-                satOpts.posModel.sources,
-                satOpts.clockModel.sources,
-                kfState_ptr,
-                remote_ptr,
-                E_OffsetType::APC
-            );
+            satPosObsList.push_back(&obs);
         }
     }
 
+    satPosClks(trace, satPosObsList, nav, kfState_ptr, remote_ptr, E_OffsetType::APC);
+
     tracepdeex(
         3,
         trace,
@@ -1258,8 +1721,17 @@ void spp(
     );
 
     // Estimate receiver position with pseudorange
-    sol.status = estpos(trace, obsList, sol, id, kfState_ptr, (string) "SPP/" + id);  // todo aaron,
-                                                                                      // remote too?
+    KFMeas sppMeas;
+    sol.status = estpos(
+        trace,
+        obsList,
+        sol,
+        id,
+        kfState_ptr,
+        (string) "SPP/" + id,
+        false,
+        &sppMeas
+    );  // todo aaron, remote too?
 
     auto& sppState = sol.sppState;
 
@@ -1269,9 +1741,15 @@ void spp(
         if (acsConfig.sppOpts.raim.enable &&
             sol.status != E_Solution::NONE)  // Meaningless to perform RAIM for NONE solution
         {
-            int numMeas = 0;
+            int  numMeas         = 0;
+            bool outliersCleared = false;
             for (auto& obs : only<GObs>(obsList))
             {
+                if (obs.excludeOutlier)
+                {
+                    outliersCleared = true;
+                }
+
                 obs.excludeOutlier =
                     false;  // Clear outlier flags from SPP and let RAIM do the exclusion
 
@@ -1286,7 +1764,10 @@ void spp(
             sppState.dof        = numMeas - (sppState.x.rows() - 1);
             sppState.chi2PerDof = INFINITY;
 
-            bool pass = raim(trace, obsList, sol, id, kfState_ptr);
+            // the spp measurements only cover the whole set if no outliers were excluded from them
+            KFMeas* sppMeas_ptr = outliersCleared ? nullptr : &sppMeas;
+
+            bool pass = raim(trace, obsList, sol, id, kfState_ptr, sppMeas_ptr);
 
             if (pass && traceLevel >= 4)
             {
@@ -40,6 +40,7 @@ struct GptGrid
 
 vector<GptGrid> globalGPT2Grids      = {};     ///< gpt grid information
 bool            globalGPT2GridsReady = false;  ///< gpt grid information read
+int             globalGPT2Generation = 0;      ///< Incremented when the grids are (re)loaded
 
 /* sign function ---------------------------------------------------------------
  * args     :       double x                I       input number
@@ -169,6 +170,7 @@ void readgrid(string filepath)  ///< vmf1 coefficients filename
     }
 
     globalGPT2GridsReady = true;
+    globalGPT2Generation++;
 }
 
 /** coefficients multiplication
@@ -178,35 +180,24 @@ double coef(const array<double, 5>& a, double cosfy, double sinfy, double coshy,
     return +a[0] + a[1] * cosfy + a[2] * sinfy + a[3] * coshy + a[4] * sinhy;
 }
 
-double coefr(double p1, double p2, double l1, double l2, double a[4])
+/** Grid points and weights used by gpt2 at a location, these depend only on the location
+ */
+struct Gpt2SiteWeights
 {
-    double r[2];
-
-    r[0] = p2 * a[0] + p1 * a[1];
-    r[1] = p2 * a[2] + p1 * a[3];
-
-    return +l2 * r[0] + l1 * r[1];
-}
+    int    count     = 0;   ///< Number of grid points used, 1 near the poles, 4 otherwise
+    int    index[4]  = {};  ///< Indices of the grid points
+    double weight[4] = {};  ///< Interpolation weights of the grid points
+};
 
-/** global pressure and temperature
+/** Find the grid points and weights for a location,
+ * nearest neighbour interpolation near the poles, bilinear otherwise
  */
-GPTVals gpt2(
-    const vector<GptGrid>& gptg,  ///< gpt grid information
-    double                 mjd,   ///< modified julian date
-    double                 lat,   ///< ellipsoidal lat (rad)
-    double                 lon,   ///< ellipsoidal lon (rad)
-    double                 hell   ///< ellipsoidal height (m)
+void gpt2SiteWeights(
+    double           lat,   ///< ellipsoidal lat (rad)
+    double           lon,   ///< ellipsoidal lon (rad)
+    Gpt2SiteWeights& site   ///< output grid points and weights
 )
 {
-    /* change reference epoch to 1/1/2000 */
-    double mjd1 = mjd - MJD_j2000;
-
-    /* factors for amplitudes */
-    double cosfy = cos(mjd1 / 365.25 * 2 * PI);
-    double coshy = cos(mjd1 / 365.25 * 4 * PI);
-    double sinfy = sin(mjd1 / 365.25 * 2 * PI);
-    double sinhy = sin(mjd1 / 365.25 * 4 * PI);
-
     /* positive longitude in degrees */
     double plon;
     if (lon < 0)
@@ -228,114 +219,105 @@ GPTVals gpt2(
     if (ipod == 37)
         ipod = 36;
 
-    int index[4] = {};
-    index[0]     = (ipod - 1) * 72 + ilon;
+    int index0 = (ipod - 1) * 72 + ilon;
 
     /* near the pole: nearest neighbour interpolation, otherwise, bilinear */
-    int bl = 0;
-    if (pdist > 2.5 && pdist < 177.5)
+    if (pdist <= 2.5 || pdist >= 177.5)
     {
-        bl = 1;
+        site.count     = 1;
+        site.index[0]  = index0 - 1;
+        site.weight[0] = 1;
+        return;
     }
 
-    GPTVals gptVals;
-
-    if (bl == 0)
-    {
-        /* near the pole */
-        int i = index[0] - 1;
-
-        auto& gptGridPoint = gptg[i];
-
-        gptVals.undulation = gptGridPoint.undu;
+    double ipod1 = ipod + sign(dpod);
+    double ilon1 = ilon + sign(dlon);
+
+    if (ilon1 == 73)
+        ilon1 = 1;
+    if (ilon1 == 0)
+        ilon1 = 72;
+
+    double dnpod1 = fabs(dpod);
+    double dnpod2 = 1 - dnpod1;
+    double dnlon1 = fabs(dlon);
+    double dnlon2 = 1 - dnlon1;
+
+    site.count    = 4;
+    site.index[0] = index0 - 1; /* starting from 0 */
+    site.index[1] = (ipod1 - 1) * 72 + ilon - 1;
+    site.index[2] = (ipod - 1) * 72 + ilon1 - 1;
+    site.index[3] = (ipod1 - 1) * 72 + ilon1 - 1;
+
+    site.weight[0] = dnlon2 * dnpod2;
+    site.weight[1] = dnlon2 * dnpod1;
+    site.weight[2] = dnlon1 * dnpod2;
+    site.weight[3] = dnlon1 * dnpod1;
+}
 
-        double hgt = hell - gptVals.undulation;
+/** global pressure and temperature
+ */
+GPTVals gpt2(
+    const vector<GptGrid>& gptg,  ///< gpt grid information
+    double                 mjd,   ///< modified julian date
+    double                 lat,   ///< ellipsoidal lat (rad)
+    double                 lon,   ///< ellipsoidal lon (rad)
+    double                 hell   ///< ellipsoidal height (m)
+)
+{
+    thread_local TropSiteCache<Gpt2SiteWeights> gpt2SiteCache;
 
-        /* pressure, temperature at the height of grid */
-        double t0  = coef(gptGridPoint.temp, cosfy, sinfy, coshy, sinhy);
-        double p0  = coef(gptGridPoint.pres, cosfy, sinfy, coshy, sinhy);
-        double q0  = coef(gptGridPoint.humid, cosfy, sinfy, coshy, sinhy);
-        double dt0 = coef(gptGridPoint.tlaps, cosfy, sinfy, coshy, sinhy);
+    auto& site = gpt2SiteCache.get(
+        lat,
+        lon,
+        globalGPT2Generation,
+        [&](Gpt2SiteWeights& siteWeights) { gpt2SiteWeights(lat, lon, siteWeights); }
+    );
 
-        double con = GRAVITY * MOLARDRY / (UGAS * t0 * (1 + 0.6077 * q0));
+    /* change reference epoch to 1/1/2000 */
+    double mjd1 = mjd - MJD_j2000;
 
-        /* pressure in hPa */
-        gptVals.pressure = (p0 * exp(-con * (hgt - gptGridPoint.hgt))) / 100;
+    /* factors for amplitudes */
+    double cosfy = cos(mjd1 / 365.25 * 2 * PI);
+    double coshy = cos(mjd1 / 365.25 * 4 * PI);
+    double sinfy = sin(mjd1 / 365.25 * 2 * PI);
+    double sinhy = sin(mjd1 / 365.25 * 4 * PI);
 
-        /* temperature at station height in celsius */
-        gptVals.temperature = t0 + dt0 * (hgt - gptGridPoint.hgt) - ZEROC;
-        gptVals.deltaT      = dt0 * 1000;
+    double q = 0;
 
-        /* water vapour pressure in hPa */
-        gptVals.waterVp = (q0 * gptVals.pressure) / (0.622 + 0.378 * q0);
+    GPTVals gptVals;
 
-        /* dry and wet coefficients */
-        gptVals.hydroCoef = coef(gptGridPoint.ah, cosfy, sinfy, coshy, sinhy);
-        gptVals.wetCoef   = coef(gptGridPoint.aw, cosfy, sinfy, coshy, sinhy);
-    }
-    else
+    for (int k = 0; k < site.count; k++)
     {
-        double t[4];
-        double p[4];
-        double q[4];
-        double dt[4];
-        double ah[4];
-        double aw[4];
-        double undu[4];
-
-        double ipod1 = ipod + sign(dpod);
-        double ilon1 = ilon + sign(dlon);
-
-        if (ilon1 == 73)
-            ilon1 = 1;
-        if (ilon1 == 0)
-            ilon1 = 72;
-
-        index[0] = index[0] - 1; /* starting from 0 */
-        index[1] = (ipod1 - 1) * 72 + ilon - 1;
-        index[2] = (ipod - 1) * 72 + ilon1 - 1;
-        index[3] = (ipod1 - 1) * 72 + ilon1 - 1;
-
-        for (int k = 0; k < 4; k++)
-        {
-            auto& gptGridPointK = gptg[index[k]];
+        auto&  gptGridPointK = gptg[site.index[k]];
+        double weight        = site.weight[k];
 
-            undu[k] = gptGridPointK.undu;
+        double hgt = hell - gptGridPointK.undu;
 
-            double hgt = hell - undu[k];
+        /* pressure, temperature at the height of the grid */
+        double t0 = coef(gptGridPointK.temp, cosfy, sinfy, coshy, sinhy);
+        double p0 = coef(gptGridPointK.pres, cosfy, sinfy, coshy, sinhy);
+        double qk = coef(gptGridPointK.humid, cosfy, sinfy, coshy, sinhy);
+        double dt = coef(gptGridPointK.tlaps, cosfy, sinfy, coshy, sinhy);
 
-            /* pressure, temperature at the height of the grid */
-            double t0 = coef(gptGridPointK.temp, cosfy, sinfy, coshy, sinhy);
-            double p0 = coef(gptGridPointK.pres, cosfy, sinfy, coshy, sinhy);
-            q[k]      = coef(gptGridPointK.humid, cosfy, sinfy, coshy, sinhy);
-            dt[k]     = coef(gptGridPointK.tlaps, cosfy, sinfy, coshy, sinhy);
+        double t   = t0 + dt * (hgt - gptGridPointK.hgt) - ZEROC;
+        double con = GRAVITY * MOLARDRY / (UGAS * t0 * (1 + 0.6077 * qk));
 
-            t[k]       = t0 + dt[k] * (hgt - gptGridPointK.hgt) - ZEROC;
-            double con = GRAVITY * MOLARDRY / (UGAS * t0 * (1 + 0.6077 * q[k]));
+        double p = (p0 * exp(-con * (hgt - gptGridPointK.hgt))) / 100;
 
-            p[k] = (p0 * exp(-con * (hgt - gptGridPointK.hgt))) / 100;
+        gptVals.pressure += p * weight;
+        gptVals.temperature += t * weight;
+        gptVals.deltaT += dt * 1000 * weight;
+        q += qk * weight;
 
-            ah[k] = coef(gptGridPointK.ah, cosfy, sinfy, coshy, sinhy);
-            aw[k] = coef(gptGridPointK.aw, cosfy, sinfy, coshy, sinhy);
-        }
-        double dnpod1 = fabs(dpod);
-        double dnpod2 = 1 - dnpod1;
-        double dnlon1 = fabs(dlon);
-        double dnlon2 = 1 - dnlon1;
-
-        gptVals.pressure    = coefr(dnpod1, dnpod2, dnlon1, dnlon2, p);
-        gptVals.temperature = coefr(dnpod1, dnpod2, dnlon1, dnlon2, t);
-        gptVals.deltaT      = coefr(dnpod1, dnpod2, dnlon1, dnlon2, dt) * 1000;
-
-        /* humidity */
-        double tp       = coefr(dnpod1, dnpod2, dnlon1, dnlon2, q);
-        gptVals.waterVp = tp * gptVals.pressure / (0.622 + 0.378 * tp);
-
-        gptVals.hydroCoef  = coefr(dnpod1, dnpod2, dnlon1, dnlon2, ah);
-        gptVals.wetCoef    = coefr(dnpod1, dnpod2, dnlon1, dnlon2, aw);
-        gptVals.undulation = coefr(dnpod1, dnpod2, dnlon1, dnlon2, undu);
+        gptVals.hydroCoef += coef(gptGridPointK.ah, cosfy, sinfy, coshy, sinhy) * weight;
+        gptVals.wetCoef += coef(gptGridPointK.aw, cosfy, sinfy, coshy, sinhy) * weight;
+        gptVals.undulation += gptGridPointK.undu * weight;
     }
 
+    /* humidity */
+    gptVals.waterVp = q * gptVals.pressure / (0.622 + 0.378 * q);
+
     return gptVals;
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+#include <map>
 #include <string>
 #include "common/common.hpp"
 #include "common/constants.hpp"
@@ -8,11 +10,60 @@
 #include "common/gTime.hpp"
 #include "common/navigation.hpp"
 
+using std::map;
 using std::string;
 
 constexpr double ERR_TROP = 3.0;   ///< tropspheric delay std (m)
 constexpr int    NGPT     = 2592;  ///< grid number
 
+constexpr double TROP_SITE_RESOLUTION = 1e-8;  ///< Position change that invalidates cached site values (rad)
+constexpr int    TROP_SITE_MAX        = 1000;  ///< Number of cached sites before the cache is reset
+
+/** Per thread cache of troposphere model values that depend only on a receiver's position.
+ * Receivers are static, so grid indices and spatial weights are computed on first use and reused
+ * for every subsequent observation. Entries are dropped whenever the source grids are reloaded.
+ */
+template <typename SITEVALS>
+struct TropSiteCache
+{
+    map<std::pair<long, long>, SITEVALS> siteMap;
+    int                                  generation = -1;  ///< Generation of the grids used for entries
+
+    /** Get the values for a position, using the generator to create them if not already cached
+     */
+    template <typename GENERATOR>
+    const SITEVALS& get(
+        double    lat,             ///< Latitude of the receiver (rad)
+        double    lon,             ///< Longitude of the receiver (rad)
+        int       gridGeneration,  ///< Generation of the source grids, incremented when reloaded
+        GENERATOR generator        ///< Function of the form void(SITEVALS&) computing the values
+    )
+    {
+        if (gridGeneration != generation || siteMap.size() > TROP_SITE_MAX)
+        {
+            siteMap.clear();
+            generation = gridGeneration;
+        }
+
+        auto key = std::make_pair(
+            std::lround(lat / TROP_SITE_RESOLUTION),
+            std::lround(lon / TROP_SITE_RESOLUTION)
+        );
+
+        auto it = siteMap.find(key);
+        if (it != siteMap.end())
+        {
+            auto& [dummy, siteVals] = *it;
+            return siteVals;
+        }
+
+        auto& siteVals = siteMap[key];
+        generator(siteVals);
+
+        return siteVals;
+    }
+};
+
 struct TropMapping
 {
     double dryMap   = 0;
@@ -1,5 +1,6 @@
 // #pragma GCC optimize ("O0")
 
+#include <algorithm>
 #include <fstream>
 #include "trop/tropModels.hpp"
 
@@ -49,13 +50,18 @@ struct Vmf3GridPoint
     }
 };
 
-struct Vmf3 : map<GTime, map<double, map<double, Vmf3GridPoint>>> /* VMF gridmap [time][lat][lon]
-                                                                     plus orography vector */
+/** vmf3 grids, stored densely per epoch as [latIndex * lons.size() + lonIndex]
+ */
+struct Vmf3 : map<GTime, vector<Vmf3GridPoint>>
 {
+    vector<double> lats;  ///< Ascending latitudes of the grid rows (degree)
+    vector<double> lons;  ///< Ascending longitudes of the grid columns (degree)
+
     vector<double> orography;
 
     int gridLength      = 0;
     int orographyLength = 0;
+    int generation      = 0;  ///< Incremented when the grid layout or orography changes
 };
 
 Vmf3 globalVMF3;  ///< vmf3 grid info
@@ -3516,6 +3522,7 @@ const double bnm_cw[91][5] = {
 void readorog(string filepath)  ///< filename
 {
     globalVMF3.orography.clear();
+    globalVMF3.generation++;
 
     ifstream filestream(filepath);
     if (!filestream)
@@ -3549,6 +3556,67 @@ void readorog(string filepath)  ///< filename
     }
 }
 
+/** Store the grid points of an epoch in the dense layout of the global vmf3 grids
+ */
+void storeVmf3Epoch(
+    string                                         filepath,     ///< vmf3 grid file path, for logging
+    GTime                                          time,         ///< Epoch of the grid
+    const map<double, map<double, Vmf3GridPoint>>& gridPointMap  ///< Grid points as [lat][lon]
+)
+{
+    vector<double> lats;
+    vector<double> lons;
+    for (auto& [lat, latMap] : gridPointMap)
+    {
+        lats.push_back(lat);
+    }
+    if (gridPointMap.empty() == false)
+    {
+        auto& [lat, latMap] = *gridPointMap.begin();
+        for (auto& [lon, gridPoint] : latMap)
+        {
+            lons.push_back(lon);
+        }
+    }
+
+    if (globalVMF3.empty())
+    {
+        globalVMF3.lats = lats;
+        globalVMF3.lons = lons;
+        globalVMF3.generation++;
+    }
+    else if (lats != globalVMF3.lats || lons != globalVMF3.lons)
+    {
+        BOOST_LOG_TRIVIAL(error) << "VMF3 grid layout in '" << filepath
+                                 << "' does not match previous files, ignoring epoch " << time;
+        return;
+    }
+
+    auto& points = globalVMF3[time];
+    points.clear();
+    points.resize(lats.size() * lons.size());
+
+    int latIndex = 0;
+    for (auto& [lat, latMap] : gridPointMap)
+    {
+        if (latMap.size() != lons.size())
+        {
+            BOOST_LOG_TRIVIAL(error) << "VMF3 grid in '" << filepath << "' is not regular at lat "
+                                     << lat;
+            globalVMF3.erase(time);
+            return;
+        }
+
+        int lonIndex = 0;
+        for (auto& [lon, gridPoint] : latMap)
+        {
+            points[latIndex * lons.size() + lonIndex] = gridPoint;
+            lonIndex++;
+        }
+        latIndex++;
+    }
+}
+
 /** read vmf3 grid
  */
 void readvmf3(string filepath)  ///< vmf3 grid file path
@@ -3569,6 +3637,8 @@ void readvmf3(string filepath)  ///< vmf3 grid file path
     int   index = 0;
     GTime time  = GTime::noTime();
 
+    map<GTime, map<double, map<double, Vmf3GridPoint>>> fileGridMap;
+
     while (filestream)
     {
         string line;
@@ -3622,10 +3692,15 @@ void readvmf3(string filepath)  ///< vmf3 grid file path
 
         if (found == 6)
         {
-            globalVMF3[time][gridPoint.lat][gridPoint.lon] = gridPoint;
+            fileGridMap[time][gridPoint.lat][gridPoint.lon] = gridPoint;
         }
     }
 
+    for (auto& [gridTime, gridPointMap] : fileGridMap)
+    {
+        storeVmf3Epoch(filepath, gridTime, gridPointMap);
+    }
+
     globalVMF3.gridLength = index;
 
     if (globalVMF3.orographyLength != 0 && globalVMF3.orographyLength != globalVMF3.gridLength)
@@ -3634,30 +3709,33 @@ void readvmf3(string filepath)  ///< vmf3 grid file path
     }
 }
 
-/** legendre polynomials
+/** Spherical harmonic coefficients of the vmf3 b and c mapping function parameters at a location,
+ * as constant, annual and semi-annual terms
+ */
+struct Vmf3Coefficients
+{
+    double bhc[5] = {};
+    double bwc[5] = {};
+    double chc[5] = {};
+    double cwc[5] = {};
+};
+
+/** legendre polynomials, summed to get the location dependent vmf3 coefficients
  */
 void legenpoly(
-    Vmf3GridPoint& vmf3GP,  ///< vmf3 info
-    const double   doy,     ///< day of year
-    const double   el,      ///< elevation (rad)
-    const double   hgt      ///< height (m)
+    double            latd,    ///< latitude (degree)
+    double            lond,    ///< longitude (degree)
+    Vmf3Coefficients& coeffs   ///< output coefficients
 )
 {
     int    nmax         = 12;
-    double bhc[5]       = {};
-    double bwc[5]       = {};
-    double chc[5]       = {};
-    double cwc[5]       = {};
-    double a1           = 2.53e-5;
-    double b1           = 5.49e-3;
-    double c1           = 1.14e-3;
     double vmat[13][13] = {{}};
     double wmat[13][13] = {{}};
 
     /* unit vector */
-    double x = sin(PI / 2 - vmf3GP.lat * D2R) * cos(vmf3GP.lon * D2R);
-    double y = sin(PI / 2 - vmf3GP.lat * D2R) * sin(vmf3GP.lon * D2R);
-    double z = cos(PI / 2 - vmf3GP.lat * D2R);
+    double x = sin(PI / 2 - latd * D2R) * cos(lond * D2R);
+    double y = sin(PI / 2 - latd * D2R) * sin(lond * D2R);
+    double z = cos(PI / 2 - latd * D2R);
 
     vmat[0][0] = 1;
     wmat[0][0] = 0;
@@ -3697,35 +3775,50 @@ void legenpoly(
     /* b) determine coefficients bh, bw, ch, cw */
     int p = 0;
 
-    for (int j = 0; j < 5; j++)
-        bhc[j] = bwc[j] = chc[j] = cwc[j] = 0;
+    coeffs = Vmf3Coefficients();
 
     for (int j = 0; j <= nmax; j++)
         for (int k = 0; k <= j; k++)
         {
             for (int q = 0; q < 5; q++)
             {
-                bhc[q] += anm_bh[p][q] * vmat[j][k] + bnm_bh[p][q] * wmat[j][k];
-                bwc[q] += anm_bw[p][q] * vmat[j][k] + bnm_bw[p][q] * wmat[j][k];
-                chc[q] += anm_ch[p][q] * vmat[j][k] + bnm_ch[p][q] * wmat[j][k];
-                cwc[q] += anm_cw[p][q] * vmat[j][k] + bnm_cw[p][q] * wmat[j][k];
+                coeffs.bhc[q] += anm_bh[p][q] * vmat[j][k] + bnm_bh[p][q] * wmat[j][k];
+                coeffs.bwc[q] += anm_bw[p][q] * vmat[j][k] + bnm_bw[p][q] * wmat[j][k];
+                coeffs.chc[q] += anm_ch[p][q] * vmat[j][k] + bnm_ch[p][q] * wmat[j][k];
+                coeffs.cwc[q] += anm_cw[p][q] * vmat[j][k] + bnm_cw[p][q] * wmat[j][k];
             }
 
             p++;
         }
+}
 
-    /* adding seasonal amplitudes */
-    double bh = bhc[0] + bhc[1] * cos(doy / 365.25 * 2 * PI) + bhc[2] * sin(doy / 365.25 * 2 * PI) +
-                bhc[3] * cos(doy / 365.25 * 4 * PI) + bhc[4] * sin(doy / 365.25 * 4 * PI);
+/** vmf3 mapping functions from the location dependent coefficients
+ */
+void vmf3Map(
+    Vmf3GridPoint&          vmf3GP,  ///< vmf3 info
+    const Vmf3Coefficients& coeffs,  ///< location dependent coefficients from legenpoly()
+    const double            doy,     ///< day of year
+    const double            el,      ///< elevation (rad)
+    const double            hgt      ///< height (m)
+)
+{
+    double a1 = 2.53e-5;
+    double b1 = 5.49e-3;
+    double c1 = 1.14e-3;
 
-    double bw = bwc[0] + bwc[1] * cos(doy / 365.25 * 2 * PI) + bwc[2] * sin(doy / 365.25 * 2 * PI) +
-                bwc[3] * cos(doy / 365.25 * 4 * PI) + bwc[4] * sin(doy / 365.25 * 4 * PI);
+    /* adding seasonal amplitudes */
+    double cos1 = cos(doy / 365.25 * 2 * PI);
+    double sin1 = sin(doy / 365.25 * 2 * PI);
+    double cos2 = cos(doy / 365.25 * 4 * PI);
+    double sin2 = sin(doy / 365.25 * 4 * PI);
 
-    double ch = chc[0] + chc[1] * cos(doy / 365.25 * 2 * PI) + chc[2] * sin(doy / 365.25 * 2 * PI) +
-                chc[3] * cos(doy / 365.25 * 4 * PI) + chc[4] * sin(doy / 365.25 * 4 * PI);
+    auto seasonal = [&](const double c[5])
+    { return c[0] + c[1] * cos1 + c[2] * sin1 + c[3] * cos2 + c[4] * sin2; };
 
-    double cw = cwc[0] + cwc[1] * cos(doy / 365.25 * 2 * PI) + cwc[2] * sin(doy / 365.25 * 2 * PI) +
-                cwc[3] * cos(doy / 365.25 * 4 * PI) + cwc[4] * sin(doy / 365.25 * 4 * PI);
+    double bh = seasonal(coeffs.bhc);
+    double bw = seasonal(coeffs.bwc);
+    double ch = seasonal(coeffs.chc);
+    double cw = seasonal(coeffs.cwc);
 
     /* using a from the grid and calculate hydro and wet mapping factor */
     double ah = vmf3GP.ah;
@@ -3750,44 +3843,97 @@ void legenpoly(
     vmf3GP.mfh += h1 * hgt / 1000;
 }
 
-template <typename INTER, typename VALTYPE>
-vector<const VALTYPE*>
-getStraddle(const map<INTER, VALTYPE>& straddleMap, INTER inter, vector<double>& fractions)
+/** Linear interpolation weights between the two nodes of an ascending axis straddling a value,
+ * clamped to the end nodes outside the axis
+ */
+void getStraddle(
+    const vector<double>& axis,        ///< Ascending axis nodes
+    double                inter,       ///< Value to interpolate to
+    int                   index[2],    ///< Output node indices
+    double                fraction[2]  ///< Output node weights
+)
 {
-    vector<const VALTYPE*> outputs;
-
-    auto it = straddleMap.lower_bound(inter);
-    if (it == straddleMap.end())
+    auto it = std::lower_bound(axis.begin(), axis.end(), inter);
+    if (it == axis.end())
     {
-        auto lastIt = straddleMap.rbegin();
-
-        auto& [dummy, last] = *lastIt;
-        outputs.push_back(&last);
-        fractions.push_back(1);
-        outputs.push_back(&last);
-        fractions.push_back(0);
+        index[0]    = axis.size() - 1;
+        index[1]    = axis.size() - 1;
+        fraction[0] = 1;
+        fraction[1] = 0;
     }
-    else if (it == straddleMap.begin())
+    else if (it == axis.begin())
     {
-        auto& [dummy, first] = *it;
-        outputs.push_back(&first);
-        fractions.push_back(0);
-        outputs.push_back(&first);
-        fractions.push_back(1);
+        index[0]    = 0;
+        index[1]    = 0;
+        fraction[0] = 0;
+        fraction[1] = 1;
     }
     else
     {
-        auto& [inter2, out2] = *it;
-        it--;
-        auto& [inter1, out1] = *it;
-
-        outputs.push_back(&out2);
-        fractions.push_back((inter - inter1) / (inter2 - inter1));
-        outputs.push_back(&out1);
-        fractions.push_back((inter - inter1) / (inter1 - inter2) + 1);
+        int    i2     = it - axis.begin();
+        int    i1     = i2 - 1;
+        double inter1 = axis[i1];
+        double inter2 = axis[i2];
+
+        index[0]    = i2;
+        fraction[0] = (inter - inter1) / (inter2 - inter1);
+        index[1]    = i1;
+        fraction[1] = (inter - inter1) / (inter1 - inter2) + 1;
     }
+}
+
+/** Values of the vmf3 model that depend only on the receiver location
+ */
+struct Vmf3SiteWeights
+{
+    int              index[4]  = {};  ///< Dense indices of the surrounding grid points
+    double           weight[4] = {};  ///< Bilinear weights of the surrounding grid points
+    double           orog      = 0;   ///< Interpolated orography (m)
+    Vmf3Coefficients coeffs;          ///< Mapping function coefficients at the interpolated location
+};
+
+/** Compute the spatial interpolation weights and mapping coefficients for a location
+ */
+void vmf3SiteWeights(
+    double           latd,   ///< latitude (degree)
+    double           lond,   ///< longitude (degree, positive)
+    Vmf3SiteWeights& site    ///< output values
+)
+{
+    auto& [time0, points] = *globalVMF3.begin();
+
+    int    latIndex[2];
+    int    lonIndex[2];
+    double latFraction[2];
+    double lonFraction[2];
+    getStraddle(globalVMF3.lats, latd, latIndex, latFraction);
+    getStraddle(globalVMF3.lons, lond, lonIndex, lonFraction);
+
+    double lat = 0;
+    double lon = 0;
+    site.orog  = 0;
+
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+        {
+            int n = i * 2 + j;
+
+            site.index[n]  = latIndex[i] * globalVMF3.lons.size() + lonIndex[j];
+            site.weight[n] = latFraction[i] * lonFraction[j];
+
+            auto& gridPoint = points[site.index[n]];
 
-    return outputs;
+            lat += gridPoint.lat * site.weight[n];
+            lon += gridPoint.lon * site.weight[n];
+
+            int orogIndex = gridPoint.index;
+            if (orogIndex < globalVMF3.orographyLength)
+            {
+                site.orog += globalVMF3.orography[orogIndex] * site.weight[n];
+            }
+        }
+
+    legenpoly(lat, lon, site.coeffs);
 }
 
 /** vmf3
@@ -3823,39 +3969,63 @@ double tropVMF3(
         el = 1e-6;
     }
 
-    vector<double> fractionsa;
-    auto           a = getStraddle(globalVMF3, time, fractionsa);
+    thread_local TropSiteCache<Vmf3SiteWeights> vmf3SiteCache;
 
-    Vmf3GridPoint timePoint;
-    for (int i = 0; i < 2; i++)
+    auto& site = vmf3SiteCache.get(
+        pos.lat(),
+        pos.lon(),
+        globalVMF3.generation,
+        [&](Vmf3SiteWeights& siteWeights) { vmf3SiteWeights(latd, lond, siteWeights); }
+    );
+
+    // two point blend between the grids straddling the time
+    const vector<Vmf3GridPoint>* grids[2];
+    double                       fractions[2];
+
+    auto it = globalVMF3.lower_bound(time);
+    if (it == globalVMF3.end())
+    {
+        auto& [dummy, last] = *globalVMF3.rbegin();
+        grids[0]            = &last;
+        fractions[0]        = 1;
+        grids[1]            = &last;
+        fractions[1]        = 0;
+    }
+    else if (it == globalVMF3.begin())
+    {
+        auto& [dummy, first] = *it;
+        grids[0]             = &first;
+        fractions[0]         = 0;
+        grids[1]             = &first;
+        fractions[1]         = 1;
+    }
+    else
     {
-        vector<double> fractionsb;
-        auto&          A = *a[i];
-        auto           b = getStraddle(A, latd, fractionsb);
+        auto& [time2, grid2] = *it;
+        it--;
+        auto& [time1, grid1] = *it;
 
-        Vmf3GridPoint latPoint;
-        for (int i = 0; i < 2; i++)
-        {
-            vector<double> fractionsc;
-            auto&          B = *b[i];
-            auto           c = getStraddle(B, lond, fractionsc);
+        grids[0]     = &grid2;
+        fractions[0] = (time - time1).to_double() / (time2 - time1).to_double();
+        grids[1]     = &grid1;
+        fractions[1] = 1 - fractions[0];
+    }
 
-            Vmf3GridPoint lonPoint;
-            for (int i = 0; i < 2; i++)
-            {
-                Vmf3GridPoint vmf3GP = *c[i];
-                {
-                    vmf3GP.orog = globalVMF3.orography[vmf3GP.index];
-                }
+    Vmf3GridPoint vmf3GP;
+    for (int t = 0; t < 2; t++)
+        for (int n = 0; n < 4; n++)
+        {
+            auto&  gridPoint = (*grids[t])[site.index[n]];
+            double weight    = fractions[t] * site.weight[n];
 
-                lonPoint += vmf3GP * fractionsc[i];
-            }
-            latPoint += lonPoint * fractionsb[i];
+            vmf3GP.ah += gridPoint.ah * weight;
+            vmf3GP.aw += gridPoint.aw * weight;
+            vmf3GP.zhd += gridPoint.zhd * weight;
+            vmf3GP.zwd += gridPoint.zwd * weight;
         }
-        timePoint += latPoint * fractionsa[i];
-    }
 
-    Vmf3GridPoint& vmf3GP = timePoint;
+    vmf3GP.orog = site.orog;
+
     {
         /* (a) zhd */
 
@@ -3879,8 +4049,8 @@ double tropVMF3(
 
         double doy = yds.doy + yds.sod / S_IN_DAY;
 
-        /* legendre polynomials */
-        legenpoly(vmf3GP, doy, el, hgt);
+        /* mapping functions */
+        vmf3Map(vmf3GP, site.coeffs, doy, el, hgt);
     }
 
     dryZTD = vmf3GP.zhd;